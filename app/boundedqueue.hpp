@@ -0,0 +1,85 @@
+/// @file boundedqueue.hpp
+/// @brief Blocking FIFO of bounded capacity linking two pipeline stages
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#ifndef BOUNDEDQUEUE_H
+#define BOUNDEDQUEUE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+/// @brief Multi-producer multi-consumer queue holding at most @p capacity
+///        items. A producer blocks while the queue is full, which throttles a
+///        fast stage to the pace of the slowest one (backpressure).
+template <typename T>
+class BoundedQueue final
+{
+public:
+  /// @param capacity Maximum number of queued items, at least 1.
+  explicit BoundedQueue(std::size_t capacity)
+    : m_capacity(capacity > 0U ? capacity : 1U)
+  {
+  }
+  // Non copyable, producers and consumers share a single instance.
+  BoundedQueue(const BoundedQueue&) = delete;
+  // Non copyable.
+  BoundedQueue& operator=(const BoundedQueue&) = delete;
+  // Default destructor.
+  ~BoundedQueue() = default;
+
+  /// @brief Appends @p item, waiting for a free slot.
+  /// @return False if the queue was closed, the item is then dropped.
+  bool push(T item)
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_notFull.wait(lock, [this] { return m_closed || m_items.size() < m_capacity; });
+    if (m_closed) {
+      return false;
+    }
+    m_items.push_back(std::move(item));
+    m_notEmpty.notify_one();
+    return true;
+  }
+
+  /// @brief Removes the oldest item, waiting for one to be available.
+  /// @return False once the queue is closed and drained.
+  bool pop(T& item)
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_notEmpty.wait(lock, [this] { return m_closed || !m_items.empty(); });
+    if (m_items.empty()) {
+      return false;
+    }
+    item = std::move(m_items.front());
+    m_items.pop_front();
+    m_notFull.notify_one();
+    return true;
+  }
+
+  /// @brief No more items will be pushed. Waiting consumers drain what is
+  ///        left, waiting producers return false.
+  void close()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_closed = true;
+    m_notEmpty.notify_all();
+    m_notFull.notify_all();
+  }
+
+private:
+  const std::size_t m_capacity;
+  std::deque<T> m_items;
+  bool m_closed{false};
+  std::mutex m_mutex;
+  std::condition_variable m_notEmpty;
+  std::condition_variable m_notFull;
+};
+
+#endif //BOUNDEDQUEUE_H
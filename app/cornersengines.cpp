@@ -0,0 +1,27 @@
+/// @file cornersengines.cpp
+/// @brief source file for cornersengines
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#include "cornersengines.hpp"
+#include "harrisengine.hpp"
+#include "saddledetector.hpp"
+
+std::unique_ptr<ChessCornersEngine> makeCornersEngine(
+    const std::string& name,
+    const HarrisParameters& harrisParams,
+    const SaddleParameters& saddleParams,
+    const bool tracking
+    )
+{
+    if (name == "harris") {
+        return std::unique_ptr<ChessCornersEngine>(new HarrisCornersEngine(harrisParams, tracking));
+    }
+    if (name == "saddle") {
+        return std::unique_ptr<ChessCornersEngine>(new SaddleChessCornersDetector(saddleParams));
+    }
+    return nullptr;
+}
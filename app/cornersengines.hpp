@@ -0,0 +1,37 @@
+/// @file cornersengines.hpp
+/// @brief Run-time selection of the corner detection engine
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#ifndef CORNERSENGINES_H
+#define CORNERSENGINES_H
+
+#include <memory>
+#include <string>
+#include "cornersengine.hpp"
+#include "harristypes.hpp"
+#include "saddletypes.hpp"
+
+/// @brief Names accepted by makeCornersEngine(), for the usage message.
+constexpr const char* kCornersEngineNames = "harris|saddle";
+
+/// @brief Creates the engine called @p name.
+/// @param name         "harris" (HarrisCornersEngine) or "saddle"
+///                     (SaddleChessCornersDetector).
+/// @param harrisParams Parameters of the Harris engine.
+/// @param saddleParams Parameters of the saddle engine.
+/// @param tracking     Tracks the corners between the keyframes of a video,
+///                     see HarrisChessCornersDetector::track(). Only the
+///                     Harris engine tracks, the others ignore it.
+/// @return The engine, nullptr if the name is unknown.
+std::unique_ptr<ChessCornersEngine> makeCornersEngine(
+    const std::string& name,
+    const HarrisParameters& harrisParams,
+    const SaddleParameters& saddleParams,
+    const bool tracking = false
+);
+
+#endif //CORNERSENGINES_H
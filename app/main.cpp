@@ -1,28 +1,78 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 #include "opencv2/core.hpp"
 #include "opencv2/imgcodecs.hpp"
 #include "opencv2/imgproc.hpp"
-#include "opencv2/calib3d.hpp"
+#include "chessboardgrid.hpp"
+#include "cornersengines.hpp"
+#include "harrisbatch.hpp"
 #include "harrisdetector.hpp"
 #include "cornerdebugger.hpp"
+#include "cornerfile.hpp"
+#include "debugsink.hpp"
+#include "pnmimage.hpp"
+#include "streamprocessor.hpp"
 
-void detectWithFindChessboardCorners(const cv::Mat& grayImage) {
-    std::vector<cv::Point2f> corners;
-    cv::Size patternSize(9, 6);
+void detectChessboardGrid(const cv::Mat& grayImage, const std::string& engineName) {
+    const int rows = 6;
+    const int cols = 9;
+    ImageView<const uint8_t> image = CornerDebugger::viewFromCvMat(grayImage);
+    // Every corner of the board, i.e. loose threshold and a suppression
+    // window in the order of the square size
+    HarrisParameters harrisParams{};
+    harrisParams.windowOffset = 2;
+    harrisParams.thresholdPercent = 0.1F;
+    harrisParams.nmsWindowOffset = 10;
+    SaddleParameters saddleParams{};
+    saddleParams.lineOffset = 6;
+    saddleParams.thresholdPercent = 0.3F;
+    saddleParams.nmsWindowOffset = 10;
+    std::unique_ptr<ChessCornersEngine> engine = makeCornersEngine(engineName, harrisParams, saddleParams);
+    if (!engine) {
+        std::cout << "Unknown engine " << engineName << std::endl;
+        return;
+    }
+    engine->detect(image);
 
-    bool found = cv::findChessboardCorners(grayImage, patternSize, corners);
+    // Sub-pixel refinement of the engine corners on the image gradients
+    HarrisChessCornersDetector detector{};
+    detector.computeGradients(image);
+    detector.m_cornersLocation = engine->cornersLocation();
+    detector.refineCorners();
 
-    if (found) {
-        // Convert the grayscale image to a color image
-        cv::Mat colorImage;
-        cv::cvtColor(grayImage, colorImage, cv::COLOR_GRAY2BGR);
-        cv::drawChessboardCorners(colorImage, patternSize, cv::Mat(corners),
-            found);
-        // Write the image to the disk
-        cv::imwrite("find_chessboard_corners.jpg", colorImage);
-    } else {
+    ChessboardGridDetector gridDetector{};
+    ChessboardGrid grid{};
+    if (!gridDetector.recover(detector.m_cornersSubPixel, rows, cols, grid)) {
         std::cout << "Chessboard pattern not found!" << std::endl;
+        return;
+    }
+
+    // Rows joined by lines and the first corner highlighted, as
+    // cv::drawChessboardCorners() does
+    auto pixel = [&grid](int row, int col) {
+        return cv::Point(cvRound(grid.at(row, col).first), cvRound(grid.at(row, col).second));
+    };
+    cv::Mat colorImage;
+    cv::cvtColor(grayImage, colorImage, cv::COLOR_GRAY2BGR);
+    for (int row = 0; row < grid.rows; ++row) {
+        const cv::Scalar color(255 * (row % 3 == 0), 255 * (row % 3 == 1), 255 * (row % 3 == 2));
+        for (int col = 0; col < grid.cols; ++col) {
+            cv::circle(colorImage, pixel(row, col), 4, color, 1);
+            if (col > 0) {
+                cv::line(colorImage, pixel(row, col - 1), pixel(row, col), color, 1);
+            }
+        }
     }
+    cv::circle(colorImage, pixel(0, 0), 8, cv::Scalar(0, 255, 255), 2);
+    // Write the image to the disk
+    cv::imwrite("chessboard_grid_corners.jpg", colorImage);
 }
 
 void computeHarrisResponseOpenCV(const cv::Mat& grayImage) {
@@ -50,41 +100,249 @@ void computeHarrisResponseOpenCV(const cv::Mat& grayImage) {
     cv::imwrite("opencv_harris_corners.jpg", dst_norm_scaled);
 }
 
-void detectWithHarrisDetector(const cv::Mat& grayImage) {
+void detectWithHarrisDetector(const cv::Mat& grayImage, DebugSink& debugSink) {
     HarrisChessCornersDetector detector{};
-    // Convert image
-    std::vector<std::vector<uint8_t>> imageVec = CornerDebugger::fromCvMatToVectorUint8(grayImage);
+    // Borrow the image pixels, no conversion needed
+    ImageView<const uint8_t> image = CornerDebugger::viewFromCvMat(grayImage);
     // Compute the gradient
-    detector.computeGradients(imageVec);
-    cv::Mat debugImage = CornerDebugger::fromVectorFloatToCvMat(detector.m_gradientX);
-    cv::Mat debugImage2 = CornerDebugger::fromVectorFloatToCvMat(detector.m_gradientY);
-    cv::Mat debugImageMag = CornerDebugger::fromVectorFloatToCvMat(detector.m_gradientMag);
-    cv::Mat debugImageOri = CornerDebugger::fromVectorFloatToCvMat(detector.m_gradientOri);
+    detector.computeGradients(image);
+    // Intermediate planes, only copied (and the derived planes only computed)
+    // when the debug sink is enabled
+    if (debugSink.enabled()) {
+        debugSink.savePlane(detector.m_gradientX, "debug_gradient_x.jpg");
+        debugSink.savePlane(detector.m_gradientY, "debug_gradient_y.jpg");
+        debugSink.savePlane(detector.gradientMagnitude(), "debug_gradient_magnitude.jpg");
+        debugSink.savePlane(detector.gradientOrientation(), "debug_gradient_orientation.jpg");
+    }
     // Compute Corner response maps
     // detector.cornerResponse_method1();
     detector.cornerResponse_method2();
-    cv::Mat debugImageCorner = CornerDebugger::fromVectorFloatToCvMat(detector.m_cornerResponseMap);
+    debugSink.savePlane(detector.m_cornerResponseMap, "debug_corner_response.jpg");
     // Threshold the response map
     detector.thresholding();
-    cv::Mat debugImageThreshold = CornerDebugger::overlayBooleanMap(debugImageCorner, detector.m_strongCornersMap);
+    debugSink.saveCandidates(detector.m_cornerResponseMap, detector.m_candidates, "debug_candidates.jpg");
     // Non-maximal suppression
     detector.nonMaximalSuppression();
     // Show detected corners
     CornerDebugger::overlayCorners(grayImage, detector.m_cornersLocation, "custom_harris_corners.jpg");
 }
 
+void printUsage(const char* program) {
+    std::cout << "Usage:\n"
+              << "  " << program << " [image] [--engine " << kCornersEngineNames << "] [--debug]\n"
+              << "      Runs every detector on a single image and writes the debug images,\n"
+              << "      the chessboard grid being recovered from the corners of the engine.\n"
+              << "      --debug also writes the intermediate planes of the Harris detector.\n"
+              << "  " << program << " --stream <directory|video> [--output corners.csv] [--threads N] [--queue N]\n"
+              << "          [--engine " << kCornersEngineNames << "] [--keyframe N]\n"
+              << "      Detects the corners of every frame, decoding, detection and output\n"
+              << "      running concurrently, and prints the throughput and stage latencies.\n"
+              << "      --keyframe N (N > 1) tracks the Harris corners around their previous\n"
+              << "      location, with a full detection every N frames or when tracking is lost.\n"
+              << "  " << program << " --batch <directory> [--output corners.csv] [--threads N]\n"
+              << "      Detects the corners of every image of the directory, N images at a time,\n"
+              << "      and prints the throughput and the peak memory.\n"
+              << "  An --output ending with " << kCornerFileExtension << " stores the corners as binary records\n"
+              << "  (see src/cornerfile) instead of CSV lines.\n";
+}
+
+int runStream(int argc, char** argv) {
+    StreamOptions options;
+    options.source = argv[2];
+    for (int i = 3; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--output") == 0) {
+            options.output = argv[i + 1];
+        } else if (std::strcmp(argv[i], "--threads") == 0) {
+            options.detectionThreads = std::max(1, std::atoi(argv[i + 1]));
+        } else if (std::strcmp(argv[i], "--queue") == 0) {
+            options.queueCapacity = static_cast<std::size_t>(std::max(1, std::atoi(argv[i + 1])));
+        } else if (std::strcmp(argv[i], "--engine") == 0) {
+            options.engine = argv[i + 1];
+        } else if (std::strcmp(argv[i], "--keyframe") == 0) {
+            options.params.keyframeInterval = std::atoi(argv[i + 1]);
+            options.tracking = options.params.keyframeInterval > 1;
+        } else {
+            printUsage(argv[0]);
+            return -1;
+        }
+    }
+
+    StreamReport report;
+    if (!StreamProcessor(options).run(report)) {
+        return -1;
+    }
+    report.print(std::cout);
+    return 0;
+}
+
+int runBatch(int argc, char** argv) {
+    const std::string directory = argv[2];
+    std::string output = "corners.csv";
+    int threads = 1;
+    for (int i = 3; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--output") == 0) {
+            output = argv[i + 1];
+        } else if (std::strcmp(argv[i], "--threads") == 0) {
+            threads = std::max(1, std::atoi(argv[i + 1]));
+        } else {
+            printUsage(argv[0]);
+            return -1;
+        }
+    }
+
+    // The directory is processed a few images per thread at a time, so only
+    // a chunk is resident whatever the number of images. The detection only
+    // borrows the pixels: PGM/PPM frames are memory-mapped, the other formats
+    // decoded by OpenCV.
+    constexpr int kImagesPerThread = 4;
+    const std::size_t chunkSize = static_cast<std::size_t>(kImagesPerThread) * threads;
+    std::vector<std::string> files;
+    cv::glob(directory + "/*", files, false);
+    // Readers reused from chunk to chunk, which keeps the gray plane of a PPM
+    std::vector<PnmImage> pnmImages(chunkSize);
+    std::size_t pnmCount = 0;
+    std::vector<cv::Mat> grayImages;
+    std::vector<std::string> names;
+    std::vector<ImageView<const uint8_t>> images;
+
+    const bool binary = hasCornerFileExtension(output);
+    CornerFileWriter writer;
+    std::ofstream csv;
+    if (binary) {
+        if (!writer.open(output)) {
+            std::cerr << "Could not open " << output << ", or it is not a corner file" << std::endl;
+            return -1;
+        }
+    } else {
+        csv.open(output);
+        if (!csv) {
+            std::cerr << "Could not open " << output << std::endl;
+            return -1;
+        }
+        csv << "image,x,y,response\n";
+    }
+
+    HarrisBatchDetector batchDetector(threads);
+    HarrisBatchReport total;
+    // Detects the corners of the loaded chunk and writes them, the frame id of
+    // the binary records being the index of the image in the directory order
+    auto processChunk = [&]() {
+        batchDetector.detectBatch(images);
+        for (std::size_t image = 0; image < images.size(); ++image) {
+            const HarrisBatchResult& result = batchDetector.results()[image];
+            if (binary) {
+                writer.write(total.images + image, images[image].width(), images[image].height(), result.cornersLocation, result.cornersResponse);
+                continue;
+            }
+            for (std::size_t i = 0; i < result.cornersLocation.size(); ++i) {
+                csv << names[image] << ',' << result.cornersLocation[i].first << ',' << result.cornersLocation[i].second
+                    << ',' << result.cornersResponse[i] << '\n';
+            }
+        }
+        const HarrisBatchReport& report = batchDetector.report();
+        total.images += report.images;
+        total.pixels += report.pixels;
+        total.corners += report.corners;
+        total.elapsedMs += report.elapsedMs;
+        total.peakResidentBytes = report.peakResidentBytes;
+        pnmCount = 0;
+        grayImages.clear();
+        names.clear();
+        images.clear();
+    };
+
+    for (const auto& file : files) {
+        PnmImage& pnmImage = pnmImages[pnmCount];
+        if (pnmImage.open(file)) {
+            ++pnmCount;
+            names.push_back(file);
+            images.push_back(pnmImage.view());
+        } else {
+            cv::Mat gray = cv::imread(file, cv::IMREAD_GRAYSCALE);
+            if (gray.empty()) {
+                std::cerr << "Skipping " << file << ", not a readable image" << std::endl;
+                continue;
+            }
+            names.push_back(file);
+            grayImages.push_back(gray);
+            images.push_back(CornerDebugger::viewFromCvMat(grayImages.back()));
+        }
+        if (images.size() == chunkSize) {
+            processChunk();
+        }
+    }
+    if (!images.empty()) {
+        processChunk();
+    }
+    if (total.images == 0U) {
+        std::cerr << "No image found in " << directory << std::endl;
+        return -1;
+    }
+    const bool written = binary ? writer.close() : static_cast<bool>(csv.flush());
+    if (!written) {
+        std::cerr << "Could not write " << output << std::endl;
+        return -1;
+    }
+    std::cout << total.images << " images, " << total.corners << " corners in " << total.elapsedMs << " ms ("
+              << total.imagesPerSecond() << " images/s, " << total.megapixelsPerSecond() << " MP/s), peak memory "
+              << total.peakResidentBytes / (1024 * 1024) << " MiB" << std::endl;
+    return 0;
+}
+
 int main(int argc, char** argv) {
-    cv::Mat grayImage = cv::imread(
-        "/workspaces/chessboard-detector/data/checkerboard_1.ppm",
-        cv::IMREAD_GRAYSCALE
-        );
+    if (argc > 1 && (std::strcmp(argv[1], "--help") == 0 || std::strcmp(argv[1], "-h") == 0)) {
+        printUsage(argv[0]);
+        return 0;
+    }
+    if (argc > 1 && std::strcmp(argv[1], "--batch") == 0) {
+        if (argc < 3 || argc % 2 == 0) {
+            printUsage(argv[0]);
+            return -1;
+        }
+        return runBatch(argc, argv);
+    }
+    if (argc > 1 && std::strcmp(argv[1], "--stream") == 0) {
+        if (argc < 3 || argc % 2 == 0) {
+            printUsage(argv[0]);
+            return -1;
+        }
+        return runStream(argc, argv);
+    }
+
+    std::string imagePath = "/workspaces/chessboard-detector/data/checkerboard_1.ppm";
+    std::string engineName = "harris";
+    // Disabled unless --debug is given
+    DebugSink debugSink;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--engine") == 0 && i + 1 < argc) {
+            engineName = argv[++i];
+        } else if (std::strcmp(argv[i], "--debug") == 0) {
+            debugSink.enable();
+        } else if (argv[i][0] != '-') {
+            imagePath = argv[i];
+        } else {
+            printUsage(argv[0]);
+            return -1;
+        }
+    }
+    // PGM/PPM files are mapped and wrapped without copy, the other formats
+    // (the sample is a PNG despite its extension) decoded by OpenCV
+    PnmImage pnmImage;
+    cv::Mat grayImage;
+    if (pnmImage.open(imagePath)) {
+        const ImageView<const uint8_t> view = pnmImage.view();
+        grayImage = cv::Mat(view.height(), view.width(), CV_8UC1, const_cast<uint8_t*>(view.data()),
+                            static_cast<std::size_t>(view.stride()));
+    } else {
+        grayImage = cv::imread(imagePath, cv::IMREAD_GRAYSCALE);
+    }
 
     if (grayImage.empty()) {
         std::cout << "Could not open or find the image!\n" << std::endl;
         return -1;
     }
 
-    detectWithFindChessboardCorners(grayImage);
+    detectChessboardGrid(grayImage, engineName);
 
     // Uncomment to define a simple image to debug
     // uint8_t data[] = {
@@ -101,7 +359,11 @@ int main(int argc, char** argv) {
 
     computeHarrisResponseOpenCV(grayImage);
 
-    detectWithHarrisDetector(grayImage);
+    detectWithHarrisDetector(grayImage, debugSink);
+    debugSink.flush();
+    if (debugSink.failures() > 0U) {
+        std::cout << debugSink.failures() << " debug images could not be written" << std::endl;
+    }
 
     return 0;
 }
@@ -0,0 +1,253 @@
+/// @file streamprocessor.cpp
+/// @brief source file for streamprocessor
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#include "streamprocessor.hpp"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <sys/stat.h>
+#include "opencv2/core.hpp"
+#include "opencv2/imgcodecs.hpp"
+#include "opencv2/imgproc.hpp"
+#include "opencv2/videoio.hpp"
+#include "boundedqueue.hpp"
+#include "cornerdebugger.hpp"
+#include "cornerfile.hpp"
+#include "cornersengines.hpp"
+#include "pnmimage.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(const Clock::time_point& begin, const Clock::time_point& end)
+{
+    return std::chrono::duration<double, std::milli>(end - begin).count();
+}
+
+/// @brief Grayscale frames of a directory of images or of a video file.
+class FrameSource final
+{
+public:
+    bool open(const std::string& source)
+    {
+        struct stat info{};
+        if (stat(source.c_str(), &info) == 0 && S_ISDIR(info.st_mode)) {
+            // cv::glob() returns the files sorted by name
+            cv::glob(source + "/*", m_files, false);
+            m_isDirectory = true;
+            return !m_files.empty();
+        }
+        m_isDirectory = false;
+        return m_capture.open(source);
+    }
+
+    /// @brief Reads the next frame. PGM/PPM files of a directory are
+    ///        memory-mapped into @p pnm and @p gray wraps its pixels, the
+    ///        other formats are decoded by OpenCV.
+    /// @return False once the source is exhausted.
+    bool read(cv::Mat& gray, PnmImage& pnm)
+    {
+        if (m_isDirectory) {
+            while (m_nextFile < m_files.size()) {
+                const std::string& file = m_files[m_nextFile++];
+                if (pnm.open(file)) {
+                    const ImageView<const uint8_t> view = pnm.view();
+                    gray = cv::Mat(view.height(), view.width(), CV_8UC1, const_cast<uint8_t*>(view.data()),
+                                   static_cast<std::size_t>(view.stride()));
+                    return true;
+                }
+                gray = cv::imread(file, cv::IMREAD_GRAYSCALE);
+                if (!gray.empty()) {
+                    return true;
+                }
+                std::cerr << "Skipping " << file << ", not a readable image" << std::endl;
+            }
+            return false;
+        }
+        if (!m_capture.read(m_captured) || m_captured.empty()) {
+            return false;
+        }
+        // The capture reuses its buffer, every frame gets its own
+        if (m_captured.channels() == 1) {
+            gray = m_captured.clone();
+        } else {
+            cv::cvtColor(m_captured, gray, cv::COLOR_BGR2GRAY);
+        }
+        return true;
+    }
+
+private:
+    bool m_isDirectory{false};
+    std::vector<std::string> m_files;
+    std::size_t m_nextFile{0};
+    cv::VideoCapture m_capture;
+    cv::Mat m_captured;
+};
+
+/// @brief Frame travelling through the pipeline.
+struct Frame
+{
+    std::size_t index{0};
+    cv::Mat gray;
+    // Mapping of a PGM/PPM frame, gray then wraps its pixels, which stay valid
+    // as the frame is moved from stage to stage
+    PnmImage pnm;
+    int width{0};
+    int height{0};
+    std::vector<HarrisCandidate> corners;
+    Clock::time_point decodeStart;
+    double decodeMs{0.0};
+    double detectMs{0.0};
+};
+
+} // namespace
+
+void StageLatency::add(double ms) noexcept
+{
+    ++count;
+    totalMs += ms;
+    maxMs = std::max(maxMs, ms);
+}
+
+void StreamReport::print(std::ostream& stream) const
+{
+    stream << frames << " frames, " << corners << " corners in " << elapsedMs << " ms ("
+           << fps() << " fps)\n";
+    const std::pair<const char*, const StageLatency*> stages[] = {
+        {"decode", &decode}, {"detect", &detect}, {"write", &write}, {"end-to-end", &endToEnd}
+    };
+    for (const auto& stage : stages) {
+        stream << "  " << stage.first << ": mean " << stage.second->meanMs() << " ms, max "
+               << stage.second->maxMs << " ms\n";
+    }
+}
+
+StreamProcessor::StreamProcessor(const StreamOptions& options)
+    : m_options(options)
+{
+}
+
+bool StreamProcessor::run(StreamReport& report)
+{
+    report = StreamReport{};
+    std::unique_ptr<ChessCornersEngine> engine = makeCornersEngine(
+        m_options.engine, m_options.params, m_options.saddleParams, m_options.tracking
+        );
+    if (!engine) {
+        std::cerr << "Unknown engine " << m_options.engine << std::endl;
+        return false;
+    }
+    FrameSource source;
+    if (!source.open(m_options.source)) {
+        std::cerr << "Could not open " << m_options.source << std::endl;
+        return false;
+    }
+    // Binary records for a .crn output, CSV lines otherwise
+    const bool binary = hasCornerFileExtension(m_options.output);
+    std::ofstream output;
+    CornerFileWriter binaryOutput;
+    if (binary) {
+        if (!binaryOutput.open(m_options.output)) {
+            std::cerr << "Could not create " << m_options.output << ", or it is not a corner file" << std::endl;
+            return false;
+        }
+    } else {
+        output.open(m_options.output);
+        if (!output) {
+            std::cerr << "Could not create " << m_options.output << std::endl;
+            return false;
+        }
+        output << "frame,x,y,response\n";
+    }
+
+    BoundedQueue<Frame> decoded(m_options.queueCapacity);
+    BoundedQueue<Frame> detected(m_options.queueCapacity);
+    const Clock::time_point start = Clock::now();
+
+    // 1.) Decoding
+    std::thread decoder([&] {
+        for (std::size_t index = 0;; ++index) {
+            Frame frame;
+            frame.index = index;
+            frame.decodeStart = Clock::now();
+            if (!source.read(frame.gray, frame.pnm)) {
+                break;
+            }
+            frame.decodeMs = elapsedMs(frame.decodeStart, Clock::now());
+            if (!decoded.push(std::move(frame))) {
+                break;
+            }
+        }
+        decoded.close();
+    });
+
+    // 3.) Output, the statistics are only touched by this thread until it is joined
+    bool written = true;
+    std::thread writer([&] {
+        Frame frame;
+        std::vector<std::pair<int, int>> locations;
+        std::vector<float> responses;
+        while (detected.pop(frame)) {
+            const Clock::time_point writeStart = Clock::now();
+            if (binary) {
+                locations.clear();
+                responses.clear();
+                for (const auto& corner : frame.corners) {
+                    locations.push_back(std::pair<int, int>(corner.x, corner.y));
+                    responses.push_back(corner.response);
+                }
+                binaryOutput.write(frame.index, frame.width, frame.height, locations, responses);
+            } else {
+                for (const auto& corner : frame.corners) {
+                    output << frame.index << ',' << corner.x << ',' << corner.y << ',' << corner.response << '\n';
+                }
+            }
+            const Clock::time_point writeEnd = Clock::now();
+            ++report.frames;
+            report.corners += frame.corners.size();
+            report.decode.add(frame.decodeMs);
+            report.detect.add(frame.detectMs);
+            report.write.add(elapsedMs(writeStart, writeEnd));
+            report.endToEnd.add(elapsedMs(frame.decodeStart, writeEnd));
+        }
+        written = binary ? binaryOutput.close() : static_cast<bool>(output.flush());
+    });
+
+    // 2.) Detection, on the calling thread
+    engine->setParallelism(m_options.detectionThreads);
+    Frame frame;
+    while (decoded.pop(frame)) {
+        const Clock::time_point detectStart = Clock::now();
+        engine->detect(CornerDebugger::viewFromCvMat(frame.gray));
+        const std::vector<std::pair<int, int>>& locations = engine->cornersLocation();
+        const std::vector<float>& responses = engine->cornersResponse();
+        frame.corners.clear();
+        for (std::size_t i = 0; i < locations.size(); ++i) {
+            frame.corners.push_back(HarrisCandidate{locations[i].first, locations[i].second, responses[i]});
+        }
+        frame.detectMs = elapsedMs(detectStart, Clock::now());
+        frame.width = frame.gray.cols;
+        frame.height = frame.gray.rows;
+        // Not needed downstream
+        frame.gray.release();
+        frame.pnm.close();
+        detected.push(std::move(frame));
+    }
+    detected.close();
+
+    decoder.join();
+    writer.join();
+    report.elapsedMs = elapsedMs(start, Clock::now());
+    return written;
+}
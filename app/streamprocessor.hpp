@@ -0,0 +1,101 @@
+/// @file streamprocessor.hpp
+/// @brief Detection over a frame sequence as a decode -> detect -> write pipeline
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#ifndef STREAMPROCESSOR_H
+#define STREAMPROCESSOR_H
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include "harristypes.hpp"
+#include "saddletypes.hpp"
+
+/// @brief Settings of a streaming run.
+struct StreamOptions
+{
+  // Directory of frames (read in name order) or video file.
+  std::string source;
+  // CSV file receiving one "frame,x,y,response" line per corner, or corner
+  // file (see cornerfile.hpp) if it ends with kCornerFileExtension.
+  std::string output{"corners.csv"};
+  // Frames buffered between two stages, bounds the memory in use.
+  std::size_t queueCapacity{4};
+  // Threads of the detection stage, see ChessCornersEngine::setParallelism().
+  int detectionThreads{1};
+  // Detection engine, see makeCornersEngine().
+  std::string engine{"harris"};
+  // Tracks the corners between keyframes detected in full every
+  // params.keyframeInterval frames, see HarrisChessCornersDetector::track().
+  bool tracking{false};
+  // Detection parameters of the Harris engine.
+  HarrisParameters params;
+  // Detection parameters of the saddle engine.
+  SaddleParameters saddleParams;
+};
+
+/// @brief Latency statistics of one pipeline stage, in milliseconds.
+struct StageLatency
+{
+  std::size_t count{0};
+  double totalMs{0.0};
+  double maxMs{0.0};
+
+  void add(double ms) noexcept;
+  double meanMs() const noexcept { return count > 0U ? totalMs / static_cast<double>(count) : 0.0; }
+};
+
+/// @brief Statistics of a streaming run.
+struct StreamReport
+{
+  std::size_t frames{0};
+  std::size_t corners{0};
+  // Wall time from the first decode to the last write
+  double elapsedMs{0.0};
+  StageLatency decode;
+  StageLatency detect;
+  StageLatency write;
+  // From the start of the decoding to the end of the writing of a frame
+  StageLatency endToEnd;
+
+  double fps() const noexcept { return elapsedMs > 0.0 ? 1000.0 * static_cast<double>(frames) / elapsedMs : 0.0; }
+  void print(std::ostream& stream) const;
+};
+
+/// @brief Runs a corner detection engine over a directory of images or a video.
+///
+/// Decoding, detection and output run on their own thread, linked by bounded
+/// queues, so the three stages overlap and a slow stage throttles the others
+/// instead of letting frames pile up in memory. Frames are processed and
+/// written in source order.
+class StreamProcessor final
+{
+public:
+  /// @param options Settings of the run.
+  explicit StreamProcessor(const StreamOptions& options);
+  // Default copy constructor.
+  StreamProcessor(const StreamProcessor&) = default;
+  // Default copy assignment operator.
+  StreamProcessor& operator=(const StreamProcessor&) = default;
+  // Default move constructor.
+  StreamProcessor(StreamProcessor&&) = default;
+  // Default move assignment operator.
+  StreamProcessor& operator=(StreamProcessor&&) = default;
+  // Default destructor.
+  ~StreamProcessor() = default;
+
+  /// @brief Processes the whole source.
+  /// @param report Filled with the statistics of the run.
+  /// @return False if the engine is unknown or the source or the output could
+  ///         not be opened.
+  bool run(StreamReport& report);
+
+private:
+  StreamOptions m_options;
+};
+
+#endif //STREAMPROCESSOR_H
@@ -0,0 +1,1126 @@
+/// @file harrisbenchmarks.cpp
+/// @brief Timings of the Harris detector stages, of the saddle engine and of
+///        the OpenCV baselines
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "opencv2/core.hpp"
+#include "opencv2/imgcodecs.hpp"
+#include "opencv2/imgproc.hpp"
+#include "opencv2/calib3d.hpp"
+#include "chessboardgrid.hpp"
+#include "cornerfile.hpp"
+#include "harrisbatch.hpp"
+#include "harrisdetector.hpp"
+#include "harrisengine.hpp"
+#include "harriskernels.hpp"
+#include "pnmimage.hpp"
+#include "saddledetector.hpp"
+#include "syntheticboard.hpp"
+
+namespace {
+
+// Inner corners of the synthetic board, as in app/main.cpp
+constexpr int kPatternColumns = 9;
+constexpr int kPatternRows = 6;
+
+/// @brief Board of the benchmarks, from src/syntheticboard: kPatternColumns x
+///        kPatternRows inner corners fitted in the frame with a margin of one
+///        square, as captured for a calibration, and moved by
+///        (shiftX, shiftY) pixels.
+SyntheticBoardParameters boardParameters(int width, int height, float shiftX = 0.0F, float shiftY = 0.0F)
+{
+    SyntheticBoardParameters params;
+    params.width = width;
+    params.height = height;
+    params.cols = kPatternColumns;
+    params.rows = kPatternRows;
+    params.shiftX = shiftX;
+    params.shiftY = shiftY;
+    return params;
+}
+
+cv::Mat asCvMat(Image<uint8_t>& image)
+{
+    return cv::Mat(image.height(), image.width(), CV_8UC1, image.data(), static_cast<std::size_t>(image.stride()));
+}
+
+void setFrameCounters(benchmark::State& state, int width, int height)
+{
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(width) * height);
+}
+
+// Stages of the staged API, in execution order
+enum class Stage { Gradients, Response, Thresholding, Suppression };
+
+/// @brief Runs every stage before @p stage, so that it can be timed alone.
+void prepareStaged(HarrisChessCornersDetector& detector, const ImageView<const uint8_t>& image, Stage stage)
+{
+    if (stage == Stage::Gradients) return;
+    detector.computeGradients(image);
+    if (stage == Stage::Response) return;
+    detector.cornerResponse_method2();
+    if (stage == Stage::Thresholding) return;
+    detector.thresholding();
+}
+
+/// @brief Loads the sample board and runs the staged detection on it, which
+///        leaves the gradient planes and the integer corners to refine.
+/// @return False if the sample could not be read.
+bool prepareSample(HarrisChessCornersDetector& detector, cv::Mat& gray)
+{
+    gray = cv::imread(HARRIS_SAMPLE_IMAGE, cv::IMREAD_GRAYSCALE);
+    if (gray.empty()) {
+        return false;
+    }
+    const ImageView<const uint8_t> image(gray.data, gray.cols, gray.rows, static_cast<std::ptrdiff_t>(gray.step[0]));
+    prepareStaged(detector, image, Stage::Suppression);
+    detector.nonMaximalSuppression(5);
+    return true;
+}
+
+// Window offset of the sub-pixel refinement, i.e. cv::cornerSubPix() winSize
+constexpr int kRefinementWindowOffset = 3;
+
+std::vector<cv::Point2f> cornerSubPixOpenCV(const cv::Mat& gray, const std::vector<std::pair<int, int>>& corners)
+{
+    std::vector<cv::Point2f> refined;
+    for (const auto& corner : corners) {
+        refined.emplace_back(static_cast<float>(corner.first), static_cast<float>(corner.second));
+    }
+    cv::cornerSubPix(
+        gray, refined, cv::Size(kRefinementWindowOffset, kRefinementWindowOffset), cv::Size(-1, -1),
+        cv::TermCriteria(cv::TermCriteria::COUNT + cv::TermCriteria::EPS, 10, 0.01)
+        );
+    return refined;
+}
+
+// Arguments: width, height
+void resolutionSweep(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->ArgNames({"width", "height"});
+    for (const auto& resolution : std::vector<std::vector<int64_t>>{{640, 480}, {1280, 720}, {1920, 1080}, {3840, 2160}}) {
+        benchmark->Args(resolution);
+    }
+    benchmark->Unit(benchmark::kMillisecond);
+}
+
+// Arguments: width, height, parameter
+void parameterSweep(benchmark::internal::Benchmark* benchmark, const char* name, const std::vector<int64_t>& values)
+{
+    benchmark->ArgNames({"width", "height", name});
+    for (const auto& resolution : std::vector<std::vector<int64_t>>{{640, 480}, {1920, 1080}}) {
+        for (int64_t value : values) {
+            benchmark->Args({resolution[0], resolution[1], value});
+        }
+    }
+    benchmark->Unit(benchmark::kMillisecond);
+}
+
+// Distance below which a detection matches a ground truth corner
+constexpr float kMatchDistance = 3.0F;
+
+/// @brief Engines compared on the sample board, with the settings of
+///        app/main.cpp, i.e. tuned to report every corner of the board.
+std::unique_ptr<ChessCornersEngine> makeSampleEngine(int index)
+{
+    if (index == 0) {
+        HarrisParameters params{};
+        params.windowOffset = 2;
+        params.thresholdPercent = 0.1F;
+        params.nmsWindowOffset = 10;
+        return std::unique_ptr<ChessCornersEngine>(new HarrisCornersEngine(params));
+    }
+    SaddleParameters params{};
+    params.lineOffset = 6;
+    params.thresholdPercent = 0.3F;
+    params.nmsWindowOffset = 10;
+    return std::unique_ptr<ChessCornersEngine>(new SaddleChessCornersDetector(params));
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Kernels, labelled with the instruction set they were built for so that the
+// SIMD and scalar (HARRIS_ENABLE_SIMD=OFF) builds can be compared
+// ---------------------------------------------------------------------------
+
+static void BM_SobelRow(benchmark::State& state)
+{
+    const int width = static_cast<int>(state.range(0));
+    const int height = static_cast<int>(state.range(1));
+    Image<uint8_t> image = makeSyntheticBoard(boardParameters(width, height)).image;
+    Image<float> gradientX(width, height);
+    Image<float> gradientY(width, height);
+    std::vector<float> scratch(2 * static_cast<std::size_t>(width));
+    for (auto _ : state) {
+        for (int y = 1; y < height - 1; ++y) {
+            harris::sobelRow(image, y, 1, width - 1, gradientX.row(y), gradientY.row(y), scratch.data());
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetLabel(harris::simdInstructionSet());
+    setFrameCounters(state, width, height);
+}
+BENCHMARK(BM_SobelRow)->Apply(resolutionSweep);
+
+static void BM_GaussianSmoothing(benchmark::State& state)
+{
+    const int width = static_cast<int>(state.range(0));
+    const int height = static_cast<int>(state.range(1));
+    HarrisChessCornersDetector detector{};
+    detector.computeGradients(makeSyntheticBoard(boardParameters(width, height)).image);
+    const harris::GaussianKernel kernel = harris::makeGaussianKernel(1.0F);
+    Image<float> temp(width, height);
+    Image<float> output(width, height);
+    for (auto _ : state) {
+        harris::gaussianSmoothing(detector.m_gradientX, kernel, temp, output);
+        benchmark::ClobberMemory();
+    }
+    state.SetLabel(harris::simdInstructionSet());
+    setFrameCounters(state, width, height);
+}
+BENCHMARK(BM_GaussianSmoothing)->Apply(resolutionSweep);
+
+static void BM_GradientMagnitude(benchmark::State& state)
+{
+    const int width = static_cast<int>(state.range(0));
+    const int height = static_cast<int>(state.range(1));
+    HarrisChessCornersDetector detector{};
+    detector.computeGradients(makeSyntheticBoard(boardParameters(width, height)).image);
+    Image<float> magnitude(width, height);
+    for (auto _ : state) {
+        for (int y = 0; y < height; ++y) {
+            harris::gradientMagnitude(detector.m_gradientX.row(y), detector.m_gradientY.row(y), magnitude.row(y), width);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetLabel(harris::simdInstructionSet());
+    setFrameCounters(state, width, height);
+}
+BENCHMARK(BM_GradientMagnitude)->Apply(resolutionSweep);
+
+// ---------------------------------------------------------------------------
+// Staged API, one stage at a time
+// ---------------------------------------------------------------------------
+
+static void BM_ComputeGradients(benchmark::State& state)
+{
+    const int width = static_cast<int>(state.range(0));
+    const int height = static_cast<int>(state.range(1));
+    Image<uint8_t> image = makeSyntheticBoard(boardParameters(width, height)).image;
+    HarrisChessCornersDetector detector{};
+    for (auto _ : state) {
+        detector.computeGradients(image);
+        benchmark::ClobberMemory();
+    }
+    setFrameCounters(state, width, height);
+}
+BENCHMARK(BM_ComputeGradients)->Apply(resolutionSweep);
+
+namespace {
+
+// Layouts of BM_GradientLayout
+enum class PlaneLayout
+{
+    // One std::vector per row, the layout before Image<T>
+    NestedVectors = 0,
+    // Single aligned allocation, rows accessed through pointers
+    Contiguous = 1,
+};
+
+/// @brief Sobel gradients of the nested vectors layout, i.e. the former
+///        computeGradients() without the magnitude and orientation planes.
+void sobelNestedVectors(
+    const std::vector<std::vector<uint8_t>>& image,
+    std::vector<std::vector<float>>& gradientX,
+    std::vector<std::vector<float>>& gradientY
+    )
+{
+    const int height = static_cast<int>(image.size());
+    const int width = static_cast<int>(image[0].size());
+    for (int y = 1; y < height - 1; ++y) {
+        for (int x = 1; x < width - 1; ++x) {
+            gradientX[y][x] = static_cast<float>(
+                (image[y - 1][x + 1] - image[y - 1][x - 1])
+                + 2 * (image[y][x + 1] - image[y][x - 1])
+                + (image[y + 1][x + 1] - image[y + 1][x - 1]));
+            gradientY[y][x] = static_cast<float>(
+                (image[y + 1][x - 1] - image[y - 1][x - 1])
+                + 2 * (image[y + 1][x] - image[y - 1][x])
+                + (image[y + 1][x + 1] - image[y - 1][x + 1]));
+        }
+    }
+}
+
+/// @brief Same sums on Image planes, the scalar loop being left as is so that
+///        only the layout differs.
+void sobelContiguous(const Image<uint8_t>& image, Image<float>& gradientX, Image<float>& gradientY)
+{
+    const int height = image.height();
+    const int width = image.width();
+    for (int y = 1; y < height - 1; ++y) {
+        const uint8_t* above = image.row(y - 1);
+        const uint8_t* row = image.row(y);
+        const uint8_t* below = image.row(y + 1);
+        float* outX = gradientX.row(y);
+        float* outY = gradientY.row(y);
+        for (int x = 1; x < width - 1; ++x) {
+            outX[x] = static_cast<float>(
+                (above[x + 1] - above[x - 1]) + 2 * (row[x + 1] - row[x - 1]) + (below[x + 1] - below[x - 1]));
+            outY[x] = static_cast<float>(
+                (below[x - 1] - above[x - 1]) + 2 * (below[x] - above[x]) + (below[x + 1] - above[x + 1]));
+        }
+    }
+}
+
+} // namespace
+
+// Argument 2: PlaneLayout. The gradient pass on the former per-row vectors
+// against the contiguous planes, with the same scalar kernel. The planes are
+// allocated once, as the detector reuses them from frame to frame.
+static void BM_GradientLayout(benchmark::State& state)
+{
+    const int width = static_cast<int>(state.range(0));
+    const int height = static_cast<int>(state.range(1));
+    const auto layout = static_cast<PlaneLayout>(state.range(2));
+    Image<uint8_t> image = makeSyntheticBoard(boardParameters(width, height)).image;
+    if (layout == PlaneLayout::NestedVectors) {
+        std::vector<std::vector<uint8_t>> rows(height);
+        for (int y = 0; y < height; ++y) {
+            rows[y].assign(image.row(y), image.row(y) + width);
+        }
+        std::vector<std::vector<float>> gradientX(height, std::vector<float>(width, 0.0F));
+        std::vector<std::vector<float>> gradientY(height, std::vector<float>(width, 0.0F));
+        for (auto _ : state) {
+            sobelNestedVectors(rows, gradientX, gradientY);
+            benchmark::ClobberMemory();
+        }
+    } else {
+        Image<float> gradientX(width, height);
+        Image<float> gradientY(width, height);
+        for (auto _ : state) {
+            sobelContiguous(image, gradientX, gradientY);
+            benchmark::ClobberMemory();
+        }
+    }
+    setFrameCounters(state, width, height);
+}
+BENCHMARK(BM_GradientLayout)->Apply([](benchmark::internal::Benchmark* b) {
+    b->ArgNames({"width", "height", "layout"});
+    for (const auto& resolution : std::vector<std::vector<int64_t>>{{1920, 1080}, {3840, 2160}}) {
+        for (PlaneLayout layout : {PlaneLayout::NestedVectors, PlaneLayout::Contiguous}) {
+            b->Args({resolution[0], resolution[1], static_cast<int64_t>(layout)});
+        }
+    }
+    b->Unit(benchmark::kMillisecond);
+});
+
+// Argument 2: sigma in tenths
+static void BM_CornerResponseMethod1(benchmark::State& state)
+{
+    const int width = static_cast<int>(state.range(0));
+    const int height = static_cast<int>(state.range(1));
+    const float sigma = static_cast<float>(state.range(2)) / 10.0F;
+    Image<uint8_t> image = makeSyntheticBoard(boardParameters(width, height)).image;
+    HarrisChessCornersDetector detector{};
+    prepareStaged(detector, image, Stage::Response);
+    for (auto _ : state) {
+        detector.cornerResponse_method1(sigma);
+        benchmark::ClobberMemory();
+    }
+    setFrameCounters(state, width, height);
+}
+BENCHMARK(BM_CornerResponseMethod1)->Apply([](benchmark::internal::Benchmark* b) {
+    parameterSweep(b, "sigma_x10", {10, 20, 30});
+});
+
+// Argument 2: window offset of the box window
+static void BM_CornerResponseMethod2Box(benchmark::State& state)
+{
+    const int width = static_cast<int>(state.range(0));
+    const int height = static_cast<int>(state.range(1));
+    const int windowOffset = static_cast<int>(state.range(2));
+    Image<uint8_t> image = makeSyntheticBoard(boardParameters(width, height)).image;
+    HarrisChessCornersDetector detector{};
+    prepareStaged(detector, image, Stage::Response);
+    for (auto _ : state) {
+        detector.cornerResponse_method2(1.0F, 0.04F, windowOffset, TensorWeighting::Box);
+        benchmark::ClobberMemory();
+    }
+    setFrameCounters(state, width, height);
+}
+BENCHMARK(BM_CornerResponseMethod2Box)->Apply([](benchmark::internal::Benchmark* b) {
+    parameterSweep(b, "window_offset", {1, 2, 4, 8});
+});
+
+// Argument 2: sigma in tenths of the Gaussian window
+static void BM_CornerResponseMethod2Gaussian(benchmark::State& state)
+{
+    const int width = static_cast<int>(state.range(0));
+    const int height = static_cast<int>(state.range(1));
+    const float sigma = static_cast<float>(state.range(2)) / 10.0F;
+    Image<uint8_t> image = makeSyntheticBoard(boardParameters(width, height)).image;
+    HarrisChessCornersDetector detector{};
+    prepareStaged(detector, image, Stage::Response);
+    for (auto _ : state) {
+        detector.cornerResponse_method2(sigma, 0.04F, 1, TensorWeighting::Gaussian);
+        benchmark::ClobberMemory();
+    }
+    setFrameCounters(state, width, height);
+}
+BENCHMARK(BM_CornerResponseMethod2Gaussian)->Apply([](benchmark::internal::Benchmark* b) {
+    parameterSweep(b, "sigma_x10", {10, 20, 30});
+});
+
+static void BM_Thresholding(benchmark::State& state)
+{
+    const int width = static_cast<int>(state.range(0));
+    const int height = static_cast<int>(state.range(1));
+    Image<uint8_t> image = makeSyntheticBoard(boardParameters(width, height)).image;
+    HarrisChessCornersDetector detector{};
+    prepareStaged(detector, image, Stage::Thresholding);
+    for (auto _ : state) {
+        detector.thresholding();
+        benchmark::ClobberMemory();
+    }
+    state.counters["candidates"] = static_cast<double>(detector.m_candidates.size());
+    setFrameCounters(state, width, height);
+}
+BENCHMARK(BM_Thresholding)->Apply(resolutionSweep);
+
+// Argument 2: window offset of the suppression
+static void BM_NonMaximalSuppression(benchmark::State& state)
+{
+    const int width = static_cast<int>(state.range(0));
+    const int height = static_cast<int>(state.range(1));
+    const int windowOffset = static_cast<int>(state.range(2));
+    Image<uint8_t> image = makeSyntheticBoard(boardParameters(width, height)).image;
+    HarrisChessCornersDetector detector{};
+    prepareStaged(detector, image, Stage::Suppression);
+    for (auto _ : state) {
+        detector.nonMaximalSuppression(windowOffset);
+        benchmark::ClobberMemory();
+    }
+    state.counters["corners"] = static_cast<double>(detector.m_cornersLocation.size());
+    setFrameCounters(state, width, height);
+}
+BENCHMARK(BM_NonMaximalSuppression)->Apply([](benchmark::internal::Benchmark* b) {
+    parameterSweep(b, "window_offset", {1, 2, 4, 8});
+});
+
+static void BM_StagedDetection(benchmark::State& state)
+{
+    const int width = static_cast<int>(state.range(0));
+    const int height = static_cast<int>(state.range(1));
+    Image<uint8_t> image = makeSyntheticBoard(boardParameters(width, height)).image;
+    HarrisChessCornersDetector detector{};
+    for (auto _ : state) {
+        prepareStaged(detector, image, Stage::Suppression);
+        detector.nonMaximalSuppression();
+        benchmark::ClobberMemory();
+    }
+    state.counters["corners"] = static_cast<double>(detector.m_cornersLocation.size());
+    setFrameCounters(state, width, height);
+}
+BENCHMARK(BM_StagedDetection)->Apply(resolutionSweep);
+
+// ---------------------------------------------------------------------------
+// Fused API
+// ---------------------------------------------------------------------------
+
+// Argument 2: window offset of the box window
+static void BM_FusedDetection(benchmark::State& state)
+{
+    const int width = static_cast<int>(state.range(0));
+    const int height = static_cast<int>(state.range(1));
+    Image<uint8_t> image = makeSyntheticBoard(boardParameters(width, height)).image;
+    HarrisParameters params;
+    params.windowOffset = static_cast<int>(state.range(2));
+    HarrisChessCornersDetector detector{};
+    for (auto _ : state) {
+        detector.detect(image, params);
+        benchmark::ClobberMemory();
+    }
+    state.counters["corners"] = static_cast<double>(detector.m_cornersLocation.size());
+    setFrameCounters(state, width, height);
+}
+BENCHMARK(BM_FusedDetection)->Apply([](benchmark::internal::Benchmark* b) {
+    parameterSweep(b, "window_offset", {1, 2, 4, 8});
+});
+
+// Argument 2: number of threads, wall time as the work is spread over them
+static void BM_FusedDetectionThreads(benchmark::State& state)
+{
+    const int width = static_cast<int>(state.range(0));
+    const int height = static_cast<int>(state.range(1));
+    Image<uint8_t> image = makeSyntheticBoard(boardParameters(width, height)).image;
+    HarrisChessCornersDetector detector{};
+    detector.setParallelism(static_cast<int>(state.range(2)));
+    for (auto _ : state) {
+        detector.detect(image);
+        benchmark::ClobberMemory();
+    }
+    setFrameCounters(state, width, height);
+}
+BENCHMARK(BM_FusedDetectionThreads)->Apply([](benchmark::internal::Benchmark* b) {
+    parameterSweep(b, "threads", {1, 2, 4, 8});
+    b->UseRealTime();
+});
+
+// Arguments: width, height, number of threads. Thread scaling on the sample
+// board upscaled to 4K and 8K, i.e. a real capture rather than a synthetic one.
+static void BM_FusedDetectionThreadsOnSample(benchmark::State& state)
+{
+    const int width = static_cast<int>(state.range(0));
+    const int height = static_cast<int>(state.range(1));
+    const cv::Mat sample = cv::imread(HARRIS_SAMPLE_IMAGE, cv::IMREAD_GRAYSCALE);
+    if (sample.empty()) {
+        state.SkipWithError("Could not read " HARRIS_SAMPLE_IMAGE);
+        return;
+    }
+    cv::Mat gray;
+    cv::resize(sample, gray, cv::Size(width, height), 0.0, 0.0, cv::INTER_LINEAR);
+    const ImageView<const uint8_t> image(gray.data, gray.cols, gray.rows, static_cast<std::ptrdiff_t>(gray.step[0]));
+    HarrisChessCornersDetector detector{};
+    detector.setParallelism(static_cast<int>(state.range(2)));
+    for (auto _ : state) {
+        detector.detect(image);
+        benchmark::ClobberMemory();
+    }
+    setFrameCounters(state, width, height);
+}
+BENCHMARK(BM_FusedDetectionThreadsOnSample)->Apply([](benchmark::internal::Benchmark* b) {
+    b->ArgNames({"width", "height", "threads"});
+    for (const auto& resolution : std::vector<std::vector<int64_t>>{{3840, 2160}, {7680, 4320}}) {
+        for (int64_t threads : {1, 2, 4, 8}) {
+            b->Args({resolution[0], resolution[1], threads});
+        }
+    }
+    b->UseRealTime();
+    b->Unit(benchmark::kMillisecond);
+});
+
+// Arguments: width, height, number of threads. Stress input of 8K and more, a
+// dense board rotated, blurred and noisy, from src/syntheticboard. Reports the
+// share of its inner corners found by the fused detection.
+static void BM_FusedDetectionLargeFrames(benchmark::State& state)
+{
+    SyntheticBoardParameters boardParams;
+    boardParams.width = static_cast<int>(state.range(0));
+    boardParams.height = static_cast<int>(state.range(1));
+    boardParams.cols = 39;
+    boardParams.rows = 21;
+    boardParams.angle = 7.0F;
+    boardParams.noiseSigma = 3.0F;
+    const SyntheticBoard board = makeSyntheticBoard(boardParams);
+    HarrisChessCornersDetector detector{};
+    detector.setParallelism(static_cast<int>(state.range(2)));
+    for (auto _ : state) {
+        detector.detect(board.image);
+        benchmark::ClobberMemory();
+    }
+    state.counters["recall"] = matchCorners(board.corners, detector.m_cornersLocation, kMatchDistance).recall;
+    setFrameCounters(state, boardParams.width, boardParams.height);
+}
+BENCHMARK(BM_FusedDetectionLargeFrames)->Apply([](benchmark::internal::Benchmark* b) {
+    b->ArgNames({"width", "height", "threads"});
+    for (const auto& resolution : std::vector<std::vector<int64_t>>{{7680, 4320}, {10240, 5760}}) {
+        for (int64_t threads : {1, 4, 8}) {
+            b->Args({resolution[0], resolution[1], threads});
+        }
+    }
+    b->UseRealTime();
+    b->Unit(benchmark::kMillisecond);
+});
+
+// Argument 2: side of the adaptive threshold tiles, 0 for the global
+// threshold. The board is lit from one side, its contrast dropping to a tenth
+// on the other. Reports the inner corners of the board found by the fused
+// detection and the candidates the staged thresholding passes to the
+// suppression.
+static void BM_AdaptiveThreshold(benchmark::State& state)
+{
+    const int width = static_cast<int>(state.range(0));
+    const int height = static_cast<int>(state.range(1));
+    SyntheticBoard board = makeSyntheticBoard(boardParameters(width, height));
+    Image<uint8_t>& image = board.image;
+    for (int y = 0; y < height; ++y) {
+        uint8_t* row = image.row(y);
+        for (int x = 0; x < width; ++x) {
+            const float gain = 0.1F + 0.9F * static_cast<float>(x) / static_cast<float>(width);
+            row[x] = static_cast<uint8_t>(static_cast<float>(row[x]) * gain);
+        }
+    }
+    HarrisParameters params;
+    params.thresholdTileSize = static_cast<int>(state.range(2));
+    HarrisChessCornersDetector detector{};
+    for (auto _ : state) {
+        detector.detect(image, params);
+        benchmark::ClobberMemory();
+    }
+
+    const float found = matchCorners(board.corners, detector.m_cornersLocation, kMatchDistance).recall;
+    prepareStaged(detector, image, Stage::Thresholding);
+    detector.thresholding(params.thresholdPercent, params.thresholdTileSize, params.thresholdFloorPercent);
+    state.counters["corners"] = static_cast<double>(detector.m_cornersLocation.size());
+    state.counters["inner_corners_found"] = found;
+    state.counters["staged_candidates"] = static_cast<double>(detector.m_candidates.size());
+    setFrameCounters(state, width, height);
+}
+BENCHMARK(BM_AdaptiveThreshold)->Apply([](benchmark::internal::Benchmark* b) {
+    parameterSweep(b, "tile_size", {0, 64, 128, 256});
+});
+
+namespace {
+
+/// @brief Corners of a whole frame run of the fused pipeline with the given
+///        arithmetic, thresholded as in detect().
+template <typename Precision>
+std::vector<std::pair<int, int>> detectWithPrecision(
+    const Image<uint8_t>& image,
+    const HarrisParameters& params,
+    harris::BasicPipelineWorkspace<Precision>& workspace,
+    harris::RegionResult& result
+    )
+{
+    harris::detectRegion(image, ImageRect{0, 0, image.width(), image.height()}, params, workspace, result);
+    std::vector<std::pair<int, int>> corners;
+    for (const auto& candidate : result.candidates) {
+        if (candidate.response > params.thresholdPercent * result.maxResponse) {
+            corners.emplace_back(candidate.x, candidate.y);
+        }
+    }
+    return corners;
+}
+
+} // namespace
+
+// Arguments: width, height, window offset. Reports the bytes per column of the
+// row buffers and the corners that differ from the float arithmetic.
+template <typename Precision>
+static void BM_FusedDetectionPrecision(benchmark::State& state)
+{
+    const int width = static_cast<int>(state.range(0));
+    const int height = static_cast<int>(state.range(1));
+    Image<uint8_t> image = makeSyntheticBoard(boardParameters(width, height)).image;
+    HarrisParameters params;
+    params.windowOffset = static_cast<int>(state.range(2));
+    harris::BasicPipelineWorkspace<Precision> workspace;
+    harris::RegionResult result;
+    for (auto _ : state) {
+        harris::detectRegion(image, ImageRect{0, 0, width, height}, params, workspace, result);
+        benchmark::ClobberMemory();
+    }
+
+    const std::vector<std::pair<int, int>> corners = detectWithPrecision(image, params, workspace, result);
+    harris::BasicPipelineWorkspace<harris::FloatPrecision> floatWorkspace;
+    harris::RegionResult floatResult;
+    const std::vector<std::pair<int, int>> reference = detectWithPrecision(image, params, floatWorkspace, floatResult);
+    std::size_t common = 0;
+    for (const auto& corner : corners) {
+        common += std::find(reference.begin(), reference.end(), corner) != reference.end() ? 1 : 0;
+    }
+    // Sobel scratch and gradients, products, ring of horizontal sums and
+    // column sums of the structure tensor
+    const std::size_t ringRows = 2 * static_cast<std::size_t>(params.windowOffset) + 1;
+    state.counters["buffer_bytes_per_column"] = static_cast<double>(
+        4 * sizeof(typename Precision::Gradient) + 3 * sizeof(typename Precision::Product)
+        + 3 * (ringRows + 1) * sizeof(typename Precision::Accumulator)
+        );
+    state.counters["corners"] = static_cast<double>(corners.size());
+    state.counters["corners_not_in_float"] = static_cast<double>(corners.size() - common);
+    state.counters["float_corners_missed"] = static_cast<double>(reference.size() - common);
+    state.SetLabel(Precision::name());
+    setFrameCounters(state, width, height);
+}
+BENCHMARK_TEMPLATE(BM_FusedDetectionPrecision, harris::FloatPrecision)->Apply([](benchmark::internal::Benchmark* b) {
+    parameterSweep(b, "window_offset", {1, 2, 8, 30});
+});
+BENCHMARK_TEMPLATE(BM_FusedDetectionPrecision, harris::FixedPointPrecision)->Apply([](benchmark::internal::Benchmark* b) {
+    parameterSweep(b, "window_offset", {1, 2, 8, 30});
+});
+
+namespace {
+
+/// @brief Configurations of the compile-time specialized pipelines, see
+///        harris::selectDetectRegion(), as (window radius, NMS radius, Gaussian).
+const std::vector<std::vector<int>> kSpecializedConfigurations{
+    {1, 1, 0}, {1, 2, 0}, {2, 2, 0}, {2, 10, 0}, {1, 1, 1}, {2, 2, 1}};
+
+// Arguments: width, height, configuration, specialized
+void specializationSweep(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->ArgNames({"width", "height", "configuration", "specialized"});
+    for (int64_t configuration = 0; configuration < static_cast<int64_t>(kSpecializedConfigurations.size()); ++configuration) {
+        for (int64_t specialized : {0, 1}) {
+            benchmark->Args({1920, 1080, configuration, specialized});
+        }
+    }
+    benchmark->Unit(benchmark::kMillisecond);
+}
+
+} // namespace
+
+// Arguments: width, height, index in kSpecializedConfigurations, 1 to run the
+// specialized pipeline and 0 the generic one. Reports whether both find the
+// same candidates.
+template <typename Precision>
+static void BM_FusedDetectionSpecialized(benchmark::State& state)
+{
+    const int width = static_cast<int>(state.range(0));
+    const int height = static_cast<int>(state.range(1));
+    const std::vector<int>& configuration = kSpecializedConfigurations[static_cast<std::size_t>(state.range(2))];
+    Image<uint8_t> image = makeSyntheticBoard(boardParameters(width, height)).image;
+    HarrisParameters params;
+    params.nmsWindowOffset = configuration[1];
+    if (configuration[2] != 0) {
+        params.tensorWeighting = TensorWeighting::Gaussian;
+        params.sigma = static_cast<float>(configuration[0]);
+    } else {
+        params.windowOffset = configuration[0];
+    }
+    const harris::DetectRegionFunction<Precision> generic = &harris::detectRegion<Precision>;
+    const harris::DetectRegionFunction<Precision> detectRegion =
+        state.range(3) != 0 ? harris::selectDetectRegion<Precision>(params) : generic;
+    const ImageRect frame{0, 0, width, height};
+    harris::BasicPipelineWorkspace<Precision> workspace;
+    harris::RegionResult result;
+    for (auto _ : state) {
+        detectRegion(image, frame, params, workspace, result);
+        benchmark::ClobberMemory();
+    }
+
+    harris::RegionResult reference;
+    generic(image, frame, params, workspace, reference);
+    bool same = result.candidates.size() == reference.candidates.size();
+    for (std::size_t i = 0; same && i < result.candidates.size(); ++i) {
+        same = result.candidates[i].x == reference.candidates[i].x
+            && result.candidates[i].y == reference.candidates[i].y;
+    }
+    state.counters["same_candidates"] = same ? 1.0 : 0.0;
+    state.SetLabel(std::string(Precision::name())
+        + (configuration[2] != 0 ? " gaussian" : " box")
+        + " window " + std::to_string(configuration[0])
+        + " nms " + std::to_string(configuration[1]));
+    setFrameCounters(state, width, height);
+}
+BENCHMARK_TEMPLATE(BM_FusedDetectionSpecialized, harris::FloatPrecision)->Apply(specializationSweep);
+BENCHMARK_TEMPLATE(BM_FusedDetectionSpecialized, harris::FixedPointPrecision)->Apply(specializationSweep);
+
+// Argument 2: keyframe interval, 1 detects every frame in full. The board
+// moves by a few pixels per frame over a looping sequence.
+static void BM_TrackingDetection(benchmark::State& state)
+{
+    const int width = static_cast<int>(state.range(0));
+    const int height = static_cast<int>(state.range(1));
+    constexpr int kFrames = 32;
+    std::vector<Image<uint8_t>> frames;
+    for (int frame = 0; frame < kFrames; ++frame) {
+        // Back and forth, so that the loop does not jump
+        const int step = frame < kFrames / 2 ? frame : kFrames - frame;
+        frames.push_back(makeSyntheticBoard(boardParameters(
+            width, height, static_cast<float>(3 * step - 24), static_cast<float>(2 * step - 16))).image);
+    }
+    HarrisParameters params{};
+    params.keyframeInterval = static_cast<int>(state.range(2));
+    HarrisChessCornersDetector detector{};
+    int frame = 0;
+    int64_t trackedFrames = 0;
+    for (auto _ : state) {
+        detector.track(frames[frame], params);
+        trackedFrames += detector.lastFrameTracked() ? 1 : 0;
+        frame = (frame + 1) % kFrames;
+        benchmark::ClobberMemory();
+    }
+    state.counters["tracked_ratio"] = static_cast<double>(trackedFrames) / static_cast<double>(state.iterations());
+    setFrameCounters(state, width, height);
+}
+BENCHMARK(BM_TrackingDetection)->Apply([](benchmark::internal::Benchmark* b) {
+    parameterSweep(b, "keyframe_interval", {1, 10, 30});
+});
+
+// Argument 0: number of threads. A batch of 24 boards mixing the resolutions
+// of resolutionSweep(), wall time as the images are spread over the threads.
+static void BM_BatchDetection(benchmark::State& state)
+{
+    const std::vector<std::pair<int, int>> resolutions{{640, 480}, {1280, 720}, {1920, 1080}, {3840, 2160}};
+    std::vector<Image<uint8_t>> images;
+    for (int image = 0; image < 24; ++image) {
+        const std::pair<int, int>& resolution = resolutions[image % resolutions.size()];
+        images.push_back(makeSyntheticBoard(boardParameters(resolution.first, resolution.second)).image);
+    }
+    const std::vector<ImageView<const uint8_t>> views(images.begin(), images.end());
+    HarrisBatchDetector batchDetector(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        batchDetector.detectBatch(views);
+        benchmark::ClobberMemory();
+    }
+    const HarrisBatchReport& report = batchDetector.report();
+    state.counters["peak_resident_mib"] = static_cast<double>(report.peakResidentBytes) / (1024.0 * 1024.0);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(report.images));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(report.pixels));
+}
+BENCHMARK(BM_BatchDetection)->ArgName("threads")->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Argument 2: pyramid levels, 0 runs the single scale detection
+static void BM_PyramidDetection(benchmark::State& state)
+{
+    const int width = static_cast<int>(state.range(0));
+    const int height = static_cast<int>(state.range(1));
+    Image<uint8_t> image = makeSyntheticBoard(boardParameters(width, height)).image;
+    HarrisParameters params;
+    params.pyramidLevels = static_cast<int>(state.range(2));
+    HarrisChessCornersDetector detector{};
+    for (auto _ : state) {
+        detector.detect(image, params);
+        benchmark::ClobberMemory();
+    }
+    state.counters["corners"] = static_cast<double>(detector.m_cornersLocation.size());
+    setFrameCounters(state, width, height);
+}
+BENCHMARK(BM_PyramidDetection)->Apply([](benchmark::internal::Benchmark* b) {
+    b->ArgNames({"width", "height", "levels"});
+    for (int64_t levels : {0, 1, 2, 3}) {
+        b->Args({1920, 1080, levels});
+        b->Args({4000, 3000, levels});
+    }
+    b->Unit(benchmark::kMillisecond);
+});
+
+// ---------------------------------------------------------------------------
+// Saddle point engine
+// ---------------------------------------------------------------------------
+
+// Argument 2: half length of the line sums
+static void BM_SaddleDetection(benchmark::State& state)
+{
+    const int width = static_cast<int>(state.range(0));
+    const int height = static_cast<int>(state.range(1));
+    Image<uint8_t> image = makeSyntheticBoard(boardParameters(width, height)).image;
+    SaddleParameters params;
+    params.lineOffset = static_cast<int>(state.range(2));
+    SaddleChessCornersDetector detector(params);
+    for (auto _ : state) {
+        detector.detect(image);
+        benchmark::ClobberMemory();
+    }
+    state.counters["corners"] = static_cast<double>(detector.m_cornersLocation.size());
+    setFrameCounters(state, width, height);
+}
+BENCHMARK(BM_SaddleDetection)->Apply([](benchmark::internal::Benchmark* b) {
+    parameterSweep(b, "line_offset", {2, 3, 6, 12});
+});
+
+// Argument 2: number of threads, wall time as the work is spread over them
+static void BM_SaddleDetectionThreads(benchmark::State& state)
+{
+    const int width = static_cast<int>(state.range(0));
+    const int height = static_cast<int>(state.range(1));
+    Image<uint8_t> image = makeSyntheticBoard(boardParameters(width, height)).image;
+    SaddleChessCornersDetector detector{};
+    detector.setParallelism(static_cast<int>(state.range(2)));
+    for (auto _ : state) {
+        detector.detect(image);
+        benchmark::ClobberMemory();
+    }
+    setFrameCounters(state, width, height);
+}
+BENCHMARK(BM_SaddleDetectionThreads)->Apply([](benchmark::internal::Benchmark* b) {
+    parameterSweep(b, "threads", {1, 2, 4, 8});
+    b->UseRealTime();
+});
+
+// Argument 0: engine, 0 = Harris, 1 = saddle. Reports the precision and the
+// recall against the inner corners found by cv::findChessboardCorners().
+static void BM_EngineOnSample(benchmark::State& state)
+{
+    const cv::Mat gray = cv::imread(HARRIS_SAMPLE_IMAGE, cv::IMREAD_GRAYSCALE);
+    std::vector<cv::Point2f> truth;
+    if (gray.empty() || !cv::findChessboardCorners(gray, cv::Size(kPatternColumns, kPatternRows), truth)) {
+        state.SkipWithError("Could not find the board of " HARRIS_SAMPLE_IMAGE);
+        return;
+    }
+    cv::cornerSubPix(
+        gray, truth, cv::Size(kRefinementWindowOffset, kRefinementWindowOffset), cv::Size(-1, -1),
+        cv::TermCriteria(cv::TermCriteria::COUNT + cv::TermCriteria::EPS, 10, 0.01)
+        );
+    const ImageView<const uint8_t> image(gray.data, gray.cols, gray.rows, static_cast<std::ptrdiff_t>(gray.step[0]));
+    std::unique_ptr<ChessCornersEngine> engine = makeSampleEngine(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        engine->detect(image);
+        benchmark::ClobberMemory();
+    }
+
+    const std::vector<std::pair<int, int>>& corners = engine->cornersLocation();
+    std::size_t truePositives = 0;
+    std::vector<bool> found(truth.size(), false);
+    for (const auto& corner : corners) {
+        bool matched = false;
+        for (std::size_t i = 0; i < truth.size(); ++i) {
+            if (std::hypot(static_cast<float>(corner.first) - truth[i].x, static_cast<float>(corner.second) - truth[i].y) <= kMatchDistance) {
+                matched = true;
+                found[i] = true;
+            }
+        }
+        truePositives += matched ? 1 : 0;
+    }
+    state.SetLabel(engine->name());
+    state.counters["corners"] = static_cast<double>(corners.size());
+    state.counters["precision"] = corners.empty() ? 0.0 : static_cast<double>(truePositives) / static_cast<double>(corners.size());
+    state.counters["recall"] = static_cast<double>(std::count(found.begin(), found.end(), true)) / static_cast<double>(truth.size());
+    setFrameCounters(state, gray.cols, gray.rows);
+}
+BENCHMARK(BM_EngineOnSample)->ArgName("engine")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+// ---------------------------------------------------------------------------
+// Sub-pixel refinement on the sample board
+// ---------------------------------------------------------------------------
+
+// Reports the distance to the cv::cornerSubPix() locations as counters
+static void BM_RefineCorners(benchmark::State& state)
+{
+    HarrisChessCornersDetector detector{};
+    cv::Mat gray;
+    if (!prepareSample(detector, gray)) {
+        state.SkipWithError("Could not read " HARRIS_SAMPLE_IMAGE);
+        return;
+    }
+    detector.setParallelism(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        detector.refineCorners(kRefinementWindowOffset);
+        benchmark::ClobberMemory();
+    }
+
+    const std::vector<cv::Point2f> reference = cornerSubPixOpenCV(gray, detector.m_cornersLocation);
+    double sumOffset = 0.0;
+    double maxOffset = 0.0;
+    for (std::size_t i = 0; i < reference.size(); ++i) {
+        const double offset = std::hypot(
+            detector.m_cornersSubPixel[i].first - reference[i].x, detector.m_cornersSubPixel[i].second - reference[i].y
+            );
+        sumOffset += offset;
+        maxOffset = std::max(maxOffset, offset);
+    }
+    state.counters["corners"] = static_cast<double>(reference.size());
+    state.counters["mean_offset_to_opencv_px"] = reference.empty() ? 0.0 : sumOffset / static_cast<double>(reference.size());
+    state.counters["max_offset_to_opencv_px"] = maxOffset;
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(reference.size()));
+}
+BENCHMARK(BM_RefineCorners)->ArgName("threads")->Arg(1)->Arg(2)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+static void BM_OpenCVCornerSubPix(benchmark::State& state)
+{
+    HarrisChessCornersDetector detector{};
+    cv::Mat gray;
+    if (!prepareSample(detector, gray)) {
+        state.SkipWithError("Could not read " HARRIS_SAMPLE_IMAGE);
+        return;
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cornerSubPixOpenCV(gray, detector.m_cornersLocation));
+    }
+    state.counters["corners"] = static_cast<double>(detector.m_cornersLocation.size());
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(detector.m_cornersLocation.size()));
+}
+BENCHMARK(BM_OpenCVCornerSubPix)->Unit(benchmark::kMicrosecond);
+
+// ---------------------------------------------------------------------------
+// Image ingest
+// ---------------------------------------------------------------------------
+
+namespace {
+
+/// @brief Writes @p image as a binary PGM, or as a PPM with the gray value
+///        repeated on each channel, into the working directory.
+/// @return Path of the file, empty if it could not be written.
+std::string writeBenchmarkPnm(const Image<uint8_t>& image, int channels)
+{
+    const std::string path = channels == 1 ? "harris_benchmark.pgm" : "harris_benchmark.ppm";
+    std::ofstream file(path, std::ios::binary);
+    file << (channels == 1 ? "P5" : "P6") << '\n' << image.width() << ' ' << image.height() << "\n255\n";
+    std::vector<char> row(static_cast<std::size_t>(image.width()) * channels);
+    for (int y = 0; y < image.height(); ++y) {
+        for (int x = 0; x < image.width(); ++x) {
+            std::fill_n(row.begin() + x * channels, channels, static_cast<char>(image(y, x)));
+        }
+        file.write(row.data(), static_cast<std::streamsize>(row.size()));
+    }
+    return file ? path : std::string();
+}
+
+// Sum of the pixels, so that every page of a mapped file is read as the
+// decoder of cv::imread() does
+uint64_t sumPixels(const ImageView<const uint8_t>& image)
+{
+    uint64_t sum = 0;
+    for (int y = 0; y < image.height(); ++y) {
+        sum = std::accumulate(image.row(y), image.row(y) + image.width(), sum);
+    }
+    return sum;
+}
+
+} // namespace
+
+// Argument 2: channels of the file, 1 for a PGM and 3 for a PPM
+static void BM_PnmRead(benchmark::State& state)
+{
+    const int width = static_cast<int>(state.range(0));
+    const int height = static_cast<int>(state.range(1));
+    const std::string path = writeBenchmarkPnm(makeSyntheticBoard(boardParameters(width, height)).image, static_cast<int>(state.range(2)));
+    PnmImage image;
+    for (auto _ : state) {
+        if (!image.open(path)) {
+            state.SkipWithError(image.error().c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(sumPixels(image.view()));
+    }
+    image.close();
+    std::remove(path.c_str());
+    if (state.range(2) == 3) {
+        state.SetLabel(rgbToGrayInstructionSet());
+    }
+    setFrameCounters(state, width, height);
+}
+BENCHMARK(BM_PnmRead)->Apply([](benchmark::internal::Benchmark* b) {
+    parameterSweep(b, "channels", {1, 3});
+});
+
+static void BM_OpenCVImread(benchmark::State& state)
+{
+    const int width = static_cast<int>(state.range(0));
+    const int height = static_cast<int>(state.range(1));
+    const std::string path = writeBenchmarkPnm(makeSyntheticBoard(boardParameters(width, height)).image, static_cast<int>(state.range(2)));
+    for (auto _ : state) {
+        const cv::Mat gray = cv::imread(path, cv::IMREAD_GRAYSCALE);
+        benchmark::DoNotOptimize(gray.data);
+    }
+    std::remove(path.c_str());
+    setFrameCounters(state, width, height);
+}
+BENCHMARK(BM_OpenCVImread)->Apply([](benchmark::internal::Benchmark* b) {
+    parameterSweep(b, "channels", {1, 3});
+});
+
+// Argument: output format, 0 for the CSV lines of the stream mode and 1 for
+// the binary corner file
+static void BM_CornerOutput(benchmark::State& state)
+{
+    constexpr int kFrames = 1000;
+    const bool binary = state.range(0) == 1;
+    const std::string path = binary ? "harris_benchmark.crn" : "harris_benchmark.csv";
+    // Inner corners of a board, as detected in a 1080p frame
+    std::vector<std::pair<int, int>> locations;
+    std::vector<float> responses;
+    for (int i = 0; i < kPatternColumns * kPatternRows; ++i) {
+        locations.push_back(std::pair<int, int>(400 + 100 * (i % kPatternColumns), 250 + 100 * (i / kPatternColumns)));
+        responses.push_back(0.5F + 0.001F * static_cast<float>(i));
+    }
+    for (auto _ : state) {
+        std::remove(path.c_str());
+        if (binary) {
+            CornerFileWriter writer;
+            writer.open(path);
+            for (int frame = 0; frame < kFrames; ++frame) {
+                writer.write(static_cast<uint64_t>(frame), 1920, 1080, locations, responses);
+            }
+            writer.close();
+        } else {
+            std::ofstream csv(path);
+            csv << "frame,x,y,response\n";
+            for (int frame = 0; frame < kFrames; ++frame) {
+                for (std::size_t i = 0; i < locations.size(); ++i) {
+                    csv << frame << ',' << locations[i].first << ',' << locations[i].second << ',' << responses[i] << '\n';
+                }
+            }
+        }
+    }
+    std::ifstream written(path, std::ios::binary | std::ios::ate);
+    state.counters["bytes_per_frame"] = static_cast<double>(written.tellg()) / kFrames;
+    written.close();
+    std::remove(path.c_str());
+    state.SetItemsProcessed(state.iterations() * kFrames);
+}
+BENCHMARK(BM_CornerOutput)->ArgName("binary")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+// ---------------------------------------------------------------------------
+// OpenCV baselines
+// ---------------------------------------------------------------------------
+
+// Argument 2: block size, i.e. the window is blockSize x blockSize
+static void BM_OpenCVCornerHarris(benchmark::State& state)
+{
+    const int width = static_cast<int>(state.range(0));
+    const int height = static_cast<int>(state.range(1));
+    Image<uint8_t> image = makeSyntheticBoard(boardParameters(width, height)).image;
+    const cv::Mat input = asCvMat(image);
+    cv::Mat response;
+    for (auto _ : state) {
+        cv::cornerHarris(input, response, static_cast<int>(state.range(2)), 3, 0.04);
+        benchmark::ClobberMemory();
+    }
+    setFrameCounters(state, width, height);
+}
+BENCHMARK(BM_OpenCVCornerHarris)->Apply([](benchmark::internal::Benchmark* b) {
+    parameterSweep(b, "block_size", {2, 3, 5, 9});
+});
+
+static void BM_OpenCVFindChessboardCorners(benchmark::State& state)
+{
+    const int width = static_cast<int>(state.range(0));
+    const int height = static_cast<int>(state.range(1));
+    Image<uint8_t> image = makeSyntheticBoard(boardParameters(width, height)).image;
+    const cv::Mat input = asCvMat(image);
+    std::vector<cv::Point2f> corners;
+    bool found = false;
+    for (auto _ : state) {
+        found = cv::findChessboardCorners(input, cv::Size(kPatternColumns, kPatternRows), corners);
+        benchmark::DoNotOptimize(found);
+    }
+    state.counters["found"] = found ? 1.0 : 0.0;
+    setFrameCounters(state, width, height);
+}
+BENCHMARK(BM_OpenCVFindChessboardCorners)->Apply(resolutionSweep);
+
+// Same output as cv::findChessboardCorners(), i.e. Harris corners ordered by
+// the grid recovery of src/chessboard
+static void BM_ChessboardGridDetection(benchmark::State& state)
+{
+    const int width = static_cast<int>(state.range(0));
+    const int height = static_cast<int>(state.range(1));
+    const SyntheticBoard board = makeSyntheticBoard(boardParameters(width, height));
+    const Image<uint8_t>& image = board.image;
+    HarrisParameters params{};
+    params.windowOffset = 2;
+    params.thresholdPercent = 0.1F;
+    params.nmsWindowOffset = static_cast<int>(board.squareSize / 4.0F);
+    HarrisChessCornersDetector detector{};
+    ChessboardGridDetector gridDetector{};
+    ChessboardGrid grid{};
+    bool found = false;
+    for (auto _ : state) {
+        detector.detect(image, params);
+        found = gridDetector.recover(detector.m_cornersLocation, kPatternRows, kPatternColumns, grid);
+        benchmark::DoNotOptimize(found);
+    }
+    state.counters["found"] = found ? 1.0 : 0.0;
+    setFrameCounters(state, width, height);
+}
+BENCHMARK(BM_ChessboardGridDetection)->Apply(resolutionSweep);
+
+BENCHMARK_MAIN();
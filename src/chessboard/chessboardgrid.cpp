@@ -0,0 +1,365 @@
+/// @file chessboardgrid.cpp
+/// @brief source file for chessboardgrid
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#include "chessboardgrid.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+namespace {
+
+constexpr float kPi = 3.14159265358979F;
+// Orientation histogram resolution, over [0, pi)
+constexpr int kAngleBins = 36;
+// Neighbours inspected per corner to estimate the lattice directions
+constexpr int kNeighbours = 4;
+
+} // namespace
+
+bool ChessboardGridDetector::recover(
+    const std::vector<std::pair<float, float>>& corners,
+    int rows,
+    int cols,
+    ChessboardGrid& grid,
+    const ChessboardGridParameters& params)
+{
+    m_points.assign(corners.begin(), corners.end());
+    return recoverPoints(rows, cols, grid, params);
+}
+
+bool ChessboardGridDetector::recover(
+    const std::vector<std::pair<int, int>>& corners,
+    int rows,
+    int cols,
+    ChessboardGrid& grid,
+    const ChessboardGridParameters& params)
+{
+    m_points.resize(corners.size());
+    for (std::size_t i = 0; i < corners.size(); ++i) {
+        m_points[i] = std::pair<float, float>(static_cast<float>(corners[i].first), static_cast<float>(corners[i].second));
+    }
+    return recoverPoints(rows, cols, grid, params);
+}
+
+bool ChessboardGridDetector::recoverPoints(int rows, int cols, ChessboardGrid& grid, const ChessboardGridParameters& params)
+{
+    grid.rows = 0;
+    grid.cols = 0;
+    grid.corners.clear();
+    if (rows < 2 || cols < 2) {
+        return false;
+    }
+
+    // 1.) Spatial index without duplicates and lattice directions
+    mergeDuplicates(params.mergeDistance);
+    const int count = static_cast<int>(m_points.size());
+    if (count < rows * cols) {
+        return false;
+    }
+    Step u;
+    Step v;
+    if (!estimateDirections(u, v)) {
+        return false;
+    }
+
+    // 2.) Seeds, the corners closest to the centroid are the most likely to
+    //     belong to the board
+    float centroidX = 0.0F;
+    float centroidY = 0.0F;
+    for (const auto& point : m_points) {
+        centroidX += point.first;
+        centroidY += point.second;
+    }
+    centroidX /= static_cast<float>(count);
+    centroidY /= static_cast<float>(count);
+    m_seeds.resize(count);
+    for (int i = 0; i < count; ++i) {
+        m_seeds[i] = i;
+    }
+    const int seedCount = std::min(std::max(params.maxSeeds, 1), count);
+    auto distance2 = [&](int index) {
+        const float dx = m_points[index].first - centroidX;
+        const float dy = m_points[index].second - centroidY;
+        return dx * dx + dy * dy;
+    };
+    std::partial_sort(m_seeds.begin(), m_seeds.begin() + seedCount, m_seeds.end(), [&](int lhs, int rhs) {
+        return distance2(lhs) < distance2(rhs);
+    });
+
+    // 3.) Grow the lattice from each seed until a complete board is found
+    for (int s = 0; s < seedCount; ++s) {
+        const int labelled = growLattice(m_seeds[s], u, v, params.tolerance);
+        if (labelled >= rows * cols && extractWindow(labelled, rows, cols, grid)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ChessboardGridDetector::mergeDuplicates(float mergeDistance)
+{
+    const int count = static_cast<int>(m_points.size());
+    m_index.build(m_points.data(), count);
+    if (!(mergeDistance > 0.0F)) {
+        return;
+    }
+
+    // A point is dropped when an earlier point is close to it, so that a
+    // cluster of ties collapses into its first point
+    m_kept.assign(count, 0U);
+    int kept = 0;
+    for (int i = 0; i < count; ++i) {
+        bool duplicate = false;
+        m_index.visitWithin(m_points[i].first, m_points[i].second, mergeDistance, [&](int other) {
+            duplicate = other < i;
+            return !duplicate;
+        });
+        if (!duplicate) {
+            m_kept[i] = 1U;
+            ++kept;
+        }
+    }
+    if (kept == count) {
+        return;
+    }
+    int next = 0;
+    for (int i = 0; i < count; ++i) {
+        if (m_kept[i] != 0U) {
+            m_points[next++] = m_points[i];
+        }
+    }
+    m_points.resize(next);
+    m_index.build(m_points.data(), next);
+}
+
+bool ChessboardGridDetector::estimateDirections(Step& u, Step& v)
+{
+    const int count = static_cast<int>(m_points.size());
+    int neighbours[kNeighbours];
+    float distances[kNeighbours];
+
+    // Typical spacing, i.e. median distance to the nearest neighbour
+    m_spacing.resize(count);
+    for (int i = 0; i < count; ++i) {
+        const int found = m_index.nearestNeighbours(i, 1, neighbours, distances);
+        m_spacing[i] = found > 0 ? distances[0] : 0.0F;
+    }
+    std::vector<float>::iterator median = m_spacing.begin() + count / 2;
+    std::nth_element(m_spacing.begin(), median, m_spacing.end());
+    const float spacing = *median;
+    if (!(spacing > 0.0F)) {
+        return false;
+    }
+
+    // Orientations (modulo pi) of the steps to the closest neighbours. The
+    // diagonal neighbours are sqrt(2) times further and are left out.
+    float histogram[kAngleBins] = {};
+    for (int i = 0; i < count; ++i) {
+        const int found = m_index.nearestNeighbours(i, kNeighbours, neighbours, distances);
+        if (found == 0) continue;
+        const float limit = 1.25F * distances[0];
+        for (int n = 0; n < found && distances[n] <= limit; ++n) {
+            const float dx = m_points[neighbours[n]].first - m_points[i].first;
+            const float dy = m_points[neighbours[n]].second - m_points[i].second;
+            float angle = std::atan2(dy, dx);
+            if (angle < 0.0F) angle += kPi;
+            const int bin = std::min(static_cast<int>(angle / kPi * kAngleBins), kAngleBins - 1);
+            histogram[bin] += 1.0F;
+        }
+    }
+
+    // Two dominant orientations at least 30 degrees apart, on the circularly
+    // smoothed histogram
+    float smoothed[kAngleBins];
+    for (int bin = 0; bin < kAngleBins; ++bin) {
+        smoothed[bin] = histogram[(bin + kAngleBins - 1) % kAngleBins] + 2.0F * histogram[bin]
+            + histogram[(bin + 1) % kAngleBins];
+    }
+    const int first = static_cast<int>(std::max_element(smoothed, smoothed + kAngleBins) - smoothed);
+    int second = -1;
+    for (int bin = 0; bin < kAngleBins; ++bin) {
+        const int gap = std::abs(bin - first);
+        if (std::min(gap, kAngleBins - gap) < kAngleBins / 6) continue;
+        if (second < 0 || smoothed[bin] > smoothed[second]) {
+            second = bin;
+        }
+    }
+    if (!(smoothed[first] > 0.0F) || second < 0 || !(smoothed[second] > 0.0F)) {
+        return false;
+    }
+    const float angleU = (static_cast<float>(first) + 0.5F) * kPi / kAngleBins;
+    const float angleV = (static_cast<float>(second) + 0.5F) * kPi / kAngleBins;
+    u = Step{spacing * std::cos(angleU), spacing * std::sin(angleU)};
+    v = Step{spacing * std::cos(angleV), spacing * std::sin(angleV)};
+    return true;
+}
+
+int ChessboardGridDetector::growLattice(int seed, const Step& u, const Step& v, float tolerance)
+{
+    const int count = static_cast<int>(m_points.size());
+    m_label.assign(count, 0U);
+    m_latticeI.resize(count);
+    m_latticeJ.resize(count);
+    m_stepU.resize(count);
+    m_stepV.resize(count);
+    m_queue.clear();
+
+    auto find = [&](int from, const Step& step) {
+        const float length = std::sqrt(step.x * step.x + step.y * step.y);
+        return m_index.nearest(
+            m_points[from].first + step.x, m_points[from].second + step.y, tolerance * length, from
+            );
+    };
+    auto actualStep = [&](int from, int to) {
+        return Step{m_points[to].first - m_points[from].first, m_points[to].second - m_points[from].second};
+    };
+
+    // The seed must have its 4 neighbours, which give its local steps
+    const int right = find(seed, u);
+    const int left = find(seed, Step{-u.x, -u.y});
+    const int down = find(seed, v);
+    const int up = find(seed, Step{-v.x, -v.y});
+    if (right < 0 || left < 0 || down < 0 || up < 0) {
+        return 0;
+    }
+    const Step across = actualStep(left, right);
+    const Step along = actualStep(up, down);
+    m_label[seed] = 1U;
+    m_latticeI[seed] = 0;
+    m_latticeJ[seed] = 0;
+    m_stepU[seed] = Step{0.5F * across.x, 0.5F * across.y};
+    m_stepV[seed] = Step{0.5F * along.x, 0.5F * along.y};
+    m_queue.push_back(seed);
+
+    // Breadth first growth, each corner predicting its 4 neighbours
+    for (std::size_t head = 0; head < m_queue.size(); ++head) {
+        const int from = m_queue[head];
+        for (int direction = 0; direction < 4; ++direction) {
+            const bool alongU = direction < 2;
+            const float sign = (direction % 2 == 0) ? 1.0F : -1.0F;
+            const Step& base = alongU ? m_stepU[from] : m_stepV[from];
+            const int to = find(from, Step{sign * base.x, sign * base.y});
+            if (to < 0 || m_label[to] != 0U) continue;
+
+            // The step just taken replaces the predicted one along its axis
+            const Step taken = actualStep(from, to);
+            m_label[to] = 1U;
+            m_latticeI[to] = m_latticeI[from] + (alongU ? static_cast<int>(sign) : 0);
+            m_latticeJ[to] = m_latticeJ[from] + (alongU ? 0 : static_cast<int>(sign));
+            m_stepU[to] = alongU ? Step{sign * taken.x, sign * taken.y} : m_stepU[from];
+            m_stepV[to] = alongU ? m_stepV[from] : Step{sign * taken.x, sign * taken.y};
+            m_queue.push_back(to);
+        }
+    }
+    return static_cast<int>(m_queue.size());
+}
+
+bool ChessboardGridDetector::extractWindow(int labelled, int rows, int cols, ChessboardGrid& grid)
+{
+    int i0 = std::numeric_limits<int>::max();
+    int i1 = std::numeric_limits<int>::min();
+    int j0 = std::numeric_limits<int>::max();
+    int j1 = std::numeric_limits<int>::min();
+    for (int k = 0; k < labelled; ++k) {
+        const int point = m_queue[k];
+        i0 = std::min(i0, m_latticeI[point]);
+        i1 = std::max(i1, m_latticeI[point]);
+        j0 = std::min(j0, m_latticeJ[point]);
+        j1 = std::max(j1, m_latticeJ[point]);
+    }
+    const int width = i1 - i0 + 1;
+    const int height = j1 - j0 + 1;
+
+    // Lattice cells, a cell reached twice keeps the first point
+    m_cells.assign(static_cast<std::size_t>(width) * height, -1);
+    for (int k = 0; k < labelled; ++k) {
+        const int point = m_queue[k];
+        int& cell = m_cells[(m_latticeJ[point] - j0) * width + (m_latticeI[point] - i0)];
+        if (cell < 0) {
+            cell = point;
+        }
+    }
+    // Occupancy prefix sums, so that any window is checked in constant time
+    m_occupancy.assign(static_cast<std::size_t>(width + 1) * (height + 1), 0);
+    for (int j = 0; j < height; ++j) {
+        for (int i = 0; i < width; ++i) {
+            m_occupancy[(j + 1) * (width + 1) + (i + 1)] = (m_cells[j * width + i] >= 0 ? 1 : 0)
+                + m_occupancy[j * (width + 1) + (i + 1)]
+                + m_occupancy[(j + 1) * (width + 1) + i]
+                - m_occupancy[j * (width + 1) + i];
+        }
+    }
+    auto occupied = [&](int oi, int oj, int wi, int wj) {
+        return m_occupancy[(oj + wj) * (width + 1) + (oi + wi)] - m_occupancy[oj * (width + 1) + (oi + wi)]
+            - m_occupancy[(oj + wj) * (width + 1) + oi] + m_occupancy[oj * (width + 1) + oi];
+    };
+
+    // Complete window framed by the most corners, the ones found along the
+    // outer edge of the board, then closest to the centre. The board columns
+    // run along the lattice i axis, or along the j axis when transposed.
+    auto clampedOccupied = [&](int oi, int oj, int wi, int wj) {
+        const int ci0 = std::max(oi, 0);
+        const int cj0 = std::max(oj, 0);
+        const int ci1 = std::min(oi + wi, width);
+        const int cj1 = std::min(oj + wj, height);
+        return occupied(ci0, cj0, ci1 - ci0, cj1 - cj0);
+    };
+    int bestFrame = -1;
+    int bestDistance = std::numeric_limits<int>::max();
+    int bestI = 0;
+    int bestJ = 0;
+    bool bestTransposed = false;
+    for (const bool transposed : {false, true}) {
+        const int wi = transposed ? rows : cols;
+        const int wj = transposed ? cols : rows;
+        for (int oj = 0; oj + wj <= height; ++oj) {
+            for (int oi = 0; oi + wi <= width; ++oi) {
+                if (occupied(oi, oj, wi, wj) != wi * wj) continue;
+                const int frame = clampedOccupied(oi - 1, oj - 1, wi + 2, wj + 2) - wi * wj;
+                const int distance = std::abs(2 * oi - (width - wi)) + std::abs(2 * oj - (height - wj));
+                if (frame > bestFrame || (frame == bestFrame && distance < bestDistance)) {
+                    bestFrame = frame;
+                    bestDistance = distance;
+                    bestI = oi;
+                    bestJ = oj;
+                    bestTransposed = transposed;
+                }
+            }
+        }
+    }
+    if (bestFrame < 0) {
+        return false;
+    }
+
+    // Board (row, col) to point, then flip the axes so that rows go down and
+    // columns go right in the image
+    auto pointAt = [&](int row, int col) {
+        const int i = bestI + (bestTransposed ? row : col);
+        const int j = bestJ + (bestTransposed ? col : row);
+        return m_points[m_cells[j * width + i]];
+    };
+    auto dominant = [](float dx, float dy, bool vertical) {
+        return (vertical ? std::abs(dy) >= std::abs(dx) : std::abs(dx) >= std::abs(dy)) ? (vertical ? dy : dx) : (vertical ? dx : dy);
+    };
+    const std::pair<float, float> origin = pointAt(0, 0);
+    const std::pair<float, float> lastCol = pointAt(0, cols - 1);
+    const std::pair<float, float> lastRow = pointAt(rows - 1, 0);
+    const bool flipCols = dominant(lastCol.first - origin.first, lastCol.second - origin.second, false) < 0.0F;
+    const bool flipRows = dominant(lastRow.first - origin.first, lastRow.second - origin.second, true) < 0.0F;
+
+    grid.rows = rows;
+    grid.cols = cols;
+    grid.corners.resize(static_cast<std::size_t>(rows) * cols);
+    for (int row = 0; row < rows; ++row) {
+        for (int col = 0; col < cols; ++col) {
+            grid.corners[row * cols + col] = pointAt(flipRows ? rows - 1 - row : row, flipCols ? cols - 1 - col : col);
+        }
+    }
+    return true;
+}
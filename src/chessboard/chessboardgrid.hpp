@@ -0,0 +1,135 @@
+/// @file chessboardgrid.hpp
+/// @brief Recovery of the ordered chessboard lattice from unordered corners
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#ifndef CHESSBOARDGRID_H
+#define CHESSBOARDGRID_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "spatialgrid.hpp"
+
+/// @brief Inner corners of a chessboard in row-major order.
+struct ChessboardGrid
+{
+  int rows{0};
+  int cols{0};
+  // rows * cols corners, first = x, second = y. The first row is the top one
+  // and each row goes left to right, as the image is usually seen.
+  std::vector<std::pair<float, float>> corners;
+
+  const std::pair<float, float>& at(int row, int col) const noexcept { return corners[row * cols + col]; }
+};
+
+/// @brief Tolerances of the lattice recovery.
+struct ChessboardGridParameters
+{
+  // Maximum distance between a predicted and an actual neighbour, as a
+  // fraction of the local corner spacing.
+  float tolerance{0.3F};
+  // Number of corners near the centre tried as the starting point.
+  int maxSeeds{16};
+  // Corners closer than this, in pixels, are merged into the first one, e.g.
+  // the equal responses the non-maximal suppression keeps on a perfectly
+  // symmetric corner.
+  float mergeDistance{4.0F};
+};
+
+/// @brief Turns a list of corners, e.g. from HarrisChessCornersDetector, into
+///        an ordered rows x cols lattice, replacing cv::findChessboardCorners().
+///
+/// Near duplicates are merged, the corners are indexed in a SpatialGrid and
+/// the two lattice directions are estimated from the histogram of the
+/// orientations between neighbours. The lattice is then grown from a seed
+/// corner: each labelled corner predicts its four neighbours from the steps it
+/// was reached with, which adapts to the perspective distortion, and only a
+/// corner found near a prediction gets labelled. Harris also fires on the
+/// corners along the outer edge of the board, so the reported window is the
+/// fully populated rows x cols one framed by the most labelled corners, then
+/// the closest to the centre of the lattice. Every step is linear in the
+/// number of corners, except for sorting the seeds by distance to the
+/// centroid.
+class ChessboardGridDetector final
+{
+public:
+  // Default constructor.
+  ChessboardGridDetector() = default;
+  // Default copy constructor.
+  ChessboardGridDetector(const ChessboardGridDetector&) = default;
+  // Default copy assignment operator.
+  ChessboardGridDetector& operator=(const ChessboardGridDetector&) = default;
+  // Default move constructor.
+  ChessboardGridDetector(ChessboardGridDetector&&) = default;
+  // Default move assignment operator.
+  ChessboardGridDetector& operator=(ChessboardGridDetector&&) = default;
+  // Default destructor.
+  ~ChessboardGridDetector() = default;
+
+  /// @brief Looks for a rows x cols lattice among @p corners.
+  /// @param corners Corner locations, first = x, second = y.
+  /// @param rows    Inner corners per column of the board, e.g. 6 for a 9x6 pattern.
+  /// @param cols    Inner corners per row of the board, e.g. 9 for a 9x6 pattern.
+  /// @param grid    Filled with the ordered corners on success.
+  /// @param params  Tolerances.
+  /// @return True if a complete lattice was found.
+  bool recover(
+    const std::vector<std::pair<float, float>>& corners,
+    int rows,
+    int cols,
+    ChessboardGrid& grid,
+    const ChessboardGridParameters& params = ChessboardGridParameters{}
+  );
+
+  /// @brief Same as above for integer corner locations.
+  bool recover(
+    const std::vector<std::pair<int, int>>& corners,
+    int rows,
+    int cols,
+    ChessboardGrid& grid,
+    const ChessboardGridParameters& params = ChessboardGridParameters{}
+  );
+
+private:
+  // Step between two neighbours of the lattice
+  struct Step
+  {
+    float x{0.0F};
+    float y{0.0F};
+  };
+
+  // Recovery over m_points
+  bool recoverPoints(int rows, int cols, ChessboardGrid& grid, const ChessboardGridParameters& params);
+  void mergeDuplicates(float mergeDistance);
+  bool estimateDirections(Step& u, Step& v);
+  int growLattice(int seed, const Step& u, const Step& v, float tolerance);
+  bool extractWindow(int labelled, int rows, int cols, ChessboardGrid& grid);
+
+  std::vector<std::pair<float, float>> m_points;
+  SpatialGrid m_index;
+  // Whether each point is kept by mergeDuplicates()
+  std::vector<uint8_t> m_kept;
+  // Distance of each point to its nearest neighbour
+  std::vector<float> m_spacing;
+  // Seeds candidates, closest to the centroid first
+  std::vector<int> m_seeds;
+  // Lattice coordinates of each point and the steps it was reached with,
+  // m_label[i] is false for points outside the lattice
+  std::vector<uint8_t> m_label;
+  std::vector<int> m_latticeI;
+  std::vector<int> m_latticeJ;
+  std::vector<Step> m_stepU;
+  std::vector<Step> m_stepV;
+  // Breadth first traversal queue, i.e. the labelled points
+  std::vector<int> m_queue;
+  // Point index of each lattice cell in the bounding box, -1 if empty, and
+  // the 2D prefix sum of the occupancy
+  std::vector<int> m_cells;
+  std::vector<int> m_occupancy;
+};
+
+#endif //CHESSBOARDGRID_H
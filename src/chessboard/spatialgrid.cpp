@@ -0,0 +1,152 @@
+/// @file spatialgrid.cpp
+/// @brief source file for spatialgrid
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#include "spatialgrid.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+void SpatialGrid::build(const std::pair<float, float>* points, int count, float cellSize)
+{
+    m_points = points;
+    m_count = std::max(count, 0);
+    if (m_count == 0) {
+        m_columns = 0;
+        m_rows = 0;
+        m_cellStart.assign(1, 0);
+        m_indices.clear();
+        return;
+    }
+
+    float minX = points[0].first;
+    float maxX = points[0].first;
+    float minY = points[0].second;
+    float maxY = points[0].second;
+    for (int i = 1; i < m_count; ++i) {
+        minX = std::min(minX, points[i].first);
+        maxX = std::max(maxX, points[i].first);
+        minY = std::min(minY, points[i].second);
+        maxY = std::max(maxY, points[i].second);
+    }
+    if (!(cellSize > 0.0F)) {
+        // About one point per cell
+        cellSize = std::sqrt((maxX - minX) * (maxY - minY) / static_cast<float>(m_count));
+    }
+    // Keep the number of cells in the order of the number of points, whatever
+    // the spread of the points along each axis
+    const float minCellSize = std::max(maxX - minX, maxY - minY) / static_cast<float>(m_count);
+    m_cellSize = std::max({cellSize, minCellSize, std::numeric_limits<float>::min()});
+    m_originX = minX;
+    m_originY = minY;
+    m_columns = static_cast<int>((maxX - minX) / m_cellSize) + 1;
+    m_rows = static_cast<int>((maxY - minY) / m_cellSize) + 1;
+
+    // Counting sort of the points by cell
+    m_cellStart.assign(static_cast<std::size_t>(m_columns) * m_rows + 1, 0);
+    for (int i = 0; i < m_count; ++i) {
+        ++m_cellStart[cellRow(points[i].second) * m_columns + cellColumn(points[i].first) + 1];
+    }
+    for (std::size_t cell = 1; cell < m_cellStart.size(); ++cell) {
+        m_cellStart[cell] += m_cellStart[cell - 1];
+    }
+    m_indices.resize(m_count);
+    for (int i = 0; i < m_count; ++i) {
+        const int cell = cellRow(points[i].second) * m_columns + cellColumn(points[i].first);
+        // m_cellStart[cell] is used as the insertion cursor of the cell...
+        m_indices[m_cellStart[cell]++] = i;
+    }
+    // ...so that it ends up at the start of the next cell
+    for (std::size_t cell = m_cellStart.size() - 1; cell > 0; --cell) {
+        m_cellStart[cell] = m_cellStart[cell - 1];
+    }
+    m_cellStart[0] = 0;
+}
+
+int SpatialGrid::cellColumn(float x) const noexcept
+{
+    return std::min(std::max(static_cast<int>(std::floor((x - m_originX) / m_cellSize)), 0), m_columns - 1);
+}
+
+int SpatialGrid::cellRow(float y) const noexcept
+{
+    return std::min(std::max(static_cast<int>(std::floor((y - m_originY) / m_cellSize)), 0), m_rows - 1);
+}
+
+int SpatialGrid::nearest(float x, float y, float maxDistance, int exclude) const noexcept
+{
+    if (m_count == 0 || maxDistance < 0.0F) {
+        return -1;
+    }
+    const int column0 = std::max(static_cast<int>(std::floor((x - maxDistance - m_originX) / m_cellSize)), 0);
+    const int column1 = std::min(static_cast<int>(std::floor((x + maxDistance - m_originX) / m_cellSize)), m_columns - 1);
+    const int row0 = std::max(static_cast<int>(std::floor((y - maxDistance - m_originY) / m_cellSize)), 0);
+    const int row1 = std::min(static_cast<int>(std::floor((y + maxDistance - m_originY) / m_cellSize)), m_rows - 1);
+
+    int best = -1;
+    float bestDistance2 = maxDistance * maxDistance;
+    for (int row = row0; row <= row1; ++row) {
+        for (int column = column0; column <= column1; ++column) {
+            const int cell = row * m_columns + column;
+            for (int k = m_cellStart[cell]; k < m_cellStart[cell + 1]; ++k) {
+                const int index = m_indices[k];
+                const float dx = m_points[index].first - x;
+                const float dy = m_points[index].second - y;
+                const float distance2 = dx * dx + dy * dy;
+                if (index != exclude && distance2 <= bestDistance2) {
+                    best = index;
+                    bestDistance2 = distance2;
+                }
+            }
+        }
+    }
+    return best;
+}
+
+int SpatialGrid::nearestNeighbours(int index, int k, int* neighbours, float* distances) const noexcept
+{
+    const float x = m_points[index].first;
+    const float y = m_points[index].second;
+    const int column = cellColumn(x);
+    const int row = cellRow(y);
+    int found = 0;
+
+    // Visit square rings of cells around the point. Every point of ring r + 1
+    // is at least r cells away, which bounds the search.
+    const int maxRing = std::max(m_columns, m_rows);
+    for (int ring = 0; ring <= maxRing; ++ring) {
+        if (found == k && distances[k - 1] <= static_cast<float>(ring - 1) * m_cellSize) {
+            break;
+        }
+        for (int r = row - ring; r <= row + ring; ++r) {
+            if (r < 0 || r >= m_rows) continue;
+            const bool edgeRow = (r == row - ring || r == row + ring);
+            for (int c = column - ring; c <= column + ring; c += (edgeRow || ring == 0) ? 1 : 2 * ring) {
+                if (c < 0 || c >= m_columns) continue;
+                const int cell = r * m_columns + c;
+                for (int p = m_cellStart[cell]; p < m_cellStart[cell + 1]; ++p) {
+                    const int candidate = m_indices[p];
+                    if (candidate == index) continue;
+                    const float dx = m_points[candidate].first - x;
+                    const float dy = m_points[candidate].second - y;
+                    const float distance = std::sqrt(dx * dx + dy * dy);
+                    if (found == k && distance >= distances[k - 1]) continue;
+                    // Insertion into the sorted list of the closest ones
+                    int position = (found < k) ? found++ : k - 1;
+                    while (position > 0 && distances[position - 1] > distance) {
+                        neighbours[position] = neighbours[position - 1];
+                        distances[position] = distances[position - 1];
+                        --position;
+                    }
+                    neighbours[position] = candidate;
+                    distances[position] = distance;
+                }
+            }
+        }
+    }
+    return found;
+}
@@ -0,0 +1,100 @@
+/// @file spatialgrid.hpp
+/// @brief Uniform grid index answering nearest-point queries over 2D points
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+#include <utility>
+#include <vector>
+
+/// @brief Buckets points in square cells so that a query only visits the few
+///        cells around it. Built in linear time with a counting sort, and a
+///        query costs O(1) on evenly spread points when the cell size is about
+///        their spacing. The points are not copied and must outlive the index.
+class SpatialGrid final
+{
+public:
+  // Default constructor, empty index.
+  SpatialGrid() = default;
+  // Default copy constructor.
+  SpatialGrid(const SpatialGrid&) = default;
+  // Default copy assignment operator.
+  SpatialGrid& operator=(const SpatialGrid&) = default;
+  // Default move constructor.
+  SpatialGrid(SpatialGrid&&) = default;
+  // Default move assignment operator.
+  SpatialGrid& operator=(SpatialGrid&&) = default;
+  // Default destructor.
+  ~SpatialGrid() = default;
+
+  /// @brief Indexes @p count points, the buffers are reused between builds.
+  /// @param points   Points, first = x, second = y.
+  /// @param count    Number of points.
+  /// @param cellSize Side of a cell, 0 or less to use the mean spacing of the
+  ///                 points over their bounding box.
+  void build(const std::pair<float, float>* points, int count, float cellSize = 0.0F);
+
+  /// @brief Closest point to (x, y) at most @p maxDistance away.
+  /// @param exclude Index of a point to ignore, e.g. the query point itself.
+  /// @return Its index, -1 if there is none.
+  int nearest(float x, float y, float maxDistance, int exclude = -1) const noexcept;
+
+  /// @brief The @p k closest points to point @p index, itself excluded.
+  /// @param neighbours Filled with up to @p k indices, closest first.
+  /// @param distances  Their distances to the point.
+  /// @return Number of neighbours found, less than @p k only if the index
+  ///         holds fewer points.
+  int nearestNeighbours(int index, int k, int* neighbours, float* distances) const noexcept;
+
+  /// @brief Calls @p visitor(index) for every point at most @p maxDistance
+  ///        away from (x, y), in no particular order. The visitor returns
+  ///        false to stop the search early.
+  template <typename Visitor>
+  void visitWithin(float x, float y, float maxDistance, Visitor&& visitor) const
+  {
+    if (m_count == 0 || maxDistance < 0.0F) {
+      return;
+    }
+    const int column0 = cellColumn(x - maxDistance);
+    const int column1 = cellColumn(x + maxDistance);
+    const int row0 = cellRow(y - maxDistance);
+    const int row1 = cellRow(y + maxDistance);
+    for (int row = row0; row <= row1; ++row) {
+      for (int column = column0; column <= column1; ++column) {
+        const int cell = row * m_columns + column;
+        for (int k = m_cellStart[cell]; k < m_cellStart[cell + 1]; ++k) {
+          const int index = m_indices[k];
+          const float dx = m_points[index].first - x;
+          const float dy = m_points[index].second - y;
+          if (dx * dx + dy * dy <= maxDistance * maxDistance && !visitor(index)) {
+            return;
+          }
+        }
+      }
+    }
+  }
+
+  float cellSize() const noexcept { return m_cellSize; }
+
+private:
+  int cellColumn(float x) const noexcept;
+  int cellRow(float y) const noexcept;
+
+  const std::pair<float, float>* m_points{nullptr};
+  int m_count{0};
+  float m_cellSize{1.0F};
+  float m_originX{0.0F};
+  float m_originY{0.0F};
+  int m_columns{0};
+  int m_rows{0};
+  // Points of cell c are m_indices[m_cellStart[c]] .. m_indices[m_cellStart[c + 1] - 1]
+  std::vector<int> m_cellStart;
+  std::vector<int> m_indices;
+};
+
+#endif //SPATIALGRID_H
@@ -13,6 +13,8 @@
 #include <string>
 #include <cstdint>
 #include <utility> // std::pair to simply store 2D coordinates
+#include "image.hpp"
+#include "harristypes.hpp"
 
 // Forward declarations
 namespace cv {
@@ -35,13 +37,17 @@ public:
   // Default destructor.
   ~CornerDebugger() = default;
 
-  static void saveDebugImage(const std::vector<std::vector<float>>& image, const std::string& filename);
+  static void saveDebugImage(const ImageView<const float>& image, const std::string& filename);
 
-  static std::vector<std::vector<uint8_t>> fromCvMatToVectorUint8(const cv::Mat& opencv_image);
+  static Image<uint8_t> fromCvMatToImageUint8(const cv::Mat& opencv_image);
 
-  static cv::Mat fromVectorFloatToCvMat(const std::vector<std::vector<float>>& vector);
+  /// @brief Borrows the pixels of a CV_8UC1 cv::Mat, continuous or not (e.g. a
+  ///        ROI), without copying them. The view is valid while the cv::Mat is.
+  static ImageView<const uint8_t> viewFromCvMat(const cv::Mat& opencv_image);
 
-  static cv::Mat overlayBooleanMap(const cv::Mat& image, const std::vector<std::vector<bool>>& boolMap);
+  static cv::Mat fromImageFloatToCvMat(const ImageView<const float>& image);
+
+  static cv::Mat overlayCandidates(const cv::Mat& image, const std::vector<HarrisCandidate>& candidates);
 
   static void overlayCorners(const cv::Mat& opencv_image, const std::vector<std::pair<int, int>>& corners, const std::string& filename);
 };
@@ -0,0 +1,178 @@
+/// @file debugsink.cpp
+/// @brief source file for debugsink
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#include "debugsink.hpp"
+#include <opencv2/core.hpp>
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+#include <algorithm>
+#include "cornerdebugger.hpp"
+
+namespace {
+
+template <typename T>
+void copyPlane(const ImageView<const T>& source, Image<T>& destination)
+{
+    destination.reshape(source.width(), source.height());
+    for (int y = 0; y < source.height(); ++y) {
+        std::copy(source.row(y), source.row(y) + source.width(), destination.row(y));
+    }
+}
+
+} // namespace
+
+DebugSink::~DebugSink()
+{
+    if (!enabled()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_notEmpty.notify_one();
+    m_worker.join();
+}
+
+void DebugSink::enable(std::size_t capacity)
+{
+    if (enabled()) {
+        return;
+    }
+    m_capacity = std::max<std::size_t>(capacity, 1U);
+    m_worker = std::thread(&DebugSink::run, this);
+}
+
+void DebugSink::savePlane(const ImageView<const float>& plane, const std::string& filename)
+{
+    if (!enabled() || plane.empty()) {
+        return;
+    }
+    std::unique_ptr<Job> job = acquireJob();
+    copyPlane(plane, job->plane);
+    job->filename = filename;
+    submit(std::move(job));
+}
+
+void DebugSink::saveCandidates(
+    const ImageView<const float>& plane,
+    const std::vector<HarrisCandidate>& candidates,
+    const std::string& filename
+    )
+{
+    if (!enabled() || plane.empty()) {
+        return;
+    }
+    std::unique_ptr<Job> job = acquireJob();
+    copyPlane(plane, job->plane);
+    job->candidates.assign(candidates.begin(), candidates.end());
+    job->filename = filename;
+    submit(std::move(job));
+}
+
+void DebugSink::saveCorners(
+    const ImageView<const uint8_t>& image,
+    const std::vector<std::pair<int, int>>& corners,
+    const std::string& filename
+    )
+{
+    if (!enabled() || image.empty()) {
+        return;
+    }
+    std::unique_ptr<Job> job = acquireJob();
+    copyPlane(image, job->image);
+    job->corners.assign(corners.begin(), corners.end());
+    job->filename = filename;
+    submit(std::move(job));
+}
+
+void DebugSink::flush()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_drained.wait(lock, [this] { return m_pending.empty() && !m_writing; });
+}
+
+std::unique_ptr<DebugSink::Job> DebugSink::acquireJob()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    // Backpressure, the caller waits while the writer is behind
+    m_notFull.wait(lock, [this] { return m_pending.size() < m_capacity; });
+    if (m_freeJobs.empty()) {
+        return std::unique_ptr<Job>(new Job());
+    }
+    std::unique_ptr<Job> job = std::move(m_freeJobs.back());
+    m_freeJobs.pop_back();
+    // Buffers keep their capacity, and the plane of another kind of job is
+    // emptied so that write() tells the kinds apart
+    job->plane.reshape(0, 0);
+    job->image.reshape(0, 0);
+    job->candidates.clear();
+    job->corners.clear();
+    return job;
+}
+
+void DebugSink::submit(std::unique_ptr<Job> job)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending.push_back(std::move(job));
+    }
+    m_notEmpty.notify_one();
+}
+
+void DebugSink::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        m_notEmpty.wait(lock, [this] { return m_stopping || !m_pending.empty(); });
+        if (m_pending.empty()) {
+            return;
+        }
+        std::unique_ptr<Job> job = std::move(m_pending.front());
+        m_pending.pop_front();
+        m_writing = true;
+        m_notFull.notify_one();
+
+        lock.unlock();
+        // A debug image is not worth the process, the job is dropped and the
+        // thread keeps serving the queue
+        try {
+            write(*job);
+        } catch (...) {
+            m_failures.fetch_add(1U, std::memory_order_relaxed);
+        }
+        lock.lock();
+
+        m_freeJobs.push_back(std::move(job));
+        m_writing = false;
+        if (m_pending.empty()) {
+            m_drained.notify_all();
+        }
+    }
+}
+
+void DebugSink::write(const Job& job)
+{
+    cv::Mat output;
+    if (!job.plane.empty()) {
+        output = CornerDebugger::fromImageFloatToCvMat(job.plane);
+        if (!job.candidates.empty()) {
+            output = CornerDebugger::overlayCandidates(output, job.candidates);
+        }
+    } else {
+        const cv::Mat gray(
+            job.image.height(), job.image.width(), CV_8UC1,
+            const_cast<uint8_t*>(job.image.data()), static_cast<size_t>(job.image.stride())
+            );
+        cv::cvtColor(gray, output, cv::COLOR_GRAY2BGR);
+        for (const auto& corner : job.corners) {
+            cv::circle(output, cv::Point2i(corner.first, corner.second), 5, cv::Scalar(255, 0, 0), 2);
+        }
+    }
+    cv::imwrite(job.filename, output);
+}
@@ -0,0 +1,118 @@
+/// @file debugsink.hpp
+/// @brief Opt-in asynchronous writer of the debug images
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#ifndef DEBUGSINK_H
+#define DEBUGSINK_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "image.hpp"
+#include "harristypes.hpp"
+
+/// @brief Writes the intermediate planes of a detection to the disk on a
+///        background thread.
+///
+/// The sink is disabled by default, and every save*() call then returns at
+/// once, so production runs pay nothing for the diagnostics. Once enabled, a
+/// call only copies its inputs (row by row, into buffers recycled between
+/// calls) and queues them; the normalisation, the drawing of the corners and
+/// the encoding run on the background thread, which overlaps them with the
+/// detection. Overlays are drawn from the sparse candidate or corner lists.
+/// Empty planes are ignored, and an image that cannot be drawn or encoded is
+/// dropped and counted in failures(), so the diagnostics never stop the
+/// detection.
+class DebugSink final
+{
+public:
+  // Default constructor, disabled sink.
+  DebugSink() = default;
+  // Non copyable, the sink owns its thread.
+  DebugSink(const DebugSink&) = delete;
+  // Non copyable.
+  DebugSink& operator=(const DebugSink&) = delete;
+  // Writes the queued images and joins the thread.
+  ~DebugSink();
+
+  /// @brief Starts the background thread, no-op if already enabled.
+  /// @param capacity Images queued at most, a save*() call waits for a free
+  ///                 slot beyond, which bounds the memory in use.
+  void enable(std::size_t capacity = 8);
+
+  /// @brief True once enable() was called.
+  bool enabled() const noexcept { return m_worker.joinable(); }
+
+  /// @brief Writes @p plane normalised to [0, 255], nothing if it is empty,
+  ///        e.g. a gradient plane after a fused detect().
+  void savePlane(const ImageView<const float>& plane, const std::string& filename);
+
+  /// @brief Writes @p plane normalised to [0, 255] with a red circle on each
+  ///        candidate, nothing if @p plane is empty.
+  void saveCandidates(
+    const ImageView<const float>& plane,
+    const std::vector<HarrisCandidate>& candidates,
+    const std::string& filename
+  );
+
+  /// @brief Writes @p image with a blue circle on each corner, nothing if it
+  ///        is empty.
+  /// @param corners first = x, second = y, e.g. m_cornersLocation.
+  void saveCorners(
+    const ImageView<const uint8_t>& image,
+    const std::vector<std::pair<int, int>>& corners,
+    const std::string& filename
+  );
+
+  /// @brief Waits until every queued image is written.
+  void flush();
+
+  /// @brief Images dropped since enable() because they could not be written,
+  ///        e.g. an unknown file extension or a candidate outside the plane.
+  std::size_t failures() const noexcept { return m_failures.load(std::memory_order_relaxed); }
+
+private:
+  // Pending image, the unused members stay empty
+  struct Job
+  {
+    Image<float> plane;
+    Image<uint8_t> image;
+    std::vector<HarrisCandidate> candidates;
+    std::vector<std::pair<int, int>> corners;
+    std::string filename;
+  };
+
+  std::unique_ptr<Job> acquireJob();
+  void submit(std::unique_ptr<Job> job);
+  void run();
+  static void write(const Job& job);
+
+  std::size_t m_capacity{0};
+  std::deque<std::unique_ptr<Job>> m_pending;
+  // Written jobs, their buffers are reused by the next calls
+  std::vector<std::unique_ptr<Job>> m_freeJobs;
+  // Job being written by the background thread
+  bool m_writing{false};
+  bool m_stopping{false};
+  // Jobs dropped by run() because write() threw
+  std::atomic<std::size_t> m_failures{0U};
+  std::mutex m_mutex;
+  std::condition_variable m_notEmpty;
+  std::condition_variable m_notFull;
+  std::condition_variable m_drained;
+  std::thread m_worker;
+};
+
+#endif //DEBUGSINK_H
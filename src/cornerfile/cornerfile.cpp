@@ -0,0 +1,222 @@
+/// @file cornerfile.cpp
+/// @brief source file for cornerfile
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#include "cornerfile.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+bool isCornerFileHeader(const CornerFileHeader& header) noexcept
+{
+    return std::memcmp(header.magic, kCornerFileMagic, sizeof(kCornerFileMagic)) == 0
+        && header.version == kCornerFileVersion;
+}
+
+std::size_t pointBytes(uint16_t format) noexcept
+{
+    switch (static_cast<CornerFormat>(format)) {
+    case CornerFormat::Int:
+        return sizeof(CornerPointInt);
+    case CornerFormat::Float:
+        return sizeof(CornerPointFloat);
+    }
+    return 0;
+}
+
+CornerPointInt makePoint(const std::pair<int, int>& location, float response) noexcept
+{
+    return CornerPointInt{
+        static_cast<uint16_t>(std::min(std::max(location.first, 0), 65535)),
+        static_cast<uint16_t>(std::min(std::max(location.second, 0), 65535)),
+        response
+    };
+}
+
+CornerPointFloat makePoint(const std::pair<float, float>& location, float response) noexcept
+{
+    return CornerPointFloat{location.first, location.second, response};
+}
+
+} // namespace
+
+bool hasCornerFileExtension(const std::string& path) noexcept
+{
+    const std::size_t length = std::strlen(kCornerFileExtension);
+    return path.size() > length && path.compare(path.size() - length, length, kCornerFileExtension) == 0;
+}
+
+CornerFileWriter::CornerFileWriter(std::size_t bufferBytes)
+    : m_bufferBytes(bufferBytes)
+{
+    m_buffer.reserve(m_bufferBytes);
+}
+
+CornerFileWriter::~CornerFileWriter()
+{
+    close();
+}
+
+bool CornerFileWriter::open(const std::string& path)
+{
+    close();
+    // An existing file is only appended to if it is a complete corner file,
+    // a record after a truncated one could never be read
+    bool append = false;
+    {
+        std::ifstream existing(path, std::ios::binary);
+        if (existing && existing.peek() != std::ifstream::traits_type::eof()) {
+            existing.close();
+            CornerFileReader reader;
+            if (!reader.open(path) || !reader.complete()) {
+                return false;
+            }
+            append = true;
+        }
+    }
+    m_file.open(path, std::ios::binary | std::ios::app);
+    if (!m_file) {
+        return false;
+    }
+    if (!append) {
+        CornerFileHeader header{};
+        std::memcpy(header.magic, kCornerFileMagic, sizeof(kCornerFileMagic));
+        header.version = kCornerFileVersion;
+        m_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+    return static_cast<bool>(m_file);
+}
+
+void CornerFileWriter::write(
+    uint64_t frameId,
+    int width,
+    int height,
+    const std::vector<std::pair<int, int>>& locations,
+    const std::vector<float>& responses
+    )
+{
+    append<CornerPointInt>(frameId, width, height, CornerFormat::Int, locations, responses);
+}
+
+void CornerFileWriter::write(
+    uint64_t frameId,
+    int width,
+    int height,
+    const std::vector<std::pair<float, float>>& locations,
+    const std::vector<float>& responses
+    )
+{
+    append<CornerPointFloat>(frameId, width, height, CornerFormat::Float, locations, responses);
+}
+
+template <typename Point, typename Location>
+void CornerFileWriter::append(
+    uint64_t frameId,
+    int width,
+    int height,
+    CornerFormat format,
+    const std::vector<Location>& locations,
+    const std::vector<float>& responses
+    )
+{
+    CornerRecordHeader header{};
+    header.frameId = frameId;
+    header.width = static_cast<uint32_t>(std::max(width, 0));
+    header.height = static_cast<uint32_t>(std::max(height, 0));
+    header.cornerCount = static_cast<uint32_t>(locations.size());
+    header.format = static_cast<uint16_t>(format);
+
+    // Serialised in place, the buffer only grows beyond bufferBytes for a
+    // single record larger than it
+    const std::size_t offset = m_buffer.size();
+    m_buffer.resize(offset + sizeof(header) + locations.size() * sizeof(Point));
+    std::memcpy(m_buffer.data() + offset, &header, sizeof(header));
+    char* points = m_buffer.data() + offset + sizeof(header);
+    for (std::size_t i = 0; i < locations.size(); ++i) {
+        const Point point = makePoint(locations[i], i < responses.size() ? responses[i] : 0.0F);
+        std::memcpy(points + i * sizeof(Point), &point, sizeof(Point));
+    }
+    if (m_buffer.size() >= m_bufferBytes) {
+        flush();
+    }
+}
+
+bool CornerFileWriter::flush()
+{
+    if (!m_file.is_open()) {
+        return false;
+    }
+    if (!m_buffer.empty()) {
+        m_file.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+        m_buffer.clear();
+    }
+    m_file.flush();
+    return static_cast<bool>(m_file);
+}
+
+bool CornerFileWriter::close()
+{
+    if (!m_file.is_open()) {
+        return true;
+    }
+    const bool written = flush();
+    m_file.close();
+    return written;
+}
+
+bool CornerFileReader::open(const std::string& path)
+{
+    m_records.clear();
+    m_complete = false;
+    if (!m_file.open(path) || m_file.size() < sizeof(CornerFileHeader)) {
+        m_file.close();
+        return false;
+    }
+    CornerFileHeader fileHeader{};
+    std::memcpy(&fileHeader, m_file.data(), sizeof(fileHeader));
+    if (!isCornerFileHeader(fileHeader)) {
+        m_file.close();
+        return false;
+    }
+
+    // Index the records, up to the first incomplete one
+    std::size_t offset = sizeof(CornerFileHeader);
+    while (m_file.size() - offset >= sizeof(CornerRecordHeader)) {
+        CornerRecordHeader header{};
+        std::memcpy(&header, m_file.data() + offset, sizeof(header));
+        const std::size_t bytes = pointBytes(header.format);
+        if (bytes == 0U || (m_file.size() - offset - sizeof(header)) / bytes < header.cornerCount) {
+            break;
+        }
+        m_records.push_back(offset);
+        offset += sizeof(header) + header.cornerCount * bytes;
+    }
+    m_complete = offset == m_file.size();
+    return true;
+}
+
+CornerFrameView CornerFileReader::frame(std::size_t index) const noexcept
+{
+    CornerRecordHeader header{};
+    const uint8_t* record = m_file.data() + m_records[index];
+    std::memcpy(&header, record, sizeof(header));
+
+    CornerFrameView view;
+    view.frameId = header.frameId;
+    view.width = static_cast<int>(header.width);
+    view.height = static_cast<int>(header.height);
+    view.format = static_cast<CornerFormat>(header.format);
+    view.cornerCount = header.cornerCount;
+    // Aligned, every structure of the file is a multiple of 4 bytes
+    if (view.format == CornerFormat::Int) {
+        view.intPoints = reinterpret_cast<const CornerPointInt*>(record + sizeof(header));
+    } else {
+        view.floatPoints = reinterpret_cast<const CornerPointFloat*>(record + sizeof(header));
+    }
+    return view;
+}
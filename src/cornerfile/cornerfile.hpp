@@ -0,0 +1,215 @@
+/// @file cornerfile.hpp
+/// @brief Append-only binary file of the corners detected in each frame
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#ifndef CORNERFILE_H
+#define CORNERFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "mappedfile.hpp"
+
+// Layout of a corner file, every field in the byte order of the writer, i.e.
+// little-endian on x86-64 and AArch64:
+//
+//   CornerFileHeader
+//   CornerRecordHeader, then cornerCount CornerPointInt or CornerPointFloat
+//   CornerRecordHeader, ...
+//
+// Records are only ever appended, and every structure is a multiple of 4
+// bytes, so the points of a mapped file are aligned and read in place. A
+// record cut short by a crash of the writer is ignored by the reader.
+
+// First bytes of a corner file
+constexpr char kCornerFileMagic[4] = {'C', 'R', 'N', 'F'};
+constexpr uint16_t kCornerFileVersion = 1;
+// Extension selecting the binary output in the app
+constexpr const char* kCornerFileExtension = ".crn";
+
+/// @brief True if @p path ends with kCornerFileExtension.
+bool hasCornerFileExtension(const std::string& path) noexcept;
+
+/// @brief Coordinates of the points of a record.
+enum class CornerFormat : uint16_t
+{
+  // Integer pixel coordinates, e.g. HarrisChessCornersDetector::m_cornersLocation
+  Int = 0,
+  // Sub-pixel coordinates, e.g. HarrisChessCornersDetector::m_cornersSubPixel
+  Float = 1,
+};
+
+struct CornerFileHeader
+{
+  char magic[4];
+  uint16_t version;
+  uint16_t reserved;
+};
+
+struct CornerRecordHeader
+{
+  uint64_t frameId;
+  uint32_t width;
+  uint32_t height;
+  uint32_t cornerCount;
+  uint16_t format;
+  uint16_t reserved;
+};
+
+struct CornerPointInt
+{
+  uint16_t x;
+  uint16_t y;
+  float response;
+};
+
+struct CornerPointFloat
+{
+  float x;
+  float y;
+  float response;
+};
+
+static_assert(sizeof(CornerFileHeader) == 8, "Unexpected padding in CornerFileHeader");
+static_assert(sizeof(CornerRecordHeader) == 24, "Unexpected padding in CornerRecordHeader");
+static_assert(sizeof(CornerPointInt) == 8, "Unexpected padding in CornerPointInt");
+static_assert(sizeof(CornerPointFloat) == 12, "Unexpected padding in CornerPointFloat");
+
+/// @brief Appends one record per frame to a corner file.
+///
+/// Records are serialised into a memory buffer, which is written to the file
+/// in a single call once it holds bufferBytes, so a stream of frames costs a
+/// write every few thousand frames rather than one per frame or per corner.
+/// Call flush() (or close()) to make the pending records visible to readers.
+class CornerFileWriter final
+{
+public:
+  /// @param bufferBytes Size of the write batches.
+  explicit CornerFileWriter(std::size_t bufferBytes = 1U << 20U);
+  // Non copyable, the file is owned.
+  CornerFileWriter(const CornerFileWriter&) = delete;
+  // Non copyable.
+  CornerFileWriter& operator=(const CornerFileWriter&) = delete;
+  // Writes the pending records.
+  ~CornerFileWriter();
+
+  /// @brief Opens @p path, appending to it if it is already a corner file.
+  /// @return False if the file cannot be opened, or exists and is not a
+  ///         complete corner file of this version.
+  bool open(const std::string& path);
+
+  /// @brief Appends the integer corners of a frame.
+  /// @param locations first = x, second = y, both in [0, 65535].
+  /// @param responses Response of each location, or empty to store zeros.
+  void write(
+    uint64_t frameId,
+    int width,
+    int height,
+    const std::vector<std::pair<int, int>>& locations,
+    const std::vector<float>& responses
+  );
+
+  /// @brief Appends the sub-pixel corners of a frame.
+  /// @param locations first = x, second = y.
+  /// @param responses Response of each location, or empty to store zeros.
+  void write(
+    uint64_t frameId,
+    int width,
+    int height,
+    const std::vector<std::pair<float, float>>& locations,
+    const std::vector<float>& responses
+  );
+
+  /// @brief Writes the pending records to the file.
+  /// @return False if the file is not open or a write failed.
+  bool flush();
+
+  /// @brief Flushes and closes the file.
+  /// @return False if a write failed.
+  bool close();
+
+private:
+  template <typename Point, typename Location>
+  void append(
+    uint64_t frameId,
+    int width,
+    int height,
+    CornerFormat format,
+    const std::vector<Location>& locations,
+    const std::vector<float>& responses
+  );
+
+  std::ofstream m_file;
+  std::vector<char> m_buffer;
+  std::size_t m_bufferBytes;
+};
+
+/// @brief Record of a mapped corner file, the points are read in place.
+struct CornerFrameView
+{
+  uint64_t frameId{0};
+  int width{0};
+  int height{0};
+  CornerFormat format{CornerFormat::Int};
+  std::size_t cornerCount{0};
+  // Points of the format, the other pointer is null
+  const CornerPointInt* intPoints{nullptr};
+  const CornerPointFloat* floatPoints{nullptr};
+
+  float x(std::size_t i) const noexcept { return intPoints != nullptr ? intPoints[i].x : floatPoints[i].x; }
+  float y(std::size_t i) const noexcept { return intPoints != nullptr ? intPoints[i].y : floatPoints[i].y; }
+  float response(std::size_t i) const noexcept
+  {
+    return intPoints != nullptr ? intPoints[i].response : floatPoints[i].response;
+  }
+};
+
+/// @brief Memory-mapped reader of a corner file, for the downstream tools.
+///        Opening only walks the record headers, the points are paged in
+///        from the disk when accessed.
+class CornerFileReader final
+{
+public:
+  // Default constructor, no file open.
+  CornerFileReader() = default;
+  // Non copyable, the mapping is owned.
+  CornerFileReader(const CornerFileReader&) = delete;
+  // Non copyable.
+  CornerFileReader& operator=(const CornerFileReader&) = delete;
+  // Default move constructor.
+  CornerFileReader(CornerFileReader&&) = default;
+  // Default move assignment operator.
+  CornerFileReader& operator=(CornerFileReader&&) = default;
+  // Default destructor.
+  ~CornerFileReader() = default;
+
+  /// @brief Maps @p path and indexes its records.
+  /// @return False if the file cannot be mapped or is not a corner file of
+  ///         this version.
+  bool open(const std::string& path);
+
+  /// @brief Number of complete records.
+  std::size_t frameCount() const noexcept { return m_records.size(); }
+
+  /// @brief False if the file ends with an incomplete record, e.g. the writer
+  ///        was interrupted.
+  bool complete() const noexcept { return m_complete; }
+
+  /// @brief Record @p index, in [0, frameCount()), in file order.
+  CornerFrameView frame(std::size_t index) const noexcept;
+
+private:
+  MappedFile m_file;
+  // Offset of each complete record header
+  std::vector<std::size_t> m_records;
+  bool m_complete{false};
+};
+
+#endif //CORNERFILE_H
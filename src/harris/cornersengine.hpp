@@ -0,0 +1,55 @@
+/// @file cornersengine.hpp
+/// @brief Common interface of the chessboard corner detection engines
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#ifndef CORNERSENGINE_H
+#define CORNERSENGINE_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "image.hpp"
+
+/// @brief Detector of chessboard corners over a whole frame, so that the
+///        application can pick the engine at run time. Each engine owns its
+///        parameters and buffers, and is reused from frame to frame.
+class ChessCornersEngine
+{
+public:
+  // Virtual destructor, engines are owned through the interface.
+  virtual ~ChessCornersEngine() = default;
+
+  /// @brief Short name of the engine, as given on the command line.
+  virtual const char* name() const noexcept = 0;
+
+  /// @brief Number of threads of detect(), the caller included.
+  virtual void setParallelism(const int threadCount) = 0;
+
+  /// @brief Detects the corners of @p image, replacing the previous ones.
+  virtual void detect(const ImageView<const uint8_t>& image) noexcept = 0;
+
+  /// @brief Corners of the last detect() call, first = x, second = y, in
+  ///        row-major order.
+  virtual const std::vector<std::pair<int, int>>& cornersLocation() const noexcept = 0;
+
+  /// @brief Response of each entry of cornersLocation(), in the engine units.
+  virtual const std::vector<float>& cornersResponse() const noexcept = 0;
+
+protected:
+  // Default constructor.
+  ChessCornersEngine() = default;
+  // Default copy constructor, protected to prevent slicing.
+  ChessCornersEngine(const ChessCornersEngine&) = default;
+  // Default copy assignment operator, protected to prevent slicing.
+  ChessCornersEngine& operator=(const ChessCornersEngine&) = default;
+  // Default move constructor, protected to prevent slicing.
+  ChessCornersEngine(ChessCornersEngine&&) = default;
+  // Default move assignment operator, protected to prevent slicing.
+  ChessCornersEngine& operator=(ChessCornersEngine&&) = default;
+};
+
+#endif //CORNERSENGINE_H
@@ -0,0 +1,90 @@
+/// @file harrisbatch.cpp
+/// @brief source file for harrisbatch
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#include "harrisbatch.hpp"
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+std::size_t peakResidentBytes() noexcept
+{
+#if defined(__unix__) || defined(__APPLE__)
+    struct rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0U;
+    }
+#if defined(__APPLE__)
+    // Bytes on macOS
+    return static_cast<std::size_t>(usage.ru_maxrss);
+#else
+    // Kilobytes on Linux
+    return static_cast<std::size_t>(usage.ru_maxrss) * 1024U;
+#endif
+#else
+    return 0U;
+#endif
+}
+
+} // namespace
+
+HarrisBatchDetector::HarrisBatchDetector(const int threadCount, const HarrisParameters& params)
+    : m_params(params),
+      m_threadPool(std::make_shared<harris::ThreadPool>(threadCount)),
+      m_detectors(m_threadPool->threadCount())
+{
+}
+
+void HarrisBatchDetector::detectBatch(const ImageView<const uint8_t>* images, const std::size_t count) noexcept
+{
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+
+    // Largest images first, so that the batch does not end on a single large
+    // image while the other workers are idle
+    m_order.resize(count);
+    std::iota(m_order.begin(), m_order.end(), std::size_t{0});
+    auto pixels = [images](std::size_t index) {
+        return static_cast<std::size_t>(images[index].width()) * static_cast<std::size_t>(images[index].height());
+    };
+    std::stable_sort(m_order.begin(), m_order.end(), [&pixels](std::size_t lhs, std::size_t rhs) {
+        return pixels(lhs) > pixels(rhs);
+    });
+
+    // Every worker sized for the widest image, whichever images it gets
+    int width = 0;
+    for (std::size_t image = 0; image < count; ++image) {
+        width = std::max(width, images[image].width());
+    }
+    for (auto& detector : m_detectors) {
+        detector.reserve(width, m_params);
+    }
+
+    m_results.resize(count);
+    m_threadPool->parallelFor(static_cast<int>(count), [&](int index, int worker) {
+        const std::size_t image = m_order[index];
+        HarrisChessCornersDetector& detector = m_detectors[worker];
+        detector.detect(images[image], m_params);
+        // Assigning keeps the capacity of the previous batch results
+        m_results[image].cornersLocation.assign(detector.m_cornersLocation.begin(), detector.m_cornersLocation.end());
+        m_results[image].cornersResponse.assign(detector.m_cornersResponse.begin(), detector.m_cornersResponse.end());
+    });
+
+    m_report = HarrisBatchReport{};
+    m_report.images = count;
+    for (std::size_t image = 0; image < count; ++image) {
+        m_report.pixels += pixels(image);
+        m_report.corners += m_results[image].cornersLocation.size();
+    }
+    m_report.elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    m_report.peakResidentBytes = peakResidentBytes();
+}
@@ -0,0 +1,104 @@
+/// @file harrisbatch.hpp
+/// @brief Detection of the corners of many independent images in parallel
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#ifndef HARRISBATCH_H
+#define HARRISBATCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "harrisdetector.hpp"
+#include "harristypes.hpp"
+#include "image.hpp"
+#include "threadpool.hpp"
+
+/// @brief Corners of one image of a batch, as HarrisChessCornersDetector
+///        reports them.
+struct HarrisBatchResult
+{
+  // Corner locations, first = x, second = y, in row-major order.
+  std::vector<std::pair<int, int>> cornersLocation;
+  // Response of each entry of cornersLocation.
+  std::vector<float> cornersResponse;
+};
+
+/// @brief Statistics of a detectBatch() call.
+struct HarrisBatchReport
+{
+  std::size_t images{0};
+  std::size_t pixels{0};
+  std::size_t corners{0};
+  // Wall time of the whole batch
+  double elapsedMs{0.0};
+  // Peak resident memory of the process so far, images included, 0 where the
+  // platform does not report it
+  std::size_t peakResidentBytes{0};
+
+  double imagesPerSecond() const noexcept { return elapsedMs > 0.0 ? 1000.0 * static_cast<double>(images) / elapsedMs : 0.0; }
+  double megapixelsPerSecond() const noexcept { return elapsedMs > 0.0 ? 1e-3 * static_cast<double>(pixels) / elapsedMs : 0.0; }
+};
+
+/// @brief Runs HarrisChessCornersDetector::detect() over batches of stills,
+///        e.g. the images of a calibration session, one image per thread.
+///
+/// Every worker thread owns a detector whose buffers are reused from image to
+/// image and from batch to batch. Images are handed to the next idle worker,
+/// largest first, so a few large images do not end up last on one thread.
+/// Before each batch every detector is sized for its widest image, so
+/// whichever worker an image goes to, a batch mixing resolutions only
+/// allocates if it holds an image wider than any of the previous batches.
+class HarrisBatchDetector final
+{
+public:
+  /// @param threadCount Number of threads, the caller included.
+  /// @param params      Detection parameters of every image.
+  explicit HarrisBatchDetector(const int threadCount, const HarrisParameters& params = HarrisParameters{});
+  // Default copy constructor.
+  HarrisBatchDetector(const HarrisBatchDetector&) = default;
+  // Default copy assignment operator.
+  HarrisBatchDetector& operator=(const HarrisBatchDetector&) = default;
+  // Default move constructor.
+  HarrisBatchDetector(HarrisBatchDetector&&) = default;
+  // Default move assignment operator.
+  HarrisBatchDetector& operator=(HarrisBatchDetector&&) = default;
+  // Default destructor.
+  ~HarrisBatchDetector() = default;
+
+  /// @brief Detects the corners of every image. Results and report of the
+  ///        previous batch are replaced.
+  /// @param images Grayscale images, any mix of resolutions.
+  /// @param count  Number of images.
+  void detectBatch(const ImageView<const uint8_t>* images, const std::size_t count) noexcept;
+
+  /// @brief Same as above for a vector of images.
+  void detectBatch(const std::vector<ImageView<const uint8_t>>& images) noexcept
+  {
+    detectBatch(images.data(), images.size());
+  }
+
+  /// @brief Corners of each image of the last batch, in input order.
+  const std::vector<HarrisBatchResult>& results() const noexcept { return m_results; }
+
+  /// @brief Statistics of the last batch.
+  const HarrisBatchReport& report() const noexcept { return m_report; }
+
+private:
+  HarrisParameters m_params;
+  // Workers, shared by the copies of the batch detector
+  std::shared_ptr<harris::ThreadPool> m_threadPool;
+  // One detector per worker thread
+  std::vector<HarrisChessCornersDetector> m_detectors;
+  // Image indices, largest image first
+  std::vector<std::size_t> m_order;
+  std::vector<HarrisBatchResult> m_results;
+  HarrisBatchReport m_report;
+};
+
+#endif //HARRISBATCH_H
@@ -8,71 +8,458 @@
 /// @date 05-2024
 
 #include "harrisdetector.hpp"
+#include <algorithm>
 #include <cmath>
+#include <cstdlib>
 #include <limits>
 
+void
+HarrisChessCornersDetector::detect(
+    const ImageView<const uint8_t> &image,
+    const HarrisParameters &params
+    ) noexcept
+{
+    HARRIS_STATS(m_stats = HarrisFrameStats{});
+    HARRIS_STAGE_TIMER(m_stats.stage(HarrisStage::Fused));
+
+    if (params.pyramidLevels > 0) {
+        detectPyramid(image, params);
+    } else {
+        detectFullFrame(image, params);
+    }
+    storeCorners(params);
+}
+
+void
+HarrisChessCornersDetector::track(
+    const ImageView<const uint8_t> &image,
+    const HarrisParameters &params
+    ) noexcept
+{
+    m_lastFrameTracked = false;
+    if (m_keyframeCorners > 0 && m_framesSinceKeyframe + 1 < params.keyframeInterval) {
+        HARRIS_STATS(m_stats = HarrisFrameStats{});
+        HARRIS_STAGE_TIMER(m_stats.stage(HarrisStage::Fused));
+
+        // 1.) Search each corner of the previous frame around its location
+        //     moved by the motion of that frame
+        const int offset = std::max(params.trackingSearchOffset, 0);
+        const int motionX = static_cast<int>(std::lround(m_trackingMotionX));
+        const int motionY = static_cast<int>(std::lround(m_trackingMotionY));
+        m_searchWindows.clear();
+        for (const auto& corner : m_cornersLocation) {
+            m_searchWindows.push_back(ImageRect{
+                corner.first + motionX - offset, corner.second + motionY - offset, 2 * offset + 1, 2 * offset + 1
+            });
+        }
+        detectInWindows(image, params);
+        // Not below the keyframe threshold, so that windows left by their
+        // corner do not report weak texture maxima instead
+        thresholdOnStrongest(params, m_keyframeMaxResponse);
+
+        // 2.) Keep the tracked corners unless too many of them were lost,
+        //     e.g. occluded, out of the frame or faster than the window
+        const float minCorners = params.trackingMinRatio * static_cast<float>(m_keyframeCorners);
+        m_lastFrameTracked = !m_nmsCorners.empty() && static_cast<float>(m_nmsCorners.size()) >= minCorners;
+        if (m_lastFrameTracked) {
+            m_trackingMotionX = static_cast<float>(motionX) + m_windowShiftX;
+            m_trackingMotionY = static_cast<float>(motionY) + m_windowShiftY;
+            ++m_framesSinceKeyframe;
+            storeCorners(params);
+            return;
+        }
+    }
+
+    // Keyframe
+    detect(image, params);
+    // Counted as the tracked frames, so that a still board keeps being tracked
+    m_keyframeCorners = countWindowCorners(std::max(params.trackingSearchOffset, 0));
+    m_keyframeMaxResponse = m_maxResponse;
+    m_framesSinceKeyframe = 0;
+    m_trackingMotionX = 0.0F;
+    m_trackingMotionY = 0.0F;
+}
+
+void
+HarrisChessCornersDetector::resetTracking() noexcept
+{
+    m_keyframeCorners = 0;
+    m_keyframeMaxResponse = 0.0F;
+    m_framesSinceKeyframe = 0;
+    m_trackingMotionX = 0.0F;
+    m_trackingMotionY = 0.0F;
+    m_lastFrameTracked = false;
+}
+
+void
+HarrisChessCornersDetector::storeCorners(const HarrisParameters &params) noexcept
+{
+    harris::keepStrongest(m_nmsCorners, params.maxCorners, m_strongestHeap);
+
+    m_cornersLocation.clear();
+    m_cornersResponse.clear();
+    for (const auto& corner : m_nmsCorners) {
+        m_cornersLocation.push_back(std::pair<int, int>(corner.x, corner.y));
+        m_cornersResponse.push_back(corner.response);
+    }
+    HARRIS_STATS(m_stats.corners = m_nmsCorners.size());
+}
+
+void
+HarrisChessCornersDetector::detectFullFrame(
+    const ImageView<const uint8_t> &image,
+    const HarrisParameters &params
+    ) noexcept
+{
+    const int height = image.height();
+    const int width = image.width();
+    const int threadCount = m_threadPool ? m_threadPool->threadCount() : 1;
+    const auto detectRegion = harris::selectDetectRegion<harris::DefaultPrecision>(params);
+
+    if (threadCount == 1) {
+        m_regionResults.resize(1);
+        detectRegion(image, ImageRect{0, 0, width, height}, params, m_pipelineWorkspaces[0], m_regionResults[0]);
+    } else {
+        // A few bands per thread to balance the load
+        const int bandHeight = m_bandHeight > 0
+            ? m_bandHeight
+            : std::max(16, (height + 4 * threadCount - 1) / (4 * threadCount));
+        const int bandCount = (height + bandHeight - 1) / bandHeight;
+        m_regionResults.resize(bandCount);
+        m_pipelineWorkspaces.resize(threadCount);
+        m_threadPool->parallelFor(bandCount, [&](int band, int worker) {
+            const ImageRect region{0, band * bandHeight, width, bandHeight};
+            detectRegion(image, region, params, m_pipelineWorkspaces[worker], m_regionResults[band]);
+        });
+    }
+
+    // Merge the bands top to bottom, i.e. in row-major order as a serial run
+    m_maxResponse = 0.0F;
+    m_maxResponseLocation = std::pair<int, int>(-1, -1);
+    for (const auto& band : m_regionResults) {
+        if (band.maxResponse > m_maxResponse) {
+            m_maxResponse = band.maxResponse;
+            m_maxResponseLocation = std::pair<int, int>(band.maxX, band.maxY);
+        }
+    }
+
+    // Keep the local maxima above the threshold of the frame, or of their tile
+    mergeTileMaxima(width, height, params);
+    m_nmsCorners.clear();
+    for (const auto& band : m_regionResults) {
+        for (const auto& candidate : band.candidates) {
+            if (candidate.response > cornerThreshold(candidate, params, m_maxResponse)) {
+                m_nmsCorners.push_back(candidate);
+            }
+        }
+    }
+    // The image is read once, only the local maxima are written and read back
+    HARRIS_STATS(
+        for (const auto& band : m_regionResults) {
+            m_stats.thresholdInput += band.candidates.size();
+        }
+        m_stats.suppressionInput = static_cast<std::size_t>(width) * height;
+        m_stats.suppressionOutput = m_stats.thresholdInput;
+        m_stats.thresholdOutput = m_nmsCorners.size();
+        m_stats.stage(HarrisStage::Fused).bytesTouched += static_cast<std::size_t>(width) * height
+            + 2 * sizeof(HarrisCandidate) * (m_stats.thresholdInput + m_stats.thresholdOutput)
+    );
+}
+
+void
+HarrisChessCornersDetector::detectPyramid(
+    const ImageView<const uint8_t> &image,
+    const HarrisParameters &params
+    ) noexcept
+{
+    // 1.) Halve the resolution while the level is large enough to hold the
+    //     filter windows of a few corners
+    constexpr int kMinLevelSize = 32;
+    if (m_pyramid.size() < static_cast<std::size_t>(params.pyramidLevels)) {
+        m_pyramid.resize(params.pyramidLevels);
+    }
+    ImageView<const uint8_t> coarse = image;
+    int levels = 0;
+    while (levels < params.pyramidLevels && coarse.width() / 2 >= kMinLevelSize && coarse.height() / 2 >= kMinLevelSize) {
+        Image<uint8_t>& level = m_pyramid[levels];
+        level.reshape(coarse.width() / 2, coarse.height() / 2);
+        harris::downsampleHalf(coarse, level);
+        coarse = level;
+        ++levels;
+    }
+
+    // 2.) Whole frame detection at the coarsest level, its threshold tiles
+    //     covering the same area as at full resolution
+    HarrisParameters coarseParams = params;
+    if (params.thresholdTileSize > 0) {
+        coarseParams.thresholdTileSize = std::max(params.thresholdTileSize >> levels, 1);
+    }
+    detectFullFrame(coarse, coarseParams);
+
+    // 3.) Relocate every corner at each finer level, in a small window around
+    //     the 2x2 block it projects to
+    const int offset = std::max(params.pyramidSearchOffset, 0);
+    for (int level = levels - 1; level >= 0; --level) {
+        const ImageView<const uint8_t> fine = level == 0 ? image : ImageView<const uint8_t>(m_pyramid[level - 1]);
+        m_searchWindows.clear();
+        for (const auto& candidate : m_nmsCorners) {
+            m_searchWindows.push_back(ImageRect{2 * candidate.x - offset, 2 * candidate.y - offset, 2 * offset + 2, 2 * offset + 2});
+        }
+        detectInWindows(fine, params);
+    }
+
+    // 4.) The full resolution maximum is unknown, the threshold is relative to
+    //     the strongest relocated corner instead
+    if (levels > 0) {
+        thresholdOnStrongest(params);
+    }
+}
+
+void
+HarrisChessCornersDetector::detectInWindows(
+    const ImageView<const uint8_t> &image,
+    const HarrisParameters &params
+    ) noexcept
+{
+    const int count = static_cast<int>(m_searchWindows.size());
+    m_regionResults.resize(count);
+    const auto detectRegion = harris::selectDetectRegion<harris::DefaultPrecision>(params);
+    auto search = [&](int index, int worker) {
+        detectRegion(image, m_searchWindows[index], params, m_pipelineWorkspaces[worker], m_regionResults[index]);
+    };
+    if (m_threadPool && count > 1) {
+        m_pipelineWorkspaces.resize(m_threadPool->threadCount());
+        m_threadPool->parallelFor(count, search);
+    } else {
+        for (int index = 0; index < count; ++index) {
+            search(index, 0);
+        }
+    }
+
+    // Strongest local maximum of each window, the first one on ties
+    m_nmsCorners.clear();
+    float shiftX = 0.0F;
+    float shiftY = 0.0F;
+    for (int index = 0; index < count; ++index) {
+        const HarrisCandidate* strongest = nullptr;
+        for (const auto& candidate : m_regionResults[index].candidates) {
+            if (strongest == nullptr || candidate.response > strongest->response) {
+                strongest = &candidate;
+            }
+        }
+        if (strongest != nullptr) {
+            m_nmsCorners.push_back(*strongest);
+            const ImageRect& window = m_searchWindows[index];
+            shiftX += static_cast<float>(strongest->x) - (static_cast<float>(window.x) + 0.5F * static_cast<float>(window.width - 1));
+            shiftY += static_cast<float>(strongest->y) - (static_cast<float>(window.y) + 0.5F * static_cast<float>(window.height - 1));
+        }
+    }
+    const float found = static_cast<float>(std::max<std::size_t>(m_nmsCorners.size(), 1));
+    m_windowShiftX = shiftX / found;
+    m_windowShiftY = shiftY / found;
+    mergeTileMaxima(image.width(), image.height(), params);
+    // Back to row-major order, without the corners found by several windows
+    std::sort(m_nmsCorners.begin(), m_nmsCorners.end(), [](const HarrisCandidate& lhs, const HarrisCandidate& rhs) {
+        return lhs.y != rhs.y ? lhs.y < rhs.y : lhs.x < rhs.x;
+    });
+    m_nmsCorners.erase(
+        std::unique(m_nmsCorners.begin(), m_nmsCorners.end(), [](const HarrisCandidate& lhs, const HarrisCandidate& rhs) {
+            return lhs.x == rhs.x && lhs.y == rhs.y;
+        }),
+        m_nmsCorners.end()
+        );
+    // Windows, halo included, read from the image
+    HARRIS_STATS(
+        const int halo = 2 * (params.windowOffset + params.nmsWindowOffset + 1);
+        for (const auto& window : m_searchWindows) {
+            m_stats.stage(HarrisStage::Fused).bytesTouched += static_cast<std::size_t>(window.width + halo) * (window.height + halo);
+        }
+    );
+}
+
+std::size_t
+HarrisChessCornersDetector::countWindowCorners(const int offset) noexcept
+{
+    // m_nmsCorners is in row-major order, so the corners of a window are
+    // found from the first one of its top row
+    m_windowPicks.clear();
+    for (const auto& corner : m_nmsCorners) {
+        auto first = std::lower_bound(m_nmsCorners.begin(), m_nmsCorners.end(), corner.y - offset,
+            [](const HarrisCandidate& lhs, int y) { return lhs.y < y; });
+        int strongest = -1;
+        for (auto other = first; other != m_nmsCorners.end() && other->y <= corner.y + offset; ++other) {
+            if (std::abs(other->x - corner.x) <= offset
+                && (strongest < 0 || other->response > m_nmsCorners[strongest].response)) {
+                strongest = static_cast<int>(other - m_nmsCorners.begin());
+            }
+        }
+        m_windowPicks.push_back(strongest);
+    }
+    std::sort(m_windowPicks.begin(), m_windowPicks.end());
+    return static_cast<std::size_t>(std::unique(m_windowPicks.begin(), m_windowPicks.end()) - m_windowPicks.begin());
+}
+
+void
+HarrisChessCornersDetector::thresholdOnStrongest(const HarrisParameters &params, const float minReference) noexcept
+{
+    m_maxResponse = 0.0F;
+    m_maxResponseLocation = std::pair<int, int>(-1, -1);
+    for (const auto& corner : m_nmsCorners) {
+        if (corner.response > m_maxResponse) {
+            m_maxResponse = corner.response;
+            m_maxResponseLocation = std::pair<int, int>(corner.x, corner.y);
+        }
+    }
+    const float reference = std::max(m_maxResponse, minReference);
+    m_nmsCorners.erase(
+        std::remove_if(m_nmsCorners.begin(), m_nmsCorners.end(), [&](const HarrisCandidate& corner) {
+            return !(corner.response > cornerThreshold(corner, params, reference));
+        }),
+        m_nmsCorners.end()
+        );
+}
+
+void
+HarrisChessCornersDetector::mergeTileMaxima(const int width, const int height, const HarrisParameters &params) noexcept
+{
+    const int tileSize = params.thresholdTileSize;
+    if (tileSize <= 0) {
+        return;
+    }
+    m_tileColumns = (width + tileSize - 1) / tileSize;
+    const int tileRows = (height + tileSize - 1) / tileSize;
+    m_tileMax.assign(static_cast<std::size_t>(m_tileColumns) * tileRows, 0.0F);
+    for (const auto& region : m_regionResults) {
+        float* tileMax = m_tileMax.data() + static_cast<std::size_t>(region.tileRowBegin) * m_tileColumns;
+        for (std::size_t i = 0; i < region.tileMax.size(); ++i) {
+            tileMax[i] = std::max(tileMax[i], region.tileMax[i]);
+        }
+    }
+}
+
+float
+HarrisChessCornersDetector::cornerThreshold(
+    const HarrisCandidate &corner,
+    const HarrisParameters &params,
+    const float frameMax
+    ) const noexcept
+{
+    const int tileSize = params.thresholdTileSize;
+    if (tileSize <= 0) {
+        return params.thresholdPercent * frameMax;
+    }
+    const std::size_t tile = static_cast<std::size_t>(corner.y / tileSize) * m_tileColumns + corner.x / tileSize;
+    return harris::tileThreshold(params, m_tileMax[tile], frameMax);
+}
+
+void
+HarrisChessCornersDetector::setParallelism(const int threadCount, const int bandHeight)
+{
+    m_bandHeight = bandHeight;
+    if (threadCount <= 1) {
+        m_threadPool.reset();
+    } else if (!m_threadPool || m_threadPool->threadCount() != threadCount) {
+        m_threadPool = std::make_shared<harris::ThreadPool>(threadCount);
+    }
+}
+
+void
+HarrisChessCornersDetector::reserve(const int width, const HarrisParameters &params)
+{
+    if (m_threadPool) {
+        m_pipelineWorkspaces.resize(m_threadPool->threadCount());
+    }
+    for (auto& workspace : m_pipelineWorkspaces) {
+        harris::reserveWorkspace(workspace, width, params);
+    }
+}
+
 void
 HarrisChessCornersDetector::computeGradients(
-    const std::vector<std::vector<uint8_t>> &image
+    const ImageView<const uint8_t> &image
     ) noexcept
 {
-    int height = image.size();
-    int width = image[0].size();
-    // Initialize vectors
-    m_gradientX.resize(height);
-    for (auto& row : m_gradientX) {
-        row.resize(width, 0.0F);
-    }
-    m_gradientY.resize(height);
-    for (auto& row : m_gradientY) {
-        row.resize(width, 0.0F);
-    }
-    m_gradientMag.resize(height);
-    for (auto& row : m_gradientMag) {
-        row.resize(width, 0.0F);
-    }
-    m_gradientOri.resize(height);
-    for (auto& row : m_gradientOri) {
-        row.resize(width, 0.0F);
-    }
-
-    // Sobel operator kernels to derive the image on each direction
-    std::vector<std::vector<int>> sobelX = {
-        {-1, 0, 1},
-        {-2, 0, 2},
-        {-1, 0, 1}
-        };
-    std::vector<std::vector<int>> sobelY = {
-        {-1, -2, -1},
-        { 0,  0,  0},
-        { 1,  2,  1}
-        };
-
-    // Apply the Sobel operator
+    HARRIS_STATS(m_stats = HarrisFrameStats{});
+    HARRIS_STAGE_TIMER(m_stats.stage(HarrisStage::Gradients));
+    int height = image.height();
+    int width = image.width();
+    // Image read, X/Y planes written
+    HARRIS_STATS(m_stats.stage(HarrisStage::Gradients).bytesTouched += 9 * static_cast<std::size_t>(width) * height);
+    // Initialize planes, the interior is overwritten below and the border
+    // stays zero, so they are only reset when the resolution changes
+    m_gradientX.reshape(width, height);
+    m_gradientY.reshape(width, height);
+    // Magnitude and orientation are derived on request only
+    m_gradientMagValid = false;
+    m_gradientOriValid = false;
+
+    m_workspace.sobelScratch.resize(2 * width);
+
+    // Apply the separable Sobel operator
+    for (int y = 1; y < height - 1; ++y) {
+        harris::sobelRow(image, y, 1, width - 1, m_gradientX.row(y), m_gradientY.row(y), m_workspace.sobelScratch.data());
+    }
+}
+
+const Image<float>&
+HarrisChessCornersDetector::gradientMagnitude() noexcept
+{
+    if (m_gradientMagValid) {
+        return m_gradientMag;
+    }
+    const int height = m_gradientX.height();
+    const int width = m_gradientX.width();
+    // X/Y planes read, magnitude written, timed by the calling stage if any
+    HARRIS_STATS(m_stats.stage(HarrisStage::Gradients).bytesTouched += 12 * static_cast<std::size_t>(width) * height);
+    m_gradientMag.reshape(width, height);
+    for (int y = 1; y < height - 1 && width > 2; ++y) {
+        harris::gradientMagnitude(m_gradientX.row(y) + 1, m_gradientY.row(y) + 1, m_gradientMag.row(y) + 1, width - 2);
+    }
+    m_gradientMagValid = true;
+    return m_gradientMag;
+}
+
+const Image<float>&
+HarrisChessCornersDetector::gradientOrientation() noexcept
+{
+    if (m_gradientOriValid) {
+        return m_gradientOri;
+    }
+    const int height = m_gradientX.height();
+    const int width = m_gradientX.width();
+    // X/Y planes read, orientation written, timed by the calling stage if any
+    HARRIS_STATS(m_stats.stage(HarrisStage::Gradients).bytesTouched += 12 * static_cast<std::size_t>(width) * height);
+    m_gradientOri.reshape(width, height);
     for (int y = 1; y < height - 1; ++y) {
+        const float* gradX = m_gradientX.row(y);
+        const float* gradY = m_gradientY.row(y);
+        float* gradOri = m_gradientOri.row(y);
         for (int x = 1; x < width - 1; ++x) {
-            float sumX = 0.0F;
-            float sumY = 0.0F;
-            for (int j = -1; j <= 1; ++j) {
-                for (int i = -1; i <= 1; ++i) {
-                    sumX += image[y + j][x + i] * sobelX[j + 1][i + 1];
-                    sumY += image[y + j][x + i] * sobelY[j + 1][i + 1];
-                }
-            }
-            // Calculate the gradient magnitude
-            m_gradientX[y][x] = sumX;
-            m_gradientY[y][x] = sumY;
-            m_gradientMag[y][x] = std::sqrt(sumX * sumX + sumY * sumY);
+            const float sumX = gradX[x];
+            const float sumY = gradY[x];
             if (sumX != 0.0f)
             {
-              m_gradientOri[y][x] = std::atan(sumY / sumX);
+              gradOri[x] = std::atan(sumY / sumX);
             }
             else
             {
-              m_gradientOri[y][x] = std::atan(sumY / std::numeric_limits<float>::min());
+              gradOri[x] = std::atan(sumY / std::numeric_limits<float>::min());
             }
         }
     }
+    m_gradientOriValid = true;
+    return m_gradientOri;
+}
+
+void
+HarrisChessCornersDetector::computeGradients(
+    const uint8_t* data,
+    int rows,
+    int cols,
+    std::size_t step
+    ) noexcept
+{
+    computeGradients(ImageView<const uint8_t>(data, cols, rows, static_cast<std::ptrdiff_t>(step)));
 }
 
 void
@@ -81,37 +468,51 @@ HarrisChessCornersDetector::cornerResponse_method1(
     const float k
     ) noexcept
 {
-    int height = m_gradientMag.size();
-    int width = m_gradientMag[0].size();
-    m_cornerResponseMap.resize(height);
-    for (auto& row : m_cornerResponseMap) {
-        row.resize(width, 0.0F);
-    }
+    HARRIS_STAGE_TIMER(m_stats.stage(HarrisStage::Response));
+    const Image<float>& gradientMag = gradientMagnitude();
+    const Image<float>& gradientOri = gradientOrientation();
+    int height = gradientMag.height();
+    int width = gradientMag.width();
+    // Magnitude/orientation read, M written, both smoothed in two passes,
+    // smoothed planes read and response written
+    HARRIS_STATS(m_stats.stage(HarrisStage::Response).bytesTouched += 56 * static_cast<std::size_t>(width) * height);
+    m_cornerResponseMap.reshape(width, height);
+    m_maxResponse = 0.0F;
+    m_maxResponseLocation = std::pair<int, int>(-1, -1);
 
     // Calculate the second-moment matrix
-    std::vector<std::vector<float>> M(height, std::vector<float>(width, 0.0F));
+    Image<float>& M = m_workspace.secondMoment;
+    M.reshape(width, height);
     for (int y = 1; y < height - 1; ++y) {
+        const float* gradMag = gradientMag.row(y);
+        const float* gradOri = gradientOri.row(y);
+        float* mRow = M.row(y);
         for (int x = 1; x < width - 1; ++x) {
-            float dx = m_gradientMag[y][x] * std::cos(m_gradientOri[y][x]);
-            float dy = m_gradientMag[y][x] * std::sin(m_gradientOri[y][x]);
-            M[y][x] = dx * dy;
+            float dx = gradMag[x] * std::cos(gradOri[x]);
+            float dy = gradMag[x] * std::sin(gradOri[x]);
+            mRow[x] = dx * dy;
         }
     }
 
     // Apply Gaussian smoothing to the gradient magnitude
-    std::vector<std::vector<float>> smoothedMagnitude = applyGaussianSmoothing(m_gradientMag, sigma);
+    Image<float>& smoothedMagnitude = m_workspace.smoothedMagnitude;
+    applyGaussianSmoothing(gradientMag, sigma, smoothedMagnitude);
     // Apply Gaussian smoothing to the second-moment matrix
-    std::vector<std::vector<float>> smoothedM = applyGaussianSmoothing(M, sigma);
+    Image<float>& smoothedM = m_workspace.smoothedSecondMoment;
+    applyGaussianSmoothing(M, sigma, smoothedM);
 
     // Calculate the Harris Corner Detector response
     // Save max response value a location to be used later
     for (int y = 1; y < height - 1; ++y) {
+        const float* smoothedMagRow = smoothedMagnitude.row(y);
+        const float* smoothedMRow = smoothedM.row(y);
+        float* response = m_cornerResponseMap.row(y);
         for (int x = 1; x < width - 1; ++x) {
-            float det = smoothedM[y][x] - smoothedMagnitude[y][x];
-            float trace = smoothedMagnitude[y][x] + smoothedMagnitude[y][x];
-            m_cornerResponseMap[y][x] = det - k * (trace * trace);
-            if (m_cornerResponseMap[y][x] > m_maxResponse) {
-                m_maxResponse = m_cornerResponseMap[y][x];
+            float det = smoothedMRow[x] - smoothedMagRow[x];
+            float trace = smoothedMagRow[x] + smoothedMagRow[x];
+            response[x] = det - k * (trace * trace);
+            if (response[x] > m_maxResponse) {
+                m_maxResponse = response[x];
                 m_maxResponseLocation.first = x;
                 m_maxResponseLocation.second = y;
             }
@@ -119,130 +520,255 @@ HarrisChessCornersDetector::cornerResponse_method1(
     }
 }
 
-void HarrisChessCornersDetector::cornerResponse_method2(const float sigma, const float k, const int windowOffset) noexcept
+void HarrisChessCornersDetector::cornerResponse_method2(
+    const float sigma,
+    const float k,
+    const int windowOffset,
+    const TensorWeighting weighting
+    ) noexcept
 {
-    int height = m_gradientMag.size();
-    int width = m_gradientMag[0].size();
-    m_cornerResponseMap.resize(height);
-    for (auto& row : m_cornerResponseMap) {
-        row.resize(width, 0.0F);
+    HARRIS_STAGE_TIMER(m_stats.stage(HarrisStage::Response));
+    int height = m_gradientX.height();
+    int width = m_gradientX.width();
+    // X/Y planes read, products written and read back, response written
+    HARRIS_STATS(m_stats.stage(HarrisStage::Response).bytesTouched += 36 * static_cast<std::size_t>(width) * height);
+    m_cornerResponseMap.reshape(width, height);
+    m_maxResponse = 0.0F;
+    m_maxResponseLocation = std::pair<int, int>(-1, -1);
+    if (width < 3 || height < 3) {
+        return;
     }
 
     // Compute the product of derivatives
-    std::vector<std::vector<float>> dxdx(m_gradientMag.size(), std::vector<float>(m_gradientMag[0].size(), 0.0F));
-    std::vector<std::vector<float>> dydy(m_gradientMag.size(), std::vector<float>(m_gradientMag[0].size(), 0.0F));
-    std::vector<std::vector<float>> dxdy(m_gradientMag.size(), std::vector<float>(m_gradientMag[0].size(), 0.0F));
+    Image<float>& dxdx = m_workspace.products[0];
+    Image<float>& dxdy = m_workspace.products[1];
+    Image<float>& dydy = m_workspace.products[2];
+    for (auto& product : m_workspace.products) {
+        product.reshape(width, height);
+    }
     for (int y = 1; y < height - 1; ++y) {
+        const float* gradX = m_gradientX.row(y);
+        const float* gradY = m_gradientY.row(y);
+        float* dxdxRow = dxdx.row(y);
+        float* dxdyRow = dxdy.row(y);
+        float* dydyRow = dydy.row(y);
         for (int x = 1; x < width - 1; ++x) {
-            dxdx[y][x] = m_gradientX[y][x] * m_gradientX[y][x];
-            dxdy[y][x] = m_gradientX[y][x] * m_gradientY[y][x];
-            dydy[y][x] = m_gradientY[y][x] * m_gradientY[y][x];
+            dxdxRow[x] = gradX[x] * gradX[x];
+            dxdyRow[x] = gradX[x] * gradY[x];
+            dydyRow[x] = gradY[x] * gradY[x];
         }
     }
-    // Optional gaussian here
-    for (int y = 1; y < height - 1; ++y) {
+
+    // Sum the products over the window around each pixel
+    const harris::GaussianKernel* kernel = nullptr;
+    if (weighting == TensorWeighting::Gaussian) {
+        if (m_workspace.gaussianKernel.taps.empty() || m_workspace.gaussianKernel.sigma != sigma) {
+            m_workspace.gaussianKernel = harris::makeGaussianKernel(sigma);
+        }
+        kernel = &m_workspace.gaussianKernel;
+    }
+    harris::TensorAccumulator& accumulator = m_workspace.tensorAccumulator;
+    accumulator.reset(width, 1, width - 1, windowOffset, kernel);
+    const int radius = accumulator.radius();
+    for (auto& sum : m_workspace.sums) {
+        sum.resize(width);
+    }
+    float* sumDxdx = m_workspace.sums[0].data();
+    float* sumDxdy = m_workspace.sums[1].data();
+    float* sumDydy = m_workspace.sums[2].data();
+    for (int y = 1 - radius; y < height - 1 + radius; ++y) {
+        const bool interior = y >= 1 && y < height - 1;
+        accumulator.pushRow(
+            interior ? dxdx.row(y) : nullptr,
+            interior ? dxdy.row(y) : nullptr,
+            interior ? dydy.row(y) : nullptr
+            );
+        if (!accumulator.ready()) continue;
+
+        // Window around row y - radius is complete
+        accumulator.windowSums(sumDxdx, sumDxdy, sumDydy);
+        float* response = m_cornerResponseMap.row(y - radius);
+        harris::harrisResponseRow(sumDxdx + 1, sumDxdy + 1, sumDydy + 1, k, width - 2, response + 1);
+        // Maximum of the map, read back while the row is in cache
         for (int x = 1; x < width - 1; ++x) {
-            float a = dxdx[y][x];
-            float b = dxdy[y][x];
-            float c = dydy[y][x];
-            m_cornerResponseMap[y][x] = static_cast<float>(a*c - b*b - k*(a + c)*(a + c));
+            if (response[x] > m_maxResponse) {
+                m_maxResponse = response[x];
+                m_maxResponseLocation = std::pair<int, int>(x, y - radius);
+            }
         }
     }
 }
 
-void HarrisChessCornersDetector::thresholding(const float threshold_percent) noexcept
+void HarrisChessCornersDetector::thresholding(const float threshold_percent, const int tileSize, const float floorPercent) noexcept
 {
-    int height = m_cornerResponseMap.size();
-    int width = m_cornerResponseMap[0].size();
-    m_strongCornersMap.resize(height);
-    for (auto& row : m_strongCornersMap) {
-        row.resize(width, false);
-    }
+    HARRIS_STAGE_TIMER(m_stats.stage(HarrisStage::Thresholding));
+    int height = m_cornerResponseMap.height();
+    int width = m_cornerResponseMap.width();
+    m_candidates.clear();
 
-    float threshold = threshold_percent * m_maxResponse;
+    // A single tile covering the map when the threshold is global
+    const int tileWidth = tileSize > 0 ? tileSize : std::max(width, 1);
+    const int tileHeight = tileSize > 0 ? tileSize : std::max(height, 1);
+    HarrisParameters params{};
+    params.thresholdPercent = threshold_percent;
+    params.thresholdFloorPercent = floorPercent;
+    m_tileColumns = (width + tileWidth - 1) / tileWidth;
+    m_tileMax.assign(static_cast<std::size_t>(m_tileColumns) * ((height + tileHeight - 1) / tileHeight), 0.0F);
 
-    // Apply thresholding
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            if (m_cornerResponseMap[y][x] > threshold) {
-                m_strongCornersMap[y][x] = true; // Mark as a corner
+    // Apply thresholding, one row of tiles at a time
+    for (int tileY = 0; tileY < height; tileY += tileHeight) {
+        const int tileYEnd = std::min(tileY + tileHeight, height);
+        float* tileMax = m_tileMax.data() + static_cast<std::size_t>(tileY / tileHeight) * m_tileColumns;
+        if (tileSize > 0) {
+            for (int y = tileY; y < tileYEnd; ++y) {
+                harris::tileMaxRow(m_cornerResponseMap.row(y), 0, width, tileWidth, tileMax);
+            }
+        }
+        for (int y = tileY; y < tileYEnd; ++y) {
+            const float* response = m_cornerResponseMap.row(y);
+            for (int tileX = 0; tileX < width; tileX += tileWidth) {
+                const float threshold = tileSize > 0
+                    ? harris::tileThreshold(params, tileMax[tileX / tileWidth], m_maxResponse)
+                    : threshold_percent * m_maxResponse;
+                const int tileXEnd = std::min(tileX + tileWidth, width);
+                for (int x = tileX; x < tileXEnd; ++x) {
+                    if (response[x] > threshold) {
+                        m_candidates.push_back(HarrisCandidate{x, y, response[x]}); // Mark as a corner
+                    }
+                }
             }
         }
     }
+    // Response read, twice with tiles, candidates written
+    HARRIS_STATS(
+        m_stats.thresholdInput = static_cast<std::size_t>(width) * height;
+        m_stats.thresholdOutput = m_candidates.size();
+        m_stats.stage(HarrisStage::Thresholding).bytesTouched +=
+            (tileSize > 0 ? 8 : 4) * static_cast<std::size_t>(width) * height + sizeof(HarrisCandidate) * m_candidates.size()
+    );
 }
 
-void HarrisChessCornersDetector::nonMaximalSuppression(const int windowOffset)
+void HarrisChessCornersDetector::nonMaximalSuppression(const int windowOffset, const int maxCorners)
 {
-    int height = m_cornerResponseMap.size();
-    int width = m_cornerResponseMap[0].size();
-    m_strongCornersMapNMS.resize(height);
-    for (auto& row : m_strongCornersMapNMS) {
-        row.resize(width, false);
+    HARRIS_STAGE_TIMER(m_stats.stage(HarrisStage::Suppression));
+    int height = m_cornerResponseMap.height();
+    int width = m_cornerResponseMap.width();
+    m_nmsCorners.clear();
+    m_cornersLocation.clear();
+    m_cornersResponse.clear();
+
+    // Horizontal pass of the max filter, once per row
+    Image<float>& rowMaxMap = m_workspace.rowMaxMap;
+    rowMaxMap.reshape(width, height);
+    m_workspace.maxFilterScratch.resize(2 * (width + 2 * windowOffset));
+    for (int y = 0; y < height; ++y) {
+        harris::maxFilterRow(m_cornerResponseMap.row(y), 0, width, windowOffset, rowMaxMap.row(y), m_workspace.maxFilterScratch.data());
     }
 
-    // Apply non-maximal suppression
-    for (int y = windowOffset; y < height - windowOffset; ++y) {
-        for (int x = windowOffset; x < width - windowOffset; ++x) {
-            if (!m_strongCornersMap[y][x]) continue; // Skip if not a corner candidate
+    // Apply non-maximal suppression, the vertical pass is only run on candidates
+    for (const auto& candidate : m_candidates) {
+        const int x = candidate.x;
+        const int y = candidate.y;
+        if (x < windowOffset || x >= width - windowOffset || y < windowOffset || y >= height - windowOffset) {
+            continue; // Window does not fit in the image
+        }
 
-            float maxResponse = 0.0f;
-            for (int j = -windowOffset; j <= windowOffset; ++j) {
-                for (int i = -windowOffset; i <= windowOffset; ++i) {
-                    maxResponse = std::max(maxResponse, m_cornerResponseMap[y + j][x + i]);
-                }
-            }
+        float maxResponse = 0.0f;
+        for (int j = -windowOffset; j <= windowOffset; ++j) {
+            maxResponse = std::max(maxResponse, rowMaxMap(y + j, x));
+        }
 
-            // If the current response is the maximum in the neighborhood, mark as a corner
-            if (m_cornerResponseMap[y][x] == maxResponse) {
-                m_strongCornersMapNMS[y][x] = true;
-                m_cornersLocation.push_back(std::pair<int, int>(x, y));
-            }
+        // If the current response is the maximum in the neighborhood, mark as a corner
+        if (candidate.response == maxResponse) {
+            m_nmsCorners.push_back(candidate);
         }
     }
+
+    HARRIS_STATS(
+        m_stats.suppressionInput = m_candidates.size();
+        m_stats.suppressionOutput = m_nmsCorners.size()
+    );
+    harris::keepStrongest(m_nmsCorners, maxCorners, m_strongestHeap);
+    for (const auto& corner : m_nmsCorners) {
+        m_cornersLocation.push_back(std::pair<int, int>(corner.x, corner.y));
+        m_cornersResponse.push_back(corner.response);
+    }
+    // Response read and its row maximum written, then a column of the latter
+    // read per candidate
+    HARRIS_STATS(
+        m_stats.corners = m_nmsCorners.size();
+        m_stats.stage(HarrisStage::Suppression).bytesTouched += 8 * static_cast<std::size_t>(width) * height
+            + (sizeof(HarrisCandidate) + 4 * (2 * windowOffset + 1)) * m_candidates.size()
+    );
 }
 
-std::vector<std::vector<float>>
-HarrisChessCornersDetector::applyGaussianSmoothing(
-    const std::vector<std::vector<float>> &image,
-    const float sigma) noexcept
+void HarrisChessCornersDetector::refineCorners(const int windowOffset, const int maxIterations, const float epsilon) noexcept
 {
-    int height = image.size();
-    int width = image[0].size();
-    std::vector<std::vector<float>> output(height, std::vector<float>(width, 0.0f));
-
-    // Gaussian kernel size
-    int kernelSize = static_cast<int>(2 * sigma + 1);
-    std::vector<std::vector<float>> kernel(kernelSize, std::vector<float>(kernelSize, 0.0f));
+    HARRIS_STAGE_TIMER(m_stats.stage(HarrisStage::Refinement));
+    harris::GaussianKernel& weights = m_workspace.refinementWeights;
+    const int radius = std::max(windowOffset, 1);
+    if (weights.taps.empty() || weights.radius != radius) {
+        // Radius int(sigma), i.e. the weight at the window edge is exp(-1/2)
+        weights = harris::makeGaussianKernel(static_cast<float>(radius));
+    }
 
-    // Calculate the Gaussian kernel
-    float sum = 0.0f;
-    for (int y = -sigma; y <= sigma; ++y) {
-        for (int x = -sigma; x <= sigma; ++x) {
-            float value = std::exp(-(x * x + y * y) / (2 * sigma * sigma));
-            kernel[y + sigma][x + sigma] = value;
-            sum += value;
+    const int count = static_cast<int>(m_cornersLocation.size());
+    m_cornersSubPixel.resize(count);
+    auto refine = [&](int begin, int end) {
+        for (int index = begin; index < end; ++index) {
+            const float x = static_cast<float>(m_cornersLocation[index].first);
+            const float y = static_cast<float>(m_cornersLocation[index].second);
+            std::pair<float, float>& refined = m_cornersSubPixel[index];
+            refined = std::pair<float, float>(x, y);
+            harris::refineCorner(m_gradientX, m_gradientY, x, y, weights, maxIterations, epsilon, refined.first, refined.second);
         }
+    };
+    // Corners are cheap to refine, they are handed out to threads in chunks
+    constexpr int kChunk = 32;
+    const int chunks = (count + kChunk - 1) / kChunk;
+    if (m_threadPool && chunks > 1) {
+        m_threadPool->parallelFor(chunks, [&](int chunk, int) {
+            refine(chunk * kChunk, std::min(count, (chunk + 1) * kChunk));
+        });
+    } else {
+        refine(0, count);
     }
+    // Both gradient planes read in every window
+    HARRIS_STATS(
+        m_stats.stage(HarrisStage::Refinement).bytesTouched +=
+            static_cast<std::size_t>(count) * maxIterations * 8 * (2 * radius + 1) * (2 * radius + 1)
+    );
+}
 
-    // Normalize the kernel
-    for (int y = 0; y < kernelSize; ++y) {
-        for (int x = 0; x < kernelSize; ++x) {
-            kernel[y][x] /= sum;
-        }
+void
+HarrisChessCornersDetector::applyGaussianSmoothing(
+    const ImageView<const float> &image,
+    const float sigma,
+    Image<float> &output) noexcept
+{
+    int height = image.height();
+    int width = image.width();
+    output.reshape(width, height);
+
+    // Gaussian kernel, only recomputed when sigma changes
+    if (m_workspace.gaussianKernel.taps.empty() || m_workspace.gaussianKernel.sigma != sigma) {
+        m_workspace.gaussianKernel = harris::makeGaussianKernel(sigma);
     }
+    m_workspace.smoothingScratch.reshape(width, height);
 
-    // Apply the Gaussian smoothing
-    for (int y = sigma; y < height - sigma; ++y) {
-        for (int x = sigma; x < width - sigma; ++x) {
-            float sum = 0.0f;
-            for (int j = -sigma; j <= sigma; ++j) {
-                for (int i = -sigma; i <= sigma; ++i) {
-                    sum += image[y + j][x + i] * kernel[j + sigma][i + sigma];
-                }
-            }
-            output[y][x] = sum;
+    // Pixels closer than the kernel radius to the border are not written by
+    // the smoothing, clear them as the plane may hold a previous frame
+    const int radius = std::min(m_workspace.gaussianKernel.radius, std::min(width, height));
+    for (int y = 0; y < height; ++y) {
+        float* outputRow = output.row(y);
+        if (y < radius || y >= height - radius) {
+            std::fill(outputRow, outputRow + width, 0.0F);
+        } else {
+            std::fill(outputRow, outputRow + radius, 0.0F);
+            std::fill(outputRow + width - radius, outputRow + width, 0.0F);
         }
     }
 
-    return output;
+    // Apply the separable Gaussian smoothing
+    harris::gaussianSmoothing(image, m_workspace.gaussianKernel, m_workspace.smoothingScratch, output);
 }
@@ -10,8 +10,16 @@
 #define HARRISDETECTOR_H
 
 #include <vector>
+#include <memory>
+#include <cstddef>
 #include <cstdint>
 #include <utility> // std::pair to simply store 2D coordinates
+#include "image.hpp"
+#include "harriskernels.hpp"
+#include "harrispipeline.hpp"
+#include "harrisstats.hpp"
+#include "harristypes.hpp"
+#include "threadpool.hpp"
 
 class HarrisChessCornersDetector final
 {
@@ -29,9 +37,78 @@ public:
   // Default destructor.
   ~HarrisChessCornersDetector() = default;
 
+  /// @brief Runs the whole detection in fused mode: Sobel, structure tensor,
+  ///        response (as cornerResponse_method2()) and non-maximal suppression
+  ///        are computed in a single sweep using a few row buffers, so none of
+  ///        the debug planes below are filled. The threshold is relative to
+  ///        the maximum response of the frame, or of the tile of each corner
+  ///        with params.thresholdTileSize > 0, both measured in the same sweep.
+  ///        With params.pyramidLevels > 0 the sweep runs on a downsampled
+  ///        image instead, and each corner found is then relocated at every
+  ///        finer level by running the same pipeline on a small window around
+  ///        it, so the cost of the full resolution levels grows with the
+  ///        number of corners rather than with the pixel count. The threshold
+  ///        is then relative to the strongest relocated corner, or to the
+  ///        maximum of its tile in the relocation windows.
+  ///        Results are stored in m_cornersLocation and m_cornersResponse
+  ///        (replaced), m_maxResponse and m_maxResponseLocation.
+  /// @param image  Grayscale image.
+  /// @param params Detection parameters.
+  void detect(const ImageView<const uint8_t>& image, const HarrisParameters& params = HarrisParameters{}) noexcept;
+
+  /// @brief Tracking mode of detect() for video streams. After a keyframe,
+  ///        i.e. a full detect(), the pipeline only runs in a window of
+  ///        params.trackingSearchOffset around each corner of the previous
+  ///        frame, moved by the motion observed on that frame, and keeps the
+  ///        strongest local maximum of each window. The threshold is then
+  ///        relative to the strongest tracked corner, or to the keyframe
+  ///        maximum response if larger. A full detection is run
+  ///        instead every params.keyframeInterval frames, and whenever fewer
+  ///        than params.trackingMinRatio of the keyframe corners are found,
+  ///        counting those sharing a search window, e.g. plateau ties of the
+  ///        suppression, once.
+  ///        Results are stored as by detect().
+  /// @param image  Grayscale image, the next frame of the stream.
+  /// @param params Detection parameters, the same for every frame.
+  void track(const ImageView<const uint8_t>& image, const HarrisParameters& params = HarrisParameters{}) noexcept;
+
+  /// @brief Forgets the tracked corners, so that the next track() call runs a
+  ///        full detection, e.g. on a cut between two sequences.
+  void resetTracking() noexcept;
+
+  /// @brief True if the last track() call followed the corners of the previous
+  ///        frame, false if it ran a full detection.
+  bool lastFrameTracked() const noexcept { return m_lastFrameTracked; }
+
+  /// @brief Configures the multithreaded execution of detect(). The frame is
+  ///        split in horizontal bands processed in parallel, each one reading
+  ///        the rows around it needed by the filters, and the corners are
+  ///        merged in the same order as the serial execution.
+  /// @param threadCount Number of threads, the caller included. 1 (default)
+  ///                    runs serially.
+  /// @param bandHeight  Rows per band, 0 to derive it from the frame height.
+  void setParallelism(const int threadCount, const int bandHeight = 0);
+
+  /// @brief Sizes the row buffers of detect() for frames up to @p width
+  ///        columns, so that the next single scale detections of such frames,
+  ///        in any order, do not allocate them. They are otherwise grown by
+  ///        the first frame wider than any before.
+  /// @param width  Widest frame to come.
+  /// @param params Detection parameters of those frames.
+  void reserve(const int width, const HarrisParameters& params = HarrisParameters{});
+
   /// @brief Compute gradients by applying the Sobel operator.
   /// @param image Grayscale image.
-  void computeGradients(const std::vector<std::vector<uint8_t>>& image) noexcept;
+  void computeGradients(const ImageView<const uint8_t>& image) noexcept;
+
+  /// @brief Compute gradients over a borrowed 8-bit buffer, no copy is made.
+  ///        Any single channel buffer can be processed in place, e.g. a
+  ///        continuous or ROI'd cv::Mat, a camera buffer or a mmapped file.
+  /// @param data Pointer to the first pixel of the first row.
+  /// @param rows Number of rows.
+  /// @param cols Number of columns.
+  /// @param step Distance in bytes between two consecutive rows, i.e. >= cols.
+  void computeGradients(const uint8_t* data, int rows, int cols, std::size_t step) noexcept;
 
   
   /// @brief Computes the Harris Corner response over the gradient maps.
@@ -43,51 +120,203 @@ public:
   ///               more likely these will be correct (higher precision, lower recall).
   void cornerResponse_method1(const float sigma = 1.0F, const float k = 0.04F) noexcept;
 
-  /// @brief Computes the Harris Corner response over the gradient maps.
+  /// @brief Computes the Harris Corner response over the gradient maps, from
+  ///        the structure tensor summed over a window around each pixel.
   /// @param sigma  Gaussian filter standard deviation, a higher sigma value
   ///               results in a more blurred image.
   /// @param k      Harris corner detector constant. Typical values are in the
   ///               range of [0.04, 0.06]. The higher the values, the more
   ///               precise the detector is, i.e. will detect fewer corners but
   ///               more likely these will be correct (higher precision, lower recall).
-  void cornerResponse_method2(const float sigma = 1.0F, const float k = 0.04F, const int windowOffset = 1) noexcept;
+  /// @param windowOffset Offset of the box window, i.e. if 1 the window will
+  ///               be of size 3x3, if 2 => 5x5... The cost per pixel does not
+  ///               depend on it. 0 uses the products of the pixel alone.
+  /// @param weighting Box sum, or Gaussian weights of standard deviation sigma
+  ///               (then windowOffset is not used).
+  void cornerResponse_method2(
+    const float sigma = 1.0F,
+    const float k = 0.04F,
+    const int windowOffset = 1,
+    const TensorWeighting weighting = TensorWeighting::Box
+  ) noexcept;
 
   /// @brief Detect strong corner responses in the corner response map.
+  ///        They are stored in m_candidates, in row-major order.
   /// @param threshold_percent  Threshold as a percentage of the maximum response
   ///                           in the map, i.e values in the range (0, 1).
-  void thresholding(const float threshold_percent = 0.5F) noexcept;
+  /// @param tileSize           Side of the adaptive threshold tiles, see
+  ///                           HarrisParameters::thresholdTileSize. 0 uses the
+  ///                           maximum of the map. The maxima of a row of tiles
+  ///                           are measured just before thresholding its rows,
+  ///                           while they are in cache.
+  /// @param floorPercent       Lower bound of the tile thresholds as a
+  ///                           percentage of the maximum of the map.
+  void thresholding(const float threshold_percent = 0.5F, const int tileSize = 0, const float floorPercent = 0.01F) noexcept;
 
   /// @brief Apply Non-Maximal Suppression to reduce false positives around a true corner.
+  ///        Only the candidates from thresholding() are visited, the sliding
+  ///        maximum of the response is computed once per row whatever the
+  ///        window size. m_cornersLocation and m_cornersResponse are replaced.
   /// @param windowOffset Offset around the pixel of interest, i.e. if 1 the
   ///                   window will be of size 3x3, if 2 => 5x5, if 3 => 7x7...
   ///                   centred at the pixel of interest.
-  void nonMaximalSuppression(const int windowOffset = 1);
-
-  std::vector<std::vector<float>> m_gradientX;
-  std::vector<std::vector<float>> m_gradientY;
-  // Magnitude
-  std::vector<std::vector<float>> m_gradientMag;
-  // Orientation
-  std::vector<std::vector<float>> m_gradientOri;
+  /// @param maxCorners Keep only the strongest corners, 0 keeps all of them.
+  void nonMaximalSuppression(const int windowOffset = 1, const int maxCorners = 0);
+
+  /// @brief Gradient magnitude plane, sqrt(gx^2 + gy^2), of the last
+  ///        computeGradients() call. It is only computed on the first request
+  ///        after that call, e.g. by cornerResponse_method1() or a debug view,
+  ///        then reused.
+  const Image<float>& gradientMagnitude() noexcept;
+
+  /// @brief Gradient orientation plane, atan(gy / gx), of the last
+  ///        computeGradients() call, computed on request as gradientMagnitude().
+  const Image<float>& gradientOrientation() noexcept;
+
+  Image<float> m_gradientX;
+  Image<float> m_gradientY;
   // Corner response map
-  std::vector<std::vector<float>> m_cornerResponseMap;
-  // Strong corner response map (after thresholding)
-  std::vector<std::vector<bool>> m_strongCornersMap;
-  // Strong corner response map (after non-maximal suppresion)
-  std::vector<std::vector<bool>> m_strongCornersMapNMS;
-  // Maximum harris corner detection response in the map m_cornerResponseMap
-  float m_maxResponse;
+  Image<float> m_cornerResponseMap;
+  // Strong corner responses (after thresholding), in row-major order
+  std::vector<HarrisCandidate> m_candidates;
+  // Maximum harris corner detection response in the map m_cornerResponseMap,
+  // updated by both cornerResponse_method*() while the map is computed
+  float m_maxResponse{0.0F};
   // Max response location in the image, first = x / columns, second = y / rows.
-  std::pair<int, int> m_maxResponseLocation;
+  std::pair<int, int> m_maxResponseLocation{-1, -1};
   // List of final corner locations, first = x / columns, second = y / rows.
   std::vector<std::pair<int, int>> m_cornersLocation;
+  // Corner response of each entry of m_cornersLocation.
+  std::vector<float> m_cornersResponse;
+  // Sub-pixel location of each entry of m_cornersLocation, filled by
+  // refineCorners(). Pixel centres are at integer values, corners that could
+  // not be refined keep their integer location.
+  std::vector<std::pair<float, float>> m_cornersSubPixel;
+
+  /// @brief Refines m_cornersLocation to sub-pixel accuracy using the
+  ///        gradient planes of the last computeGradients() call, which must
+  ///        have been run on the same image (detect() does not fill them).
+  ///        Corners are refined in parallel when setParallelism() was given
+  ///        several threads. Results are stored in m_cornersSubPixel.
+  /// @param windowOffset  Offset of the Gaussian weighted window, i.e. 3 => 7x7.
+  /// @param maxIterations Iterations at most per corner.
+  /// @param epsilon       Stops once a corner moves less than this, in pixels.
+  void refineCorners(const int windowOffset = 3, const int maxIterations = 10, const float epsilon = 0.01F) noexcept;
+
+  /// @brief Timings and counters of the last frame, i.e. since the last
+  ///        computeGradients() or detect() call. Only filled when built with
+  ///        HARRIS_ENABLE_INSTRUMENTATION, all zero otherwise. Frames can be
+  ///        collected in a HarrisStatsAggregator to get percentiles.
+  const HarrisFrameStats& frameStats() const noexcept { return m_stats; }
 
 private:
-  static std::vector<std::vector<float>> applyGaussianSmoothing(
-    const std::vector<std::vector<float>>& image,
-    const float sigma = 1.0F
+  // Detection over the whole frame at a single scale, leaves the thresholded
+  // corners in m_nmsCorners
+  void detectFullFrame(const ImageView<const uint8_t>& image, const HarrisParameters& params) noexcept;
+  // Coarse-to-fine detection, leaves the thresholded corners in m_nmsCorners
+  void detectPyramid(const ImageView<const uint8_t>& image, const HarrisParameters& params) noexcept;
+  // Runs the pipeline in each of m_searchWindows and leaves the strongest
+  // local maximum of each one in m_nmsCorners, in row-major order and without
+  // duplicates
+  void detectInWindows(const ImageView<const uint8_t>& image, const HarrisParameters& params) noexcept;
+  // Number of corners detectInWindows() finds on the same frame from windows
+  // of the given offset around each of m_nmsCorners, i.e. after keeping the
+  // strongest corner of each window. Plateau ties of the suppression, a few
+  // pixels apart, collapse into one.
+  std::size_t countWindowCorners(const int offset) noexcept;
+  // Threshold relative to the strongest corner of m_nmsCorners, or to
+  // minReference if larger, for the modes that do not see the whole frame
+  void thresholdOnStrongest(const HarrisParameters& params, const float minReference = 0.0F) noexcept;
+  // Merges the tile maxima of m_regionResults into m_tileMax, for a frame of
+  // the given size
+  void mergeTileMaxima(const int width, const int height, const HarrisParameters& params) noexcept;
+  // Threshold of a corner, relative to the maximum of its tile in m_tileMax
+  // or to frameMax, see HarrisParameters::thresholdTileSize
+  float cornerThreshold(const HarrisCandidate& corner, const HarrisParameters& params, const float frameMax) const noexcept;
+  // Keeps the strongest of m_nmsCorners and stores them in m_cornersLocation
+  // and m_cornersResponse
+  void storeCorners(const HarrisParameters& params) noexcept;
+
+  void applyGaussianSmoothing(
+    const ImageView<const float>& image,
+    const float sigma,
+    Image<float>& output
   ) noexcept;
 
+  /// @brief Intermediate buffers of the staged mode. Planes are reshaped only
+  ///        when the resolution changes and vectors only grow, so once a frame
+  ///        of each resolution was processed no further heap allocation occurs.
+  struct StagedWorkspace
+  {
+    // Vertical pass rows of the separable Sobel operator
+    std::vector<float> sobelScratch;
+    // Second-moment plane of cornerResponse_method1() and its smoothed
+    // version, along with the smoothed gradient magnitude
+    Image<float> secondMoment;
+    Image<float> smoothedSecondMoment;
+    Image<float> smoothedMagnitude;
+    // Intermediate plane of the separable Gaussian smoothing
+    Image<float> smoothingScratch;
+    // Gaussian kernel of the last smoothing, rebuilt only when sigma changes
+    harris::GaussianKernel gaussianKernel;
+    // Structure tensor product planes (dx*dx, dx*dy, dy*dy) and the windowed
+    // sums of one row of cornerResponse_method2()
+    Image<float> products[3];
+    std::vector<float> sums[3];
+    // Windowed sums of the structure tensor
+    harris::TensorAccumulator tensorAccumulator;
+    // Horizontal sliding maximum of the response map and its scratch
+    Image<float> rowMaxMap;
+    std::vector<float> maxFilterScratch;
+    // Window weights of the sub-pixel refinement, rebuilt when its size changes
+    harris::GaussianKernel refinementWeights;
+  };
+
+  // Magnitude, see gradientMagnitude()
+  Image<float> m_gradientMag;
+  // Orientation, see gradientOrientation()
+  Image<float> m_gradientOri;
+  // Whether m_gradientMag / m_gradientOri match the current gradient planes
+  bool m_gradientMagValid{false};
+  bool m_gradientOriValid{false};
+  // Instrumentation of the current frame
+  HarrisFrameStats m_stats;
+  // Buffers of the staged mode
+  StagedWorkspace m_workspace;
+  // Row buffers of the fused mode, one per worker thread
+  std::vector<harris::PipelineWorkspace> m_pipelineWorkspaces = std::vector<harris::PipelineWorkspace>(1);
+  // Detections of each band, a single one in serial mode
+  std::vector<harris::RegionResult> m_regionResults;
+  // Workers of the multithreaded mode, shared by the copies of the detector
+  std::shared_ptr<harris::ThreadPool> m_threadPool;
+  // Rows per band in multithreaded mode, 0 = automatic
+  int m_bandHeight{0};
+  // Maximum response of each adaptive threshold tile of the frame, row-major
+  std::vector<float> m_tileMax;
+  int m_tileColumns{0};
+  // Corners surviving the non-maximal suppression, before keeping the strongest
+  std::vector<HarrisCandidate> m_nmsCorners;
+  // Heap of the strongest corners selection
+  std::vector<int> m_strongestHeap;
+  // Downsampled levels of the pyramid mode, the first one at half resolution
+  std::vector<Image<uint8_t>> m_pyramid;
+  // Windows searched by detectInWindows()
+  std::vector<ImageRect> m_searchWindows;
+  // Mean offset of the corners found by detectInWindows() from the centre of
+  // their window
+  float m_windowShiftX{0.0F};
+  float m_windowShiftY{0.0F};
+  // Strongest corner of each window, see countWindowCorners()
+  std::vector<int> m_windowPicks;
+  // Tracking mode: frames tracked since the keyframe, corners (one per search
+  // window) and maximum response of the keyframe, and motion of the last frame
+  int m_framesSinceKeyframe{0};
+  std::size_t m_keyframeCorners{0};
+  float m_keyframeMaxResponse{0.0F};
+  float m_trackingMotionX{0.0F};
+  float m_trackingMotionY{0.0F};
+  bool m_lastFrameTracked{false};
+
 };
 
 #endif //HARRISDETECTOR_H
@@ -0,0 +1,39 @@
+/// @file harrisengine.cpp
+/// @brief source file for harrisengine
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#include "harrisengine.hpp"
+
+HarrisCornersEngine::HarrisCornersEngine(const HarrisParameters& params, const bool tracking)
+    : m_params(params),
+      m_tracking(tracking)
+{
+}
+
+void HarrisCornersEngine::setParallelism(const int threadCount)
+{
+    m_detector.setParallelism(threadCount);
+}
+
+void HarrisCornersEngine::detect(const ImageView<const uint8_t>& image) noexcept
+{
+    if (m_tracking) {
+        m_detector.track(image, m_params);
+    } else {
+        m_detector.detect(image, m_params);
+    }
+}
+
+const std::vector<std::pair<int, int>>& HarrisCornersEngine::cornersLocation() const noexcept
+{
+    return m_detector.m_cornersLocation;
+}
+
+const std::vector<float>& HarrisCornersEngine::cornersResponse() const noexcept
+{
+    return m_detector.m_cornersResponse;
+}
@@ -0,0 +1,52 @@
+/// @file harrisengine.hpp
+/// @brief HarrisChessCornersDetector behind the ChessCornersEngine interface
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#ifndef HARRISENGINE_H
+#define HARRISENGINE_H
+
+#include "cornersengine.hpp"
+#include "harrisdetector.hpp"
+#include "harristypes.hpp"
+
+/// @brief Runs HarrisChessCornersDetector::detect(), or track() on a video
+///        stream, with fixed parameters.
+class HarrisCornersEngine final : public ChessCornersEngine
+{
+public:
+  /// @param params   Detection parameters of every frame.
+  /// @param tracking Follows the corners from frame to frame with
+  ///                 HarrisChessCornersDetector::track(), i.e. the frames
+  ///                 must be consecutive frames of a video.
+  explicit HarrisCornersEngine(const HarrisParameters& params = HarrisParameters{}, const bool tracking = false);
+  // Default copy constructor.
+  HarrisCornersEngine(const HarrisCornersEngine&) = default;
+  // Default copy assignment operator.
+  HarrisCornersEngine& operator=(const HarrisCornersEngine&) = default;
+  // Default move constructor.
+  HarrisCornersEngine(HarrisCornersEngine&&) = default;
+  // Default move assignment operator.
+  HarrisCornersEngine& operator=(HarrisCornersEngine&&) = default;
+  // Default destructor.
+  ~HarrisCornersEngine() override = default;
+
+  const char* name() const noexcept override { return "harris"; }
+  void setParallelism(const int threadCount) override;
+  void detect(const ImageView<const uint8_t>& image) noexcept override;
+  const std::vector<std::pair<int, int>>& cornersLocation() const noexcept override;
+  const std::vector<float>& cornersResponse() const noexcept override;
+
+  /// @brief Wrapped detector, e.g. for its frameStats().
+  const HarrisChessCornersDetector& detector() const noexcept { return m_detector; }
+
+private:
+  HarrisChessCornersDetector m_detector;
+  HarrisParameters m_params;
+  bool m_tracking;
+};
+
+#endif //HARRISENGINE_H
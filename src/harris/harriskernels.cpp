@@ -0,0 +1,665 @@
+/// @file harriskernels.cpp
+/// @brief source file for harriskernels
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#include "harriskernels.hpp"
+#include "simd.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace harris {
+
+const char* simdInstructionSet() noexcept
+{
+    return simd::name();
+}
+
+void sobelRow(
+    const ImageView<const uint8_t>& image,
+    int y,
+    int xBegin,
+    int xEnd,
+    float* gradX,
+    float* gradY,
+    float* scratch
+    ) noexcept
+{
+    const int width = image.width();
+    xBegin = std::max(xBegin, 1);
+    xEnd = std::min(xEnd, width - 1);
+    if (xBegin >= xEnd) {
+        return;
+    }
+    const uint8_t* above = image.row(y - 1);
+    const uint8_t* center = image.row(y);
+    const uint8_t* below = image.row(y + 1);
+    // Vertical pass results, indexed by image column
+    float* smoothed = scratch;
+    float* derived = scratch + width;
+
+    // Vertical pass: [1 2 1]^T for the X derivative, [-1 0 1]^T for the Y one
+    const int vBegin = xBegin - 1;
+    const int vEnd = xEnd + 1;
+    int x = vBegin;
+    for (; x + simd::kFloatLanes <= vEnd; x += simd::kFloatLanes) {
+        const simd::Float a = simd::loadU8(above + x);
+        const simd::Float b = simd::loadU8(center + x);
+        const simd::Float c = simd::loadU8(below + x);
+        simd::store(smoothed + x, simd::add(simd::add(a, simd::add(b, b)), c));
+        simd::store(derived + x, simd::sub(c, a));
+    }
+    for (; x < vEnd; ++x) {
+        const float a = above[x];
+        const float b = center[x];
+        const float c = below[x];
+        smoothed[x] = (a + (b + b)) + c;
+        derived[x] = c - a;
+    }
+
+    // Horizontal pass: [-1 0 1] for the X derivative, [1 2 1] for the Y one
+    x = xBegin;
+    for (; x + simd::kFloatLanes <= xEnd; x += simd::kFloatLanes) {
+        const simd::Float left = simd::load(derived + x - 1);
+        const simd::Float middle = simd::load(derived + x);
+        const simd::Float right = simd::load(derived + x + 1);
+        simd::store(gradX + x, simd::sub(simd::load(smoothed + x + 1), simd::load(smoothed + x - 1)));
+        simd::store(gradY + x, simd::add(simd::add(left, simd::add(middle, middle)), right));
+    }
+    for (; x < xEnd; ++x) {
+        gradX[x] = smoothed[x + 1] - smoothed[x - 1];
+        gradY[x] = (derived[x - 1] + (derived[x] + derived[x])) + derived[x + 1];
+    }
+}
+
+void sobelRow(
+    const ImageView<const uint8_t>& image,
+    int y,
+    int xBegin,
+    int xEnd,
+    int16_t* gradX,
+    int16_t* gradY,
+    int16_t* scratch
+    ) noexcept
+{
+    const int width = image.width();
+    xBegin = std::max(xBegin, 1);
+    xEnd = std::min(xEnd, width - 1);
+    if (xBegin >= xEnd) {
+        return;
+    }
+    const uint8_t* above = image.row(y - 1);
+    const uint8_t* center = image.row(y);
+    const uint8_t* below = image.row(y + 1);
+    int16_t* smoothed = scratch;
+    int16_t* derived = scratch + width;
+
+    // Same passes as the float version, plain loops the compiler vectorizes
+    // on 16-bit lanes, i.e. twice the pixels per instruction
+    for (int x = xBegin - 1; x < xEnd + 1; ++x) {
+        smoothed[x] = static_cast<int16_t>(above[x] + 2 * center[x] + below[x]);
+        derived[x] = static_cast<int16_t>(below[x] - above[x]);
+    }
+    for (int x = xBegin; x < xEnd; ++x) {
+        gradX[x] = static_cast<int16_t>(smoothed[x + 1] - smoothed[x - 1]);
+        gradY[x] = static_cast<int16_t>(derived[x - 1] + 2 * derived[x] + derived[x + 1]);
+    }
+}
+
+void gradientMagnitude(const float* gradX, const float* gradY, float* magnitude, int count) noexcept
+{
+    int x = 0;
+    for (; x + simd::kFloatLanes <= count; x += simd::kFloatLanes) {
+        const simd::Float gx = simd::load(gradX + x);
+        const simd::Float gy = simd::load(gradY + x);
+        simd::store(magnitude + x, simd::sqrt(simd::add(simd::mul(gx, gx), simd::mul(gy, gy))));
+    }
+    for (; x < count; ++x) {
+        magnitude[x] = std::sqrt(gradX[x] * gradX[x] + gradY[x] * gradY[x]);
+    }
+}
+
+void downsampleHalf(const ImageView<const uint8_t>& input, const ImageView<uint8_t>& output) noexcept
+{
+    for (int y = 0; y < output.height(); ++y) {
+        const uint8_t* top = input.row(2 * y);
+        const uint8_t* bottom = input.row(2 * y + 1);
+        uint8_t* outputRow = output.row(y);
+        for (int x = 0; x < output.width(); ++x) {
+            const int sum = top[2 * x] + top[2 * x + 1] + bottom[2 * x] + bottom[2 * x + 1];
+            outputRow[x] = static_cast<uint8_t>((sum + 2) >> 2);
+        }
+    }
+}
+
+GaussianKernel makeGaussianKernel(const float sigma)
+{
+    GaussianKernel kernel{};
+    kernel.sigma = sigma;
+    kernel.radius = static_cast<int>(sigma);
+    kernel.taps.resize(2 * kernel.radius + 1);
+
+    float sum = 0.0F;
+    for (int i = -kernel.radius; i <= kernel.radius; ++i) {
+        float value = std::exp(-(i * i) / (2 * sigma * sigma));
+        kernel.taps[i + kernel.radius] = value;
+        sum += value;
+    }
+    // Normalize the kernel, the 2D kernel sum is the square of the 1D one
+    for (auto& tap : kernel.taps) {
+        tap /= sum;
+    }
+    return kernel;
+}
+
+void gaussianSmoothing(
+    const ImageView<const float>& input,
+    const GaussianKernel& kernel,
+    const ImageView<float>& temp,
+    const ImageView<float>& output
+    ) noexcept
+{
+    const int height = input.height();
+    const int width = input.width();
+    const int radius = kernel.radius;
+    const float* taps = kernel.taps.data();
+    const int xBegin = radius;
+    const int xEnd = width - radius;
+
+    // Horizontal pass over every row
+    for (int y = 0; y < height; ++y) {
+        const float* inputRow = input.row(y);
+        float* tempRow = temp.row(y);
+        int x = xBegin;
+        for (; x + simd::kFloatLanes <= xEnd; x += simd::kFloatLanes) {
+            simd::Float sum = simd::set1(0.0F);
+            for (int i = -radius; i <= radius; ++i) {
+                sum = simd::add(sum, simd::mul(simd::load(inputRow + x + i), simd::set1(taps[i + radius])));
+            }
+            simd::store(tempRow + x, sum);
+        }
+        for (; x < xEnd; ++x) {
+            float sum = 0.0F;
+            for (int i = -radius; i <= radius; ++i) {
+                sum += inputRow[x + i] * taps[i + radius];
+            }
+            tempRow[x] = sum;
+        }
+    }
+
+    // Vertical pass over the rows with a complete neighbourhood
+    for (int y = radius; y < height - radius; ++y) {
+        float* outputRow = output.row(y);
+        int x = xBegin;
+        for (; x + simd::kFloatLanes <= xEnd; x += simd::kFloatLanes) {
+            simd::Float sum = simd::set1(0.0F);
+            for (int j = -radius; j <= radius; ++j) {
+                sum = simd::add(sum, simd::mul(simd::load(temp.row(y + j) + x), simd::set1(taps[j + radius])));
+            }
+            simd::store(outputRow + x, sum);
+        }
+        for (; x < xEnd; ++x) {
+            float sum = 0.0F;
+            for (int j = -radius; j <= radius; ++j) {
+                sum += temp(y + j, x) * taps[j + radius];
+            }
+            outputRow[x] = sum;
+        }
+    }
+}
+
+namespace {
+
+// Fractional bits of the integer Gaussian taps
+constexpr int kFixedTapBits = 8;
+// Largest product of two Sobel derivatives of 8-bit pixels
+constexpr int64_t kMaxSobelProduct = 1020 * 1020;
+
+inline float dropLowBits(float value, int /*shift*/) noexcept
+{
+    return value;
+}
+
+inline int32_t dropLowBits(int32_t value, int shift) noexcept
+{
+    return value >> shift;
+}
+
+} // namespace
+
+template <typename Precision>
+void BasicTensorAccumulator<Precision>::reset(int width, int colBegin, int colEnd, int radius, const GaussianKernel* kernel)
+{
+    m_width = width;
+    m_colBegin = colBegin;
+    m_colEnd = std::max(colEnd, colBegin);
+    m_productShift = 0;
+    if (kernel != nullptr) {
+        m_radius = kernel->radius;
+        m_taps.assign(kernel->taps.begin(), kernel->taps.end());
+        m_fixedTaps.resize(m_taps.size());
+        for (std::size_t i = 0; i < m_taps.size(); ++i) {
+            m_fixedTaps[i] = static_cast<int32_t>(std::lround(m_taps[i] * (1 << kFixedTapBits)));
+        }
+    } else {
+        m_radius = std::max(radius, 0);
+        m_taps.clear();
+        m_fixedTaps.clear();
+        if (std::is_integral<Accumulator>::value) {
+            const int64_t windowArea = static_cast<int64_t>(2 * m_radius + 1) * (2 * m_radius + 1);
+            while ((kMaxSobelProduct >> m_productShift) * windowArea > std::numeric_limits<Accumulator>::max()) {
+                ++m_productShift;
+            }
+        }
+    }
+    m_pushedRows = 0;
+
+    const std::size_t rowLength = static_cast<std::size_t>(m_colEnd - m_colBegin);
+    for (int product = 0; product < 3; ++product) {
+        m_ring[product].resize(rowLength * (2 * m_radius + 1));
+        m_columnSums[product].assign(rowLength, Accumulator{0});
+    }
+}
+
+template <typename Precision>
+template <int Radius>
+void BasicTensorAccumulator<Precision>::horizontalPass(const Product* input, Accumulator* output) const noexcept
+{
+    if (input == nullptr) {
+        std::fill(output, output + (m_colEnd - m_colBegin), Accumulator{0});
+        return;
+    }
+    const int radius = Radius >= 0 ? Radius : m_radius;
+    if (m_taps.empty()) {
+        // Running sum, only the image columns are read
+        const int shift = m_productShift;
+        Accumulator sum{0};
+        for (int i = std::max(m_colBegin - radius, 0); i < std::min(m_colBegin + radius, m_width - 1) + 1; ++i) {
+            sum += dropLowBits(input[i], shift);
+        }
+        output[0] = sum;
+        // Slide the window one column to the right, the columns in
+        // [steadyBegin, steadyEnd) enter and leave it inside the image, so the
+        // sum is a single dependency chain without branches
+        auto slide = [&](int x) {
+            if (x + radius < m_width) {
+                sum += dropLowBits(input[x + radius], shift);
+            }
+            if (x - radius - 1 >= 0) {
+                sum -= dropLowBits(input[x - radius - 1], shift);
+            }
+            output[x - m_colBegin] = sum;
+        };
+        const int steadyBegin = std::min(std::max(m_colBegin + 1, radius + 1), m_colEnd);
+        const int steadyEnd = std::max(std::min(m_colEnd, m_width - radius), steadyBegin);
+        int x = m_colBegin + 1;
+        for (; x < steadyBegin; ++x) {
+            slide(x);
+        }
+        for (; x < steadyEnd; ++x) {
+            sum += dropLowBits(input[x + radius], shift) - dropLowBits(input[x - radius - 1], shift);
+            output[x - m_colBegin] = sum;
+        }
+        for (; x < m_colEnd; ++x) {
+            slide(x);
+        }
+        return;
+    }
+    // Columns whose whole window lies in the image, the taps loop then has
+    // fixed bounds and is unrolled when Radius is known at compile time
+    const int interiorBegin = std::min(std::max(m_colBegin, radius), m_colEnd);
+    const int interiorEnd = std::max(std::min(m_colEnd, m_width - radius), interiorBegin);
+    if (std::is_integral<Accumulator>::value) {
+        // The taps sum to about 2^kFixedTapBits, so the weighted sum of
+        // products fits in 32 bits before being scaled back
+        const int32_t* taps = m_fixedTaps.data();
+        auto weightedSum = [&](int x, int iBegin, int iEnd) {
+            int32_t sum = 0;
+            for (int i = iBegin; i <= iEnd; ++i) {
+                sum += static_cast<int32_t>(input[x + i]) * taps[i + radius];
+            }
+            output[x - m_colBegin] = static_cast<Accumulator>((sum + (1 << (kFixedTapBits - 1))) >> kFixedTapBits);
+        };
+        for (int x = m_colBegin; x < interiorBegin; ++x) {
+            weightedSum(x, std::max(-radius, -x), std::min(radius, m_width - 1 - x));
+        }
+        for (int x = interiorBegin; x < interiorEnd; ++x) {
+            weightedSum(x, -radius, radius);
+        }
+        for (int x = interiorEnd; x < m_colEnd; ++x) {
+            weightedSum(x, std::max(-radius, -x), std::min(radius, m_width - 1 - x));
+        }
+        return;
+    }
+    const float* taps = m_taps.data();
+    auto weightedSum = [&](int x, int iBegin, int iEnd) {
+        float sum = 0.0F;
+        for (int i = iBegin; i <= iEnd; ++i) {
+            sum += static_cast<float>(input[x + i]) * taps[i + radius];
+        }
+        output[x - m_colBegin] = static_cast<Accumulator>(sum);
+    };
+    for (int x = m_colBegin; x < interiorBegin; ++x) {
+        weightedSum(x, std::max(-radius, -x), std::min(radius, m_width - 1 - x));
+    }
+    for (int x = interiorBegin; x < interiorEnd; ++x) {
+        weightedSum(x, -radius, radius);
+    }
+    for (int x = interiorEnd; x < m_colEnd; ++x) {
+        weightedSum(x, std::max(-radius, -x), std::min(radius, m_width - 1 - x));
+    }
+}
+
+template <typename Precision>
+template <int Radius>
+void BasicTensorAccumulator<Precision>::pushRow(const Product* dxdx, const Product* dxdy, const Product* dydy) noexcept
+{
+    const std::size_t rowLength = static_cast<std::size_t>(m_colEnd - m_colBegin);
+    const int ringRows = 2 * (Radius >= 0 ? Radius : m_radius) + 1;
+    const std::size_t offset = static_cast<std::size_t>(m_pushedRows % ringRows) * rowLength;
+    const Product* inputs[3] = {dxdx, dxdy, dydy};
+
+    for (int product = 0; product < 3; ++product) {
+        Accumulator* slot = m_ring[product].data() + offset;
+        Accumulator* columnSums = m_columnSums[product].data();
+        if (m_taps.empty() && m_pushedRows >= ringRows) {
+            // The row leaving the window
+            for (std::size_t i = 0; i < rowLength; ++i) {
+                columnSums[i] -= slot[i];
+            }
+        }
+        horizontalPass<Radius>(inputs[product], slot);
+        if (m_taps.empty()) {
+            for (std::size_t i = 0; i < rowLength; ++i) {
+                columnSums[i] += slot[i];
+            }
+        }
+    }
+    ++m_pushedRows;
+}
+
+template <typename Precision>
+template <int Radius>
+void BasicTensorAccumulator<Precision>::windowSums(float* sumDxdx, float* sumDxdy, float* sumDydy) const noexcept
+{
+    const std::size_t rowLength = static_cast<std::size_t>(m_colEnd - m_colBegin);
+    float* outputs[3] = {sumDxdx + m_colBegin, sumDxdy + m_colBegin, sumDydy + m_colBegin};
+
+    if (m_taps.empty()) {
+        // Back to the scale of the products
+        const float scale = static_cast<float>(1 << m_productShift);
+        for (int product = 0; product < 3; ++product) {
+            const Accumulator* columnSums = m_columnSums[product].data();
+            for (std::size_t i = 0; i < rowLength; ++i) {
+                outputs[product][i] = static_cast<float>(columnSums[i]) * scale;
+            }
+        }
+        return;
+    }
+
+    // Vertical Gaussian pass, oldest row first
+    const int ringRows = 2 * (Radius >= 0 ? Radius : m_radius) + 1;
+    const bool fixedPoint = std::is_integral<Accumulator>::value;
+    auto tap = [&](int j) {
+        return fixedPoint ? static_cast<float>(m_fixedTaps[j]) / static_cast<float>(1 << kFixedTapBits) : m_taps[j];
+    };
+    auto slot = [&](int product, int j) {
+        const int row = m_pushedRows - ringRows + j;
+        return m_ring[product].data() + static_cast<std::size_t>(row % ringRows) * rowLength;
+    };
+    if (Radius >= 0) {
+        // All the rows of a column at once, summed in the same order as below
+        constexpr int kRows = 2 * std::max(Radius, 0) + 1;
+        float taps[kRows];
+        for (int j = 0; j < kRows; ++j) {
+            taps[j] = tap(j);
+        }
+        for (int product = 0; product < 3; ++product) {
+            const Accumulator* rows[kRows];
+            for (int j = 0; j < kRows; ++j) {
+                rows[j] = slot(product, j);
+            }
+            for (std::size_t i = 0; i < rowLength; ++i) {
+                float sum = 0.0F;
+                for (int j = 0; j < kRows; ++j) {
+                    sum += static_cast<float>(rows[j][i]) * taps[j];
+                }
+                outputs[product][i] = sum;
+            }
+        }
+        return;
+    }
+    for (int product = 0; product < 3; ++product) {
+        std::fill(outputs[product], outputs[product] + rowLength, 0.0F);
+        for (int j = 0; j < ringRows; ++j) {
+            const Accumulator* row = slot(product, j);
+            const float weight = tap(j);
+            for (std::size_t i = 0; i < rowLength; ++i) {
+                outputs[product][i] += static_cast<float>(row[i]) * weight;
+            }
+        }
+    }
+}
+
+template class BasicTensorAccumulator<FloatPrecision>;
+template class BasicTensorAccumulator<FixedPointPrecision>;
+
+// Window radii of the specialized pipelines, see harrispipeline.cpp
+#define HARRIS_INSTANTIATE_ACCUMULATOR(Precision, Radius) \
+    template void BasicTensorAccumulator<Precision>::pushRow<Radius>( \
+        const Precision::Product*, const Precision::Product*, const Precision::Product*) noexcept; \
+    template void BasicTensorAccumulator<Precision>::windowSums<Radius>(float*, float*, float*) const noexcept;
+HARRIS_INSTANTIATE_ACCUMULATOR(FloatPrecision, kDynamicRadius)
+HARRIS_INSTANTIATE_ACCUMULATOR(FloatPrecision, 1)
+HARRIS_INSTANTIATE_ACCUMULATOR(FloatPrecision, 2)
+HARRIS_INSTANTIATE_ACCUMULATOR(FixedPointPrecision, kDynamicRadius)
+HARRIS_INSTANTIATE_ACCUMULATOR(FixedPointPrecision, 1)
+HARRIS_INSTANTIATE_ACCUMULATOR(FixedPointPrecision, 2)
+#undef HARRIS_INSTANTIATE_ACCUMULATOR
+
+void maxFilterRow(const float* input, int begin, int end, int radius, float* output, float* scratch) noexcept
+{
+    const int count = end - begin;
+    if (count <= 0) {
+        return;
+    }
+    radius = std::max(radius, 0);
+    const int window = 2 * radius + 1;
+    // Segment padded with -inf, element j of the padded row is column begin - radius + j
+    const int paddedCount = count + 2 * radius;
+    float* forward = scratch;
+    float* backward = scratch + paddedCount;
+    const float lowest = -std::numeric_limits<float>::infinity();
+    auto padded = [&](int j) {
+        const int x = begin - radius + j;
+        return (x >= begin && x < end) ? input[x] : lowest;
+    };
+
+    // Running maximum from the start (forward) and from the end (backward) of
+    // each block of `window` elements
+    for (int blockBegin = 0; blockBegin < paddedCount; blockBegin += window) {
+        const int blockEnd = std::min(blockBegin + window, paddedCount);
+        float running = lowest;
+        for (int j = blockBegin; j < blockEnd; ++j) {
+            running = std::max(running, padded(j));
+            forward[j] = running;
+        }
+        running = lowest;
+        for (int j = blockEnd - 1; j >= blockBegin; --j) {
+            running = std::max(running, padded(j));
+            backward[j] = running;
+        }
+    }
+    // The window [j, j + window) spans at most two blocks
+    for (int j = 0; j < count; ++j) {
+        output[begin + j] = std::max(backward[j], forward[j + window - 1]);
+    }
+}
+
+template <int Radius>
+void maxFilterRow(const float* input, int begin, int end, float* output, float* scratch) noexcept
+{
+    constexpr int kDirectMaxRadius = 2;
+    if (Radius > kDirectMaxRadius) {
+        maxFilterRow(input, begin, end, Radius, output, scratch);
+        return;
+    }
+    // Columns whose window lies in the segment
+    const int interiorBegin = std::min(begin + Radius, end);
+    const int interiorEnd = std::max(end - Radius, interiorBegin);
+    auto clampedMax = [&](int x) {
+        float value = input[x];
+        for (int i = std::max(x - Radius, begin); i <= std::min(x + Radius, end - 1); ++i) {
+            value = std::max(value, input[i]);
+        }
+        output[x] = value;
+    };
+    int x = begin;
+    for (; x < interiorBegin; ++x) {
+        clampedMax(x);
+    }
+    for (; x + simd::kFloatLanes <= interiorEnd; x += simd::kFloatLanes) {
+        simd::Float value = simd::load(input + x - Radius);
+        for (int i = -Radius + 1; i <= Radius; ++i) {
+            value = simd::max(value, simd::load(input + x + i));
+        }
+        simd::store(output + x, value);
+    }
+    for (; x < end; ++x) {
+        clampedMax(x);
+    }
+}
+
+// NMS radii of the specialized pipelines, see harrispipeline.cpp
+template void maxFilterRow<1>(const float*, int, int, float*, float*) noexcept;
+template void maxFilterRow<2>(const float*, int, int, float*, float*) noexcept;
+template void maxFilterRow<10>(const float*, int, int, float*, float*) noexcept;
+
+void tileMaxRow(const float* input, int begin, int end, int tileSize, float* tileMax) noexcept
+{
+    for (int tileBegin = begin; tileBegin < end;) {
+        const int tile = tileBegin / tileSize;
+        const int tileEnd = std::min((tile + 1) * tileSize, end);
+        float value = tileMax[tile];
+        int x = tileBegin;
+        if (tileEnd - x >= simd::kFloatLanes) {
+            simd::Float lanes = simd::load(input + x);
+            for (x += simd::kFloatLanes; x + simd::kFloatLanes <= tileEnd; x += simd::kFloatLanes) {
+                lanes = simd::max(lanes, simd::load(input + x));
+            }
+            float laneValues[simd::kFloatLanes];
+            simd::store(laneValues, lanes);
+            for (float laneValue : laneValues) {
+                value = std::max(value, laneValue);
+            }
+        }
+        for (; x < tileEnd; ++x) {
+            value = std::max(value, input[x]);
+        }
+        tileMax[tile] = value;
+        tileBegin = tileEnd;
+    }
+}
+
+void harrisResponseRow(
+    const float* sumDxdx,
+    const float* sumDxdy,
+    const float* sumDydy,
+    float k,
+    int count,
+    float* response
+    ) noexcept
+{
+    const simd::Float kVec = simd::set1(k);
+    int x = 0;
+    for (; x + simd::kFloatLanes <= count; x += simd::kFloatLanes) {
+        const simd::Float a = simd::load(sumDxdx + x);
+        const simd::Float b = simd::load(sumDxdy + x);
+        const simd::Float c = simd::load(sumDydy + x);
+        const simd::Float trace = simd::add(a, c);
+        simd::store(response + x, simd::sub(
+            simd::sub(simd::mul(a, c), simd::mul(b, b)),
+            simd::mul(simd::mul(kVec, trace), trace)));
+    }
+    for (; x < count; ++x) {
+        const float a = sumDxdx[x];
+        const float b = sumDxdy[x];
+        const float c = sumDydy[x];
+        response[x] = a*c - b*b - k*(a + c)*(a + c);
+    }
+}
+
+bool refineCorner(
+    const ImageView<const float>& gradX,
+    const ImageView<const float>& gradY,
+    float x,
+    float y,
+    const GaussianKernel& weights,
+    int maxIterations,
+    float epsilon,
+    float& refinedX,
+    float& refinedY
+    ) noexcept
+{
+    const int radius = weights.radius;
+    const float* taps = weights.taps.data();
+    double qx = x;
+    double qy = y;
+    for (int iteration = 0; iteration < maxIterations; ++iteration) {
+        const int cx = static_cast<int>(std::lround(qx));
+        const int cy = static_cast<int>(std::lround(qy));
+        if (cx - radius < 0 || cy - radius < 0 || cx + radius >= gradX.width() || cy + radius >= gradX.height()) {
+            return false;
+        }
+
+        // Sum of G = w * g * g^T and of G * p over the window, relative to its
+        // centre to keep the sums small
+        double a = 0.0;
+        double b = 0.0;
+        double c = 0.0;
+        double bx = 0.0;
+        double by = 0.0;
+        for (int j = -radius; j <= radius; ++j) {
+            const float* gxRow = gradX.row(cy + j) + cx;
+            const float* gyRow = gradY.row(cy + j) + cx;
+            for (int i = -radius; i <= radius; ++i) {
+                const double weight = static_cast<double>(taps[j + radius]) * taps[i + radius];
+                const double gx = gxRow[i];
+                const double gy = gyRow[i];
+                const double gxx = weight * gx * gx;
+                const double gxy = weight * gx * gy;
+                const double gyy = weight * gy * gy;
+                a += gxx;
+                b += gxy;
+                c += gyy;
+                bx += gxx * i + gxy * j;
+                by += gxy * i + gyy * j;
+            }
+        }
+        const double det = a * c - b * b;
+        if (!(det > std::numeric_limits<double>::epsilon() * (a + c) * (a + c))) {
+            return false;
+        }
+        const double nx = cx + (c * bx - b * by) / det;
+        const double ny = cy + (a * by - b * bx) / det;
+        const double shift = std::max(std::abs(nx - qx), std::abs(ny - qy));
+        qx = nx;
+        qy = ny;
+        if (std::abs(qx - x) > radius || std::abs(qy - y) > radius) {
+            return false;
+        }
+        if (shift < epsilon) {
+            break;
+        }
+    }
+    refinedX = static_cast<float>(qx);
+    refinedY = static_cast<float>(qy);
+    return true;
+}
+
+} // namespace harris
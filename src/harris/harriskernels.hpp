@@ -0,0 +1,239 @@
+/// @file harriskernels.hpp
+/// @brief Separable, vectorized filter kernels used by the Harris detector
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#ifndef HARRISKERNELS_H
+#define HARRISKERNELS_H
+
+#include <cstdint>
+#include <vector>
+#include "image.hpp"
+#include "harrisprecision.hpp"
+
+namespace harris {
+
+// Template argument of a radius only known at run time, see the radius
+// specializations of BasicTensorAccumulator and maxFilterRow()
+constexpr int kDynamicRadius = -1;
+
+/// @brief Name of the instruction set the kernels were built for, e.g. "AVX2".
+const char* simdInstructionSet() noexcept;
+
+/// @brief Applies the 3x3 Sobel operator to one image row as two separable
+///        passes: a vertical [1 2 1] / [-1 0 1] pass followed by the
+///        horizontal one. Results are bit-exact with the direct 3x3 sum.
+/// @param image   Grayscale image.
+/// @param y       Row to filter, in [1, height - 1).
+/// @param xBegin  First column to compute, clamped to 1.
+/// @param xEnd    One past the last column to compute, clamped to width - 1.
+/// @param gradX   Output row for the X derivative, indexed by image column.
+/// @param gradY   Output row for the Y derivative, indexed by image column.
+/// @param scratch Temporary buffer of at least 2 * width floats.
+void sobelRow(
+  const ImageView<const uint8_t>& image,
+  int y,
+  int xBegin,
+  int xEnd,
+  float* gradX,
+  float* gradY,
+  float* scratch
+) noexcept;
+
+/// @brief Integer version of sobelRow(), for FixedPointPrecision. The
+///        derivatives lie in [-1020, 1020], so the results are exact.
+/// @param scratch Temporary buffer of at least 2 * width elements.
+void sobelRow(
+  const ImageView<const uint8_t>& image,
+  int y,
+  int xBegin,
+  int xEnd,
+  int16_t* gradX,
+  int16_t* gradY,
+  int16_t* scratch
+) noexcept;
+
+/// @brief Computes sqrt(gx^2 + gy^2) for @p count elements.
+void gradientMagnitude(const float* gradX, const float* gradY, float* magnitude, int count) noexcept;
+
+/// @brief Halves the resolution of a grayscale image, each output pixel being
+///        the rounded mean of a 2x2 block. An odd last row/column is dropped.
+/// @param input  Image of at least 2x2 pixels.
+/// @param output Plane of (input.width() / 2) x (input.height() / 2) pixels.
+void downsampleHalf(const ImageView<const uint8_t>& input, const ImageView<uint8_t>& output) noexcept;
+
+/// @brief Normalised 1D Gaussian, the 2D kernel is its outer product.
+struct GaussianKernel
+{
+  // Standard deviation the taps were computed for
+  float sigma{0.0F};
+  // Half size, i.e. the kernel has 2 * radius + 1 taps
+  int radius{0};
+  std::vector<float> taps;
+};
+
+/// @brief Builds the Gaussian kernel of radius int(sigma) used by the detector.
+GaussianKernel makeGaussianKernel(const float sigma);
+
+/// @brief Separable Gaussian smoothing, horizontal pass then vertical pass.
+///        Only pixels at least `radius` away from the border are written.
+/// @param input  Plane to smooth.
+/// @param kernel Kernel from makeGaussianKernel().
+/// @param temp   Intermediate plane of the same size as @p input.
+/// @param output Smoothed plane, same size as @p input.
+void gaussianSmoothing(
+  const ImageView<const float>& input,
+  const GaussianKernel& kernel,
+  const ImageView<float>& temp,
+  const ImageView<float>& output
+) noexcept;
+
+/// @brief Windowed sums of the structure tensor products (dx*dx, dx*dy,
+///        dy*dy), fed one image row at a time.
+///
+/// In box mode the sums are running sums, first along each row and then
+/// along the columns, so the cost per pixel does not depend on the window
+/// size. They are accumulated in Precision::Accumulator, double or int32,
+/// which is exact for the integer valued products of the Sobel gradients, so
+/// the result does not depend on which row the accumulation started at.
+/// Pixels outside the image count as zero.
+/// @tparam Precision FloatPrecision or FixedPointPrecision.
+template <typename Precision>
+class BasicTensorAccumulator final
+{
+public:
+  using Product = typename Precision::Product;
+  using Accumulator = typename Precision::Accumulator;
+
+  /// @brief Prepares a new accumulation.
+  /// @param width    Image width.
+  /// @param colBegin First column whose sums are produced.
+  /// @param colEnd   One past the last column whose sums are produced.
+  /// @param radius   Window offset, i.e. the window is (2 * radius + 1) wide.
+  /// @param kernel   Gaussian weights (radius taken from it), nullptr for box.
+  ///                 The taps are copied.
+  void reset(int width, int colBegin, int colEnd, int radius, const GaussianKernel* kernel);
+
+  /// @brief Window offset in use.
+  int radius() const noexcept { return m_radius; }
+
+  /// @brief Adds the products of the next row. They are read, indexed by
+  ///        image column, on [colBegin - radius, colEnd + radius) clipped to
+  ///        the image. nullptr means an all-zero row.
+  /// @tparam Radius radius() if known at compile time, which unrolls the
+  ///                Gaussian taps, kDynamicRadius otherwise. Instantiated for
+  ///                the window radii of the specialized pipelines, see
+  ///                harrispipeline.cpp.
+  template <int Radius = kDynamicRadius>
+  void pushRow(const Product* dxdx, const Product* dxdy, const Product* dydy) noexcept;
+
+  /// @brief True once 2 * radius + 1 rows were pushed, the sums of the row
+  ///        pushed `radius` rows ago are then available.
+  bool ready() const noexcept { return m_pushedRows >= 2 * m_radius + 1; }
+
+  /// @brief Windowed sums of the centre row, written on [colBegin, colEnd).
+  /// @tparam Radius As for pushRow().
+  template <int Radius = kDynamicRadius>
+  void windowSums(float* sumDxdx, float* sumDxdy, float* sumDydy) const noexcept;
+
+private:
+  template <int Radius>
+  void horizontalPass(const Product* input, Accumulator* output) const noexcept;
+
+  int m_width{0};
+  int m_colBegin{0};
+  int m_colEnd{0};
+  int m_radius{0};
+  // Gaussian taps, empty in box mode, and their integer version with 8
+  // fractional bits for the integer accumulators
+  std::vector<float> m_taps;
+  std::vector<int32_t> m_fixedTaps;
+  // Low bits of the products dropped by the box sums so that they cannot
+  // overflow the integer accumulators, 0 otherwise
+  int m_productShift{0};
+  int m_pushedRows{0};
+  // Last 2 * radius + 1 horizontally filtered rows of each product, indexed
+  // by (row % (2 * radius + 1)) * rowLength + (column - colBegin)
+  std::vector<Accumulator> m_ring[3];
+  // Box mode vertical running sums
+  std::vector<Accumulator> m_columnSums[3];
+};
+
+// Accumulator of the staged API
+using TensorAccumulator = BasicTensorAccumulator<FloatPrecision>;
+
+/// @brief Sliding maximum over [x - radius, x + radius] of a row segment,
+///        van Herk/Gil-Werman style, i.e. about 3 comparisons per pixel
+///        whatever the radius. Values outside [begin, end) are ignored.
+/// @param input   Row, indexed by image column, read on [begin, end).
+/// @param begin   First column of the segment.
+/// @param end     One past the last column of the segment.
+/// @param radius  Window offset.
+/// @param output  Filtered row, indexed by image column, written on [begin, end).
+/// @param scratch Temporary buffer of at least 2 * (end - begin + 2 * radius) floats.
+void maxFilterRow(const float* input, int begin, int end, int radius, float* output, float* scratch) noexcept;
+
+/// @brief maxFilterRow() with a radius known at compile time. Small radii
+///        take the maximum of the 2 * Radius + 1 shifted rows directly, which
+///        is cheaper than the 3 comparisons and the scratch traffic of the
+///        van Herk/Gil-Werman passes, larger ones use them. Instantiated for
+///        the NMS radii of the specialized pipelines, see harrispipeline.cpp.
+template <int Radius>
+void maxFilterRow(const float* input, int begin, int end, float* output, float* scratch) noexcept;
+
+/// @brief Raises the maximum of each tile of @p tileSize columns to the
+///        maximum of the row over the columns of [begin, end) it covers.
+/// @param input    Row, indexed by image column, read on [begin, end).
+/// @param begin    First column.
+/// @param end      One past the last column.
+/// @param tileSize Tile width, > 0. Tile t covers the columns
+///                 [t * tileSize, (t + 1) * tileSize).
+/// @param tileMax  Maxima, indexed by tile, updated in place.
+void tileMaxRow(const float* input, int begin, int end, int tileSize, float* tileMax) noexcept;
+
+/// @brief Sub-pixel location of a corner from the gradients around it, by
+///        gradient-orthogonality iteration (as cv::cornerSubPix()): the
+///        vector from the corner to any nearby edge pixel is orthogonal to the
+///        gradient there, which gives a 2x2 least-squares system solved in a
+///        window re-centred on the estimate at each iteration.
+/// @param gradX         X derivative plane.
+/// @param gradY         Y derivative plane.
+/// @param x             Initial column.
+/// @param y             Initial row.
+/// @param weights       Window weights, the 2D ones are the outer product of
+///                      the taps and the window offset is their radius.
+/// @param maxIterations Iterations at most.
+/// @param epsilon       Stops once the estimate moves less than this, in pixels.
+/// @param refinedX      Refined column, pixel centres are at integer values.
+/// @param refinedY      Refined row.
+/// @return False, leaving the outputs untouched, if the window leaves the
+///         image, the system is singular (e.g. on a straight edge) or the
+///         estimate drifts further than the window offset.
+bool refineCorner(
+  const ImageView<const float>& gradX,
+  const ImageView<const float>& gradY,
+  float x,
+  float y,
+  const GaussianKernel& weights,
+  int maxIterations,
+  float epsilon,
+  float& refinedX,
+  float& refinedY
+) noexcept;
+
+/// @brief Harris response a*c - b*b - k*(a + c)^2 of a row of tensor sums.
+void harrisResponseRow(
+  const float* sumDxdx,
+  const float* sumDxdy,
+  const float* sumDydy,
+  float k,
+  int count,
+  float* response
+) noexcept;
+
+} // namespace harris
+
+#endif //HARRISKERNELS_H
@@ -0,0 +1,309 @@
+/// @file harrispipeline.cpp
+/// @brief source file for harrispipeline
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#include "harrispipeline.hpp"
+#include "harriskernels.hpp"
+#include <algorithm>
+
+namespace harris {
+
+namespace {
+
+// Window radius of the structure tensor, as set by BasicTensorAccumulator::reset()
+int windowRadius(const HarrisParameters& params) noexcept
+{
+    return params.tensorWeighting == TensorWeighting::Gaussian
+        ? static_cast<int>(params.sigma)
+        : std::max(params.windowOffset, 0);
+}
+
+} // namespace
+
+template <typename Precision>
+void reserveWorkspace(BasicPipelineWorkspace<Precision>& workspace, const int width, const HarrisParameters& params)
+{
+    const int nmsOffset = std::max(params.nmsWindowOffset, 0);
+    const int ringRows = 2 * nmsOffset + 1;
+    if (workspace.gradX.size() < static_cast<std::size_t>(width)) {
+        workspace.gradX.resize(width);
+        workspace.gradY.resize(width);
+        workspace.sobelScratch.resize(2 * width);
+        for (int product = 0; product < 3; ++product) {
+            workspace.products[product].resize(width);
+            workspace.sums[product].resize(width);
+        }
+    }
+    if (workspace.responseRing.width() < width || workspace.responseRing.height() != ringRows) {
+        workspace.responseRing.resize(width, ringRows);
+        workspace.rowMaxRing.resize(width, ringRows);
+    }
+    const std::size_t maxFilterScratch = 2 * static_cast<std::size_t>(width + 2 * nmsOffset);
+    if (workspace.maxFilterScratch.size() < maxFilterScratch) {
+        workspace.maxFilterScratch.resize(maxFilterScratch);
+    }
+}
+
+template void reserveWorkspace<FloatPrecision>(BasicPipelineWorkspace<FloatPrecision>&, const int, const HarrisParameters&);
+template void reserveWorkspace<FixedPointPrecision>(BasicPipelineWorkspace<FixedPointPrecision>&, const int, const HarrisParameters&);
+
+template <typename Precision, int WindowRadius, int NmsRadius>
+void detectRegion(
+    const ImageView<const uint8_t>& image,
+    const ImageRect& region,
+    const HarrisParameters& params,
+    BasicPipelineWorkspace<Precision>& workspace,
+    RegionResult& result
+    ) noexcept
+{
+    using Gradient = typename Precision::Gradient;
+    using Product = typename Precision::Product;
+
+    if ((WindowRadius >= 0 && WindowRadius != windowRadius(params))
+        || (NmsRadius >= 0 && NmsRadius != std::max(params.nmsWindowOffset, 0))) {
+        detectRegion(image, region, params, workspace, result);
+        return;
+    }
+
+    result.candidates.clear();
+    result.maxResponse = 0.0F;
+    result.maxX = -1;
+    result.maxY = -1;
+    result.tileMax.clear();
+
+    const int height = image.height();
+    const int width = image.width();
+    // Compile-time constants in the specializations, which unrolls the loops
+    // over the windows and turns the ring index modulos into multiplications
+    const int nmsOffset = NmsRadius >= 0 ? NmsRadius : std::max(params.nmsWindowOffset, 0);
+
+    // Requested pixels clipped to the image
+    const int regionX0 = std::max(region.x, 0);
+    const int regionY0 = std::max(region.y, 0);
+    const int regionX1 = std::min(region.x + region.width, width);
+    const int regionY1 = std::min(region.y + region.height, height);
+    if (regionX0 >= regionX1 || regionY0 >= regionY1) {
+        return;
+    }
+    // Adaptive threshold tiles overlapped by the region
+    const int tileSize = std::max(params.thresholdTileSize, 0);
+    const int tileColumns = tileSize > 0 ? (width + tileSize - 1) / tileSize : 0;
+    if (tileSize > 0) {
+        result.tileRowBegin = regionY0 / tileSize;
+        const int tileRows = (regionY1 - 1) / tileSize - result.tileRowBegin + 1;
+        result.tileMax.assign(static_cast<std::size_t>(tileColumns) * tileRows, 0.0F);
+    }
+    // Response rows/columns to compute, i.e. the region plus the NMS halo
+    const int colBegin = std::max(regionX0 - nmsOffset, 0);
+    const int colEnd = std::min(regionX1 + nmsOffset, width);
+    const int rowBegin = std::max(regionY0 - nmsOffset, 0);
+    const int rowEnd = std::min(regionY1 + nmsOffset, height);
+    // NMS centres, the window must fit in the image as in nonMaximalSuppression()
+    const int nmsX0 = std::max(regionX0, nmsOffset);
+    const int nmsX1 = std::min(regionX1, width - nmsOffset);
+    const int nmsY0 = std::max(regionY0, nmsOffset);
+    const int nmsY1 = std::min(regionY1, height - nmsOffset);
+    // Interior columns where the Sobel operator is defined
+    const int interiorBegin = std::max(colBegin, 1);
+    const int interiorEnd = std::min(colEnd, width - 1);
+
+    // Structure tensor window, its halo is added on top of the NMS one
+    const GaussianKernel* kernel = nullptr;
+    if (params.tensorWeighting == TensorWeighting::Gaussian) {
+        if (workspace.gaussianKernel.taps.empty() || workspace.gaussianKernel.sigma != params.sigma) {
+            workspace.gaussianKernel = makeGaussianKernel(params.sigma);
+        }
+        kernel = &workspace.gaussianKernel;
+    }
+    workspace.tensor.reset(width, colBegin, colEnd, params.windowOffset, kernel);
+    const int radius = WindowRadius >= 0 ? WindowRadius : workspace.tensor.radius();
+    // Columns whose products are read by the window
+    const int productBegin = std::max(colBegin - radius, 0);
+    const int productEnd = std::min(colEnd + radius, width);
+    const int sobelBegin = std::max(productBegin, 1);
+    const int sobelEnd = std::min(productEnd, width - 1);
+
+    const int ringRows = 2 * nmsOffset + 1;
+    reserveWorkspace(workspace, width, params);
+    Gradient* gradX = workspace.gradX.data();
+    Gradient* gradY = workspace.gradY.data();
+    Product* dxdx = workspace.products[0].data();
+    Product* dxdy = workspace.products[1].data();
+    Product* dydy = workspace.products[2].data();
+    // Gradients are zero on the image border
+    for (int x : {0, width - 1}) {
+        if (x >= productBegin && x < productEnd) {
+            dxdx[x] = Product{0};
+            dxdy[x] = Product{0};
+            dydy[x] = Product{0};
+        }
+    }
+
+    for (int t = rowBegin - radius; t < rowEnd + radius; ++t) {
+        // 1.) Gradients and structure tensor products of row t
+        if (t >= 1 && t < height - 1 && sobelBegin < sobelEnd) {
+            sobelRow(image, t, sobelBegin, sobelEnd, gradX, gradY, workspace.sobelScratch.data());
+            for (int x = sobelBegin; x < sobelEnd; ++x) {
+                const Product gx = gradX[x];
+                const Product gy = gradY[x];
+                dxdx[x] = gx * gx;
+                dxdy[x] = gx * gy;
+                dydy[x] = gy * gy;
+            }
+            workspace.tensor.template pushRow<WindowRadius>(dxdx, dxdy, dydy);
+        } else {
+            workspace.tensor.template pushRow<WindowRadius>(nullptr, nullptr, nullptr);
+        }
+        if (!workspace.tensor.ready()) continue;
+
+        // 2.) Corner response of row y, whose window is now complete
+        const int y = t - radius;
+        float* response = workspace.responseRing.row(y % ringRows);
+        std::fill(response + colBegin, response + colEnd, 0.0F);
+        if (y >= 1 && y < height - 1 && interiorBegin < interiorEnd) {
+            workspace.tensor.template windowSums<WindowRadius>(
+                workspace.sums[0].data(), workspace.sums[1].data(), workspace.sums[2].data()
+                );
+            harrisResponseRow(
+                workspace.sums[0].data() + interiorBegin,
+                workspace.sums[1].data() + interiorBegin,
+                workspace.sums[2].data() + interiorBegin,
+                params.k, interiorEnd - interiorBegin, response + interiorBegin
+                );
+        }
+        if (y >= regionY0 && y < regionY1) {
+            for (int x = regionX0; x < regionX1; ++x) {
+                if (response[x] > result.maxResponse) {
+                    result.maxResponse = response[x];
+                    result.maxX = x;
+                    result.maxY = y;
+                }
+            }
+            if (tileSize > 0) {
+                float* tileMax = result.tileMax.data() + static_cast<std::size_t>(y / tileSize - result.tileRowBegin) * tileColumns;
+                tileMaxRow(response, regionX0, regionX1, tileSize, tileMax);
+            }
+        }
+
+        // 3.) Horizontal sliding maximum of row y
+        float* rowMax = workspace.rowMaxRing.row(y % ringRows);
+        if (NmsRadius >= 0) {
+            maxFilterRow<std::max(NmsRadius, 0)>(response, colBegin, colEnd, rowMax, workspace.maxFilterScratch.data());
+        } else {
+            maxFilterRow(response, colBegin, colEnd, nmsOffset, rowMax, workspace.maxFilterScratch.data());
+        }
+
+        // 4.) Non-maximal suppression of the row whose window is now complete,
+        //     the vertical pass of the max filter is only run on candidates
+        const int center = y - nmsOffset;
+        if (center < nmsY0 || center >= nmsY1) {
+            continue;
+        }
+        const float* centerRow = workspace.responseRing.row(center % ringRows);
+        for (int x = nmsX0; x < nmsX1; ++x) {
+            const float value = centerRow[x];
+            if (!(value > 0.0F)) continue; // Only positive responses can pass the threshold
+
+            bool isMaximum = true;
+            for (int j = -nmsOffset; j <= nmsOffset; ++j) {
+                if (workspace.rowMaxRing((center + j) % ringRows, x) > value) {
+                    isMaximum = false;
+                    break;
+                }
+            }
+            if (isMaximum) {
+                result.candidates.push_back(HarrisCandidate{x, center, value});
+            }
+        }
+    }
+}
+
+// Specialized configurations: (window radius, NMS radius)
+// - (1, 1): HarrisParameters defaults, i.e. the stream and batch modes, and
+//   the Gaussian window of sigma 1
+// - (1, 2), (2, 2): the same with a 5x5 NMS window, or sigma 2
+// - (2, 10): chessboard grid recovery of app/main.cpp
+// The accumulator and maxFilterRow() are instantiated for these radii in
+// harriskernels.cpp.
+template <typename Precision>
+DetectRegionFunction<Precision> selectDetectRegion(const HarrisParameters& params) noexcept
+{
+    struct Specialization
+    {
+        int windowRadius;
+        int nmsRadius;
+        DetectRegionFunction<Precision> function;
+    };
+    static const Specialization kSpecializations[] = {
+        {1, 1, &detectRegion<Precision, 1, 1>},
+        {1, 2, &detectRegion<Precision, 1, 2>},
+        {2, 2, &detectRegion<Precision, 2, 2>},
+        {2, 10, &detectRegion<Precision, 2, 10>},
+    };
+    const int nmsRadius = std::max(params.nmsWindowOffset, 0);
+    for (const Specialization& specialization : kSpecializations) {
+        if (specialization.windowRadius == windowRadius(params) && specialization.nmsRadius == nmsRadius) {
+            return specialization.function;
+        }
+    }
+    return &detectRegion<Precision>;
+}
+
+#define HARRIS_INSTANTIATE_DETECT_REGION(Precision, WindowRadius, NmsRadius) \
+    template void detectRegion<Precision, WindowRadius, NmsRadius>( \
+        const ImageView<const uint8_t>&, const ImageRect&, const HarrisParameters&, \
+        BasicPipelineWorkspace<Precision>&, RegionResult& \
+        ) noexcept;
+HARRIS_INSTANTIATE_DETECT_REGION(FloatPrecision, kDynamicRadius, kDynamicRadius)
+HARRIS_INSTANTIATE_DETECT_REGION(FloatPrecision, 1, 1)
+HARRIS_INSTANTIATE_DETECT_REGION(FloatPrecision, 1, 2)
+HARRIS_INSTANTIATE_DETECT_REGION(FloatPrecision, 2, 2)
+HARRIS_INSTANTIATE_DETECT_REGION(FloatPrecision, 2, 10)
+HARRIS_INSTANTIATE_DETECT_REGION(FixedPointPrecision, kDynamicRadius, kDynamicRadius)
+HARRIS_INSTANTIATE_DETECT_REGION(FixedPointPrecision, 1, 1)
+HARRIS_INSTANTIATE_DETECT_REGION(FixedPointPrecision, 1, 2)
+HARRIS_INSTANTIATE_DETECT_REGION(FixedPointPrecision, 2, 2)
+HARRIS_INSTANTIATE_DETECT_REGION(FixedPointPrecision, 2, 10)
+#undef HARRIS_INSTANTIATE_DETECT_REGION
+
+template DetectRegionFunction<FloatPrecision> selectDetectRegion<FloatPrecision>(const HarrisParameters&) noexcept;
+template DetectRegionFunction<FixedPointPrecision> selectDetectRegion<FixedPointPrecision>(const HarrisParameters&) noexcept;
+
+void keepStrongest(std::vector<HarrisCandidate>& candidates, const int maxCorners, std::vector<int>& heap)
+{
+    if (maxCorners <= 0 || candidates.size() <= static_cast<std::size_t>(maxCorners)) {
+        return;
+    }
+    // Heap of candidate indices with the weakest kept candidate on top. A
+    // later candidate is weaker than an earlier one with the same response.
+    auto stronger = [&candidates](int lhs, int rhs) {
+        if (candidates[lhs].response != candidates[rhs].response) {
+            return candidates[lhs].response > candidates[rhs].response;
+        }
+        return lhs < rhs;
+    };
+    heap.clear();
+    for (int index = 0; index < static_cast<int>(candidates.size()); ++index) {
+        if (static_cast<int>(heap.size()) < maxCorners) {
+            heap.push_back(index);
+            std::push_heap(heap.begin(), heap.end(), stronger);
+        } else if (candidates[index].response > candidates[heap.front()].response) {
+            std::pop_heap(heap.begin(), heap.end(), stronger);
+            heap.back() = index;
+            std::push_heap(heap.begin(), heap.end(), stronger);
+        }
+    }
+
+    // Compact the survivors, in their original order
+    std::sort(heap.begin(), heap.end());
+    for (std::size_t i = 0; i < heap.size(); ++i) {
+        candidates[i] = candidates[heap[i]];
+    }
+    candidates.resize(heap.size());
+}
+
+} // namespace harris
@@ -0,0 +1,154 @@
+/// @file harrispipeline.hpp
+/// @brief Fused Harris pipeline working on a small ring of row buffers
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#ifndef HARRISPIPELINE_H
+#define HARRISPIPELINE_H
+
+#include <cstdint>
+#include <vector>
+#include "image.hpp"
+#include "harristypes.hpp"
+#include "harriskernels.hpp"
+#include "harrisprecision.hpp"
+
+namespace harris {
+
+/// @brief Row buffers reused by detectRegion(), sized on first use. A workspace
+///        must not be shared by two concurrent calls.
+/// @tparam Precision Arithmetic of the gradients and of the structure tensor,
+///                   see harrisprecision.hpp.
+template <typename Precision>
+struct BasicPipelineWorkspace
+{
+  // Vertical pass rows of the separable Sobel operator, 2 * width
+  std::vector<typename Precision::Gradient> sobelScratch;
+  // Gradient rows, width
+  std::vector<typename Precision::Gradient> gradX;
+  std::vector<typename Precision::Gradient> gradY;
+  // Structure tensor products of one row, width
+  std::vector<typename Precision::Product> products[3];
+  // Windowed sums of the products, width
+  std::vector<float> sums[3];
+  // Window accumulation of the structure tensor
+  BasicTensorAccumulator<Precision> tensor;
+  // Gaussian weights, rebuilt only when sigma changes
+  GaussianKernel gaussianKernel;
+  // Last 2 * nmsWindowOffset + 1 rows of the corner response, and of its
+  // horizontal sliding maximum
+  Image<float> responseRing;
+  Image<float> rowMaxRing;
+  // Scratch of maxFilterRow()
+  std::vector<float> maxFilterScratch;
+};
+
+// Workspace of HarrisChessCornersDetector::detect()
+using PipelineWorkspace = BasicPipelineWorkspace<DefaultPrecision>;
+
+/// @brief Sizes the row buffers of @p workspace for images up to @p width
+///        columns and the NMS window of @p params. detectRegion() does it on
+///        demand, calling it beforehand with the widest image to come avoids
+///        any allocation in the detections. The buffers only grow.
+template <typename Precision>
+void reserveWorkspace(BasicPipelineWorkspace<Precision>& workspace, const int width, const HarrisParameters& params);
+
+/// @brief Output of detectRegion().
+struct RegionResult
+{
+  // Positive local maxima of the response, in row-major order
+  std::vector<HarrisCandidate> candidates;
+  // Maximum response inside the region and its location, first = x, second = y
+  float maxResponse{0.0F};
+  int maxX{-1};
+  int maxY{-1};
+  // Maximum response inside the region of each adaptive threshold tile, see
+  // HarrisParameters::thresholdTileSize, row-major over the tile rows the
+  // region overlaps, from tile row tileRowBegin, and every tile column of the
+  // frame. Empty when the tiles are disabled.
+  std::vector<float> tileMax;
+  int tileRowBegin{0};
+};
+
+/// @brief Runs Sobel -> structure tensor -> response -> non-maximal
+///        suppression in a single sweep over @p region. Each response row is
+///        computed once and kept only while the NMS window needs it, so no
+///        full-frame plane is ever written.
+///
+/// With FloatPrecision the response is identical to the one of the staged API,
+/// with FixedPointPrecision it is too for box windows up to an offset of 22.
+/// Only pixels in
+/// @p region are reported, so adjacent regions (e.g. bands) can be processed
+/// independently and concatenated. Thresholding is left to the caller, as it
+/// depends on the maximum of the whole frame, or of the tiles merged from
+/// every region, see tileThreshold().
+/// @param image     Grayscale image.
+/// @param region    Pixels to report, the neighbourhood needed by the filters
+///                  (the halo) is read from @p image around it.
+/// @param params    Detection parameters.
+/// @param workspace Reusable row buffers.
+/// @param result    Cleared, then filled with the region detections.
+/// @tparam Precision    FloatPrecision, whose response is the one of the
+///                      staged API, or FixedPointPrecision.
+/// @tparam WindowRadius Structure tensor window radius, i.e. windowOffset or
+///                      int(sigma), if known at compile time. The Gaussian taps
+///                      are then unrolled.
+/// @tparam NmsRadius    nmsWindowOffset if known at compile time. The NMS
+///                      window is then unrolled.
+///
+/// The radii known at compile time must match @p params, a mismatch falls back
+/// to the generic sweep. Only the configurations listed in harrispipeline.cpp
+/// are instantiated, see selectDetectRegion() to pick one at run time.
+template <typename Precision, int WindowRadius = kDynamicRadius, int NmsRadius = kDynamicRadius>
+void detectRegion(
+  const ImageView<const uint8_t>& image,
+  const ImageRect& region,
+  const HarrisParameters& params,
+  BasicPipelineWorkspace<Precision>& workspace,
+  RegionResult& result
+) noexcept;
+
+/// @brief Signature of the detectRegion() instantiations.
+template <typename Precision>
+using DetectRegionFunction = void (*)(
+  const ImageView<const uint8_t>&,
+  const ImageRect&,
+  const HarrisParameters&,
+  BasicPipelineWorkspace<Precision>&,
+  RegionResult&
+);
+
+/// @brief Picks the detectRegion() specialized for the radii of @p params,
+///        or the generic one if there is none. The specializations return the
+///        same detections as the generic sweep, except that with
+///        HARRIS_NATIVE_ARCH the compiler may fuse the unrolled Gaussian taps
+///        into FMAs differently, which changes the last bits of the float
+///        response.
+template <typename Precision>
+DetectRegionFunction<Precision> selectDetectRegion(const HarrisParameters& params) noexcept;
+
+/// @brief Threshold of the corners of a tile of maximum response @p tileMax,
+///        thresholdPercent of it but not below thresholdFloorPercent of the
+///        maximum response of the frame @p frameMax.
+inline float tileThreshold(const HarrisParameters& params, const float tileMax, const float frameMax) noexcept
+{
+  const float threshold = params.thresholdPercent * tileMax;
+  const float floor = params.thresholdFloorPercent * frameMax;
+  return threshold > floor ? threshold : floor;
+}
+
+/// @brief Keeps the @p maxCorners strongest candidates, using a bounded
+///        min-heap of that size. Among equal responses the first one in
+///        row-major order wins, and the survivors keep their original order, so
+///        the output is reproducible.
+/// @param candidates Candidates in row-major order, filtered in place.
+/// @param maxCorners Number of candidates to keep, 0 or less keeps all of them.
+/// @param heap       Scratch storage for the heap.
+void keepStrongest(std::vector<HarrisCandidate>& candidates, const int maxCorners, std::vector<int>& heap);
+
+} // namespace harris
+
+#endif //HARRISPIPELINE_H
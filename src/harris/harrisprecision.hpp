@@ -0,0 +1,56 @@
+/// @file harrisprecision.hpp
+/// @brief Arithmetic policies of the fused Harris pipeline
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#ifndef HARRISPRECISION_H
+#define HARRISPRECISION_H
+
+#include <cstdint>
+
+namespace harris {
+
+/// @brief Float gradients and products, summed in double precision. This is
+///        the reference arithmetic, the one of the staged API.
+struct FloatPrecision
+{
+  // Sobel derivatives
+  using Gradient = float;
+  // Structure tensor products dx*dx, dx*dy and dy*dy
+  using Product = float;
+  // Windowed sums of the products
+  using Accumulator = double;
+
+  static const char* name() noexcept { return "float"; }
+};
+
+/// @brief Integer arithmetic for CPUs where float throughput or memory
+///        bandwidth is the bottleneck. The Sobel derivatives of 8-bit pixels
+///        lie in [-1020, 1020], so they are exact in int16 and their products
+///        in int32. Box window sums are exact as well up to a window offset
+///        of 22, larger windows drop the low bits of the products first.
+///        Gaussian weights are rounded to 8 fractional bits. The buffers of
+///        the pipeline are half the size of the float ones.
+struct FixedPointPrecision
+{
+  using Gradient = int16_t;
+  using Product = int32_t;
+  using Accumulator = int32_t;
+
+  static const char* name() noexcept { return "fixed"; }
+};
+
+// Policy of HarrisChessCornersDetector::detect(), picked by the
+// HARRIS_FIXED_POINT build option
+#if defined(HARRIS_FIXED_POINT)
+using DefaultPrecision = FixedPointPrecision;
+#else
+using DefaultPrecision = FloatPrecision;
+#endif
+
+} // namespace harris
+
+#endif //HARRISPRECISION_H
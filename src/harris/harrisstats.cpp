@@ -0,0 +1,66 @@
+/// @file harrisstats.cpp
+/// @brief source file for harrisstats
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#include "harrisstats.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+double nearestRank(const std::vector<double>& samples, double percentile, std::vector<double>& scratch)
+{
+    if (samples.empty()) {
+        return 0.0;
+    }
+    const double clamped = std::min(std::max(percentile, 0.0), 100.0);
+    const std::size_t rank = static_cast<std::size_t>(std::ceil(clamped / 100.0 * static_cast<double>(samples.size())));
+    const std::size_t index = rank > 0U ? rank - 1U : 0U;
+    scratch.assign(samples.begin(), samples.end());
+    std::nth_element(scratch.begin(), scratch.begin() + static_cast<std::ptrdiff_t>(index), scratch.end());
+    return scratch[index];
+}
+
+} // namespace
+
+double HarrisFrameStats::totalMs() const noexcept
+{
+    double total = 0.0;
+    for (const auto& stage : stages) {
+        total += stage.wallMs;
+    }
+    return total;
+}
+
+void HarrisStatsAggregator::add(const HarrisFrameStats& frame)
+{
+    for (int stage = 0; stage < kHarrisStageCount; ++stage) {
+        if (frame.stages[stage].calls == 0U) continue;
+        m_wallMs[stage].push_back(frame.stages[stage].wallMs);
+        m_maxAllocations[stage] = std::max(m_maxAllocations[stage], frame.stages[stage].allocations);
+    }
+    m_totalMs.push_back(frame.totalMs());
+}
+
+void HarrisStatsAggregator::clear() noexcept
+{
+    for (int stage = 0; stage < kHarrisStageCount; ++stage) {
+        m_wallMs[stage].clear();
+        m_maxAllocations[stage] = 0U;
+    }
+    m_totalMs.clear();
+}
+
+double HarrisStatsAggregator::percentileMs(HarrisStage stage, double percentile) const
+{
+    return nearestRank(m_wallMs[static_cast<int>(stage)], percentile, m_scratch);
+}
+
+double HarrisStatsAggregator::totalPercentileMs(double percentile) const
+{
+    return nearestRank(m_totalMs, percentile, m_scratch);
+}
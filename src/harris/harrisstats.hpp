@@ -0,0 +1,168 @@
+/// @file harrisstats.hpp
+/// @brief Per-frame instrumentation of the Harris detector stages
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#ifndef HARRISSTATS_H
+#define HARRISSTATS_H
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+#include "image.hpp"
+
+/// @brief Instrumented stages, the staged API ones followed by the fused one
+///        and the optional refinement.
+enum class HarrisStage
+{
+  // computeGradients()
+  Gradients,
+  // cornerResponse_method1() and cornerResponse_method2()
+  Response,
+  // thresholding()
+  Thresholding,
+  // nonMaximalSuppression()
+  Suppression,
+  // detect(), every stage in a single sweep
+  Fused,
+  // refineCorners()
+  Refinement
+};
+
+constexpr int kHarrisStageCount = 6;
+
+/// @brief Measurements of one stage, accumulated over its calls in the frame.
+struct HarrisStageStats
+{
+  // Number of calls
+  std::size_t calls{0};
+  // Wall time, in milliseconds
+  double wallMs{0.0};
+  // Estimated bytes read and written in frame-sized planes and lists
+  std::size_t bytesTouched{0};
+  // Image buffers allocated, by any thread, while the stage ran
+  std::size_t allocations{0};
+};
+
+/// @brief Measurements of a frame, i.e. since the last computeGradients() or
+///        detect() call.
+///
+/// The staged API thresholds the whole response map before the non-maximal
+/// suppression, whereas detect() only thresholds the local maxima, so the
+/// counts of both steps depend on the mode:
+/// staged: response pixels -> thresholding -> candidates -> NMS -> corners
+/// fused:  response pixels -> NMS -> local maxima -> thresholding -> corners
+struct HarrisFrameStats
+{
+  HarrisStageStats stages[kHarrisStageCount];
+  // Elements entering and leaving the thresholding
+  std::size_t thresholdInput{0};
+  std::size_t thresholdOutput{0};
+  // Elements entering and leaving the non-maximal suppression
+  std::size_t suppressionInput{0};
+  std::size_t suppressionOutput{0};
+  // Corners reported, i.e. after keeping the strongest ones
+  std::size_t corners{0};
+
+  HarrisStageStats& stage(HarrisStage stage) noexcept { return stages[static_cast<int>(stage)]; }
+  const HarrisStageStats& stage(HarrisStage stage) const noexcept { return stages[static_cast<int>(stage)]; }
+
+  /// @brief Wall time of every stage of the frame, in milliseconds.
+  double totalMs() const noexcept;
+};
+
+/// @brief Collects the statistics of many frames to report percentiles, e.g.
+///        p50 and p99 to spot latency spikes.
+class HarrisStatsAggregator final
+{
+public:
+  // Default constructor.
+  HarrisStatsAggregator() = default;
+  // Default copy constructor.
+  HarrisStatsAggregator(const HarrisStatsAggregator&) = default;
+  // Default copy assignment operator.
+  HarrisStatsAggregator& operator=(const HarrisStatsAggregator&) = default;
+  // Default move constructor.
+  HarrisStatsAggregator(HarrisStatsAggregator&&) = default;
+  // Default move assignment operator.
+  HarrisStatsAggregator& operator=(HarrisStatsAggregator&&) = default;
+  // Default destructor.
+  ~HarrisStatsAggregator() = default;
+
+  /// @brief Adds a frame, stages that did not run in it are ignored.
+  void add(const HarrisFrameStats& frame);
+
+  /// @brief Forgets every frame added so far.
+  void clear() noexcept;
+
+  /// @brief Number of frames added.
+  std::size_t frames() const noexcept { return m_totalMs.size(); }
+
+  /// @brief Nearest-rank percentile of the wall time of a stage.
+  /// @param stage      Stage of interest.
+  /// @param percentile In [0, 100], e.g. 50 for the median.
+  /// @return Milliseconds, 0 if the stage never ran.
+  double percentileMs(HarrisStage stage, double percentile) const;
+
+  /// @brief Nearest-rank percentile of the total wall time of the frames.
+  double totalPercentileMs(double percentile) const;
+
+  /// @brief Highest allocation count of a stage in a single frame.
+  std::size_t maxAllocations(HarrisStage stage) const noexcept { return m_maxAllocations[static_cast<int>(stage)]; }
+
+private:
+  std::vector<double> m_wallMs[kHarrisStageCount];
+  std::vector<double> m_totalMs;
+  std::size_t m_maxAllocations[kHarrisStageCount]{};
+  // Partially sorted copy of the samples of a percentile query
+  mutable std::vector<double> m_scratch;
+};
+
+namespace harris {
+
+/// @brief Adds the wall time and the allocations of its scope to a stage.
+class ScopedStageTimer final
+{
+public:
+  explicit ScopedStageTimer(HarrisStageStats& stats) noexcept
+    : m_stats(stats),
+      m_start(std::chrono::steady_clock::now()),
+      m_allocations(imageAllocationCount())
+  {
+  }
+  // Non copyable, the scope is measured once.
+  ScopedStageTimer(const ScopedStageTimer&) = delete;
+  // Non copyable.
+  ScopedStageTimer& operator=(const ScopedStageTimer&) = delete;
+
+  ~ScopedStageTimer()
+  {
+    ++m_stats.calls;
+    m_stats.wallMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count();
+    m_stats.allocations += imageAllocationCount() - m_allocations;
+  }
+
+private:
+  HarrisStageStats& m_stats;
+  std::chrono::steady_clock::time_point m_start;
+  std::size_t m_allocations;
+};
+
+} // namespace harris
+
+// The instrumentation compiles to nothing unless HARRIS_INSTRUMENTATION is
+// defined, see the HARRIS_ENABLE_INSTRUMENTATION CMake option.
+#ifdef HARRIS_INSTRUMENTATION
+/// @brief Times the rest of the enclosing scope into @p stageStats.
+#define HARRIS_STAGE_TIMER(stageStats) harris::ScopedStageTimer harrisStageTimer_(stageStats)
+/// @brief Evaluates its arguments as statements, e.g. to update a counter.
+#define HARRIS_STATS(...) __VA_ARGS__
+#else
+#define HARRIS_STAGE_TIMER(stageStats) static_cast<void>(0)
+#define HARRIS_STATS(...) static_cast<void>(0)
+#endif
+
+#endif //HARRISSTATS_H
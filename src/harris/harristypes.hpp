@@ -0,0 +1,77 @@
+/// @file harristypes.hpp
+/// @brief Parameters and result types shared by the Harris pipeline stages
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#ifndef HARRISTYPES_H
+#define HARRISTYPES_H
+
+/// @brief Weighting of the structure tensor products inside the window.
+enum class TensorWeighting
+{
+  // Plain sum over the (2 * windowOffset + 1)^2 window, constant cost per pixel
+  Box,
+  // Gaussian weights of standard deviation sigma, i.e. radius int(sigma)
+  Gaussian
+};
+
+/// @brief Parameters of a complete detection, see the matching arguments of
+///        the staged API in HarrisChessCornersDetector.
+struct HarrisParameters
+{
+  // Gaussian filter standard deviation.
+  float sigma{1.0F};
+  // Harris corner detector constant, typically in [0.04, 0.06].
+  float k{0.04F};
+  // Offset of the structure tensor window around the pixel of interest.
+  int windowOffset{1};
+  // Weighting of the structure tensor window, Gaussian ignores windowOffset.
+  TensorWeighting tensorWeighting{TensorWeighting::Box};
+  // Threshold as a percentage of the maximum response, in (0, 1).
+  float thresholdPercent{0.5F};
+  // Side of the square tiles of the adaptive threshold, in pixels. 0 compares
+  // every corner with the maximum response of the frame. Otherwise a corner
+  // is compared with the maximum of its tile, measured while the response is
+  // computed, so that dim parts of an unevenly lit frame keep their corners.
+  int thresholdTileSize{0};
+  // Lower bound of the tile thresholds as a percentage of the maximum response
+  // of the frame, in [0, 1), which keeps flat tiles from reporting noise.
+  float thresholdFloorPercent{0.01F};
+  // Offset of the non-maximal suppression window, i.e. 1 => 3x3.
+  int nmsWindowOffset{1};
+  // Keep only the strongest corners, 0 keeps all of them.
+  int maxCorners{0};
+  // Pyramid levels below the full resolution, 0 disables the pyramid. The
+  // corners are detected at 1 / 2^pyramidLevels scale, then relocated at each
+  // finer level. Levels smaller than 32x32 pixels are skipped.
+  int pyramidLevels{0};
+  // Offset of the relocation window, in pixels of the finer level, around the
+  // 2x2 block a corner of the coarser level projects to.
+  int pyramidSearchOffset{2};
+  // Frames between two full frame detections of the tracking mode, see
+  // HarrisChessCornersDetector::track(). 1 or less detects every frame in full.
+  int keyframeInterval{30};
+  // Offset of the search window around the predicted location of each tracked
+  // corner, i.e. the largest motion between two frames once the motion of the
+  // previous frame is compensated.
+  int trackingSearchOffset{8};
+  // Tracking is lost, and the frame detected in full, when fewer than this
+  // fraction of the keyframe corners are found, in [0, 1].
+  float trackingMinRatio{0.9F};
+};
+
+/// @brief Local maximum of the corner response map.
+struct HarrisCandidate
+{
+  // Column
+  int x{0};
+  // Row
+  int y{0};
+  // Corner response at (x, y)
+  float response{0.0F};
+};
+
+#endif //HARRISTYPES_H
@@ -0,0 +1,264 @@
+/// @file image.hpp
+/// @brief Contiguous, row-strided image owner and non-owning view types
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#ifndef IMAGE_H
+#define IMAGE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/// @brief Default row alignment in bytes, i.e. one cache line which is also
+///        enough for any SSE/AVX/NEON load.
+constexpr std::size_t kImageAlignment = 64U;
+
+/// @brief Axis aligned rectangle [x, x + width) x [y, y + height) in pixels.
+struct ImageRect
+{
+  int x{0};
+  int y{0};
+  int width{0};
+  int height{0};
+};
+
+/// @brief Counter of the Image buffers allocated by any thread. Always
+///        updated, the relaxed increment is negligible next to the malloc(),
+///        so the allocation tests see the buffers in every build.
+inline std::atomic<std::size_t>& imageAllocationCounter() noexcept
+{
+  static std::atomic<std::size_t> counter{0U};
+  return counter;
+}
+
+/// @brief Image buffers allocated so far.
+inline std::size_t imageAllocationCount() noexcept
+{
+  return imageAllocationCounter().load(std::memory_order_relaxed);
+}
+
+/// @brief Minimal allocator returning memory aligned to @p Alignment bytes, so
+///        that std::vector can be used as the storage of Image.
+template <typename T, std::size_t Alignment = kImageAlignment>
+class AlignedAllocator
+{
+public:
+  using value_type = T;
+
+  template <typename U>
+  struct rebind
+  {
+    using other = AlignedAllocator<U, Alignment>;
+  };
+
+  AlignedAllocator() noexcept = default;
+  template <typename U>
+  AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+  T* allocate(std::size_t n)
+  {
+    // Over-allocate and keep the original pointer right before the aligned block
+    const std::size_t bytes = n * sizeof(T) + Alignment + sizeof(void*);
+    void* raw = std::malloc(bytes);
+    if (raw == nullptr) {
+      throw std::bad_alloc();
+    }
+    std::uintptr_t start = reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*);
+    std::uintptr_t aligned = (start + Alignment - 1U) & ~(static_cast<std::uintptr_t>(Alignment) - 1U);
+    reinterpret_cast<void**>(aligned)[-1] = raw;
+    imageAllocationCounter().fetch_add(1U, std::memory_order_relaxed);
+    return reinterpret_cast<T*>(aligned);
+  }
+
+  void deallocate(T* p, std::size_t) noexcept
+  {
+    if (p != nullptr) {
+      std::free(reinterpret_cast<void**>(p)[-1]);
+    }
+  }
+
+  template <typename U>
+  bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+  template <typename U>
+  bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+};
+
+/// @brief Non-owning view over a 2D plane whose rows are @p stride elements
+///        apart. Pixel (row, col) lives at data()[row * stride + col].
+template <typename T>
+class ImageView
+{
+public:
+  // Default constructor, empty view.
+  ImageView() = default;
+
+  /// @brief Wraps an existing buffer.
+  /// @param data   Pointer to the first pixel of the first row.
+  /// @param width  Number of columns.
+  /// @param height Number of rows.
+  /// @param stride Distance between two consecutive rows, in elements. If 0
+  ///               the rows are considered tightly packed, i.e. stride = width.
+  ImageView(T* data, int width, int height, std::ptrdiff_t stride = 0) noexcept
+    : m_data(data), m_width(width), m_height(height), m_stride(stride == 0 ? width : stride)
+  {}
+
+  // Implicit conversion from a mutable view to a read-only one.
+  template <typename U, typename = typename std::enable_if<std::is_same<const U, T>::value>::type>
+  ImageView(const ImageView<U>& other) noexcept
+    : m_data(other.data()), m_width(other.width()), m_height(other.height()), m_stride(other.stride())
+  {}
+
+  T* data() const noexcept { return m_data; }
+  int width() const noexcept { return m_width; }
+  int height() const noexcept { return m_height; }
+  std::ptrdiff_t stride() const noexcept { return m_stride; }
+  bool empty() const noexcept { return m_data == nullptr || m_width <= 0 || m_height <= 0; }
+
+  T* row(int r) const noexcept { return m_data + r * m_stride; }
+  T& operator()(int r, int c) const noexcept { return m_data[r * m_stride + c]; }
+
+  /// @brief View over the rectangle [x, x + width) x [y, y + height), no copy.
+  ImageView subView(int x, int y, int width, int height) const noexcept
+  {
+    return ImageView(m_data + y * m_stride + x, width, height, m_stride);
+  }
+
+private:
+  T* m_data{nullptr};
+  int m_width{0};
+  int m_height{0};
+  std::ptrdiff_t m_stride{0};
+};
+
+/// @brief Owning 2D plane stored as a single aligned allocation.
+///
+/// Every allocated row (border included) starts on a kImageAlignment boundary
+/// and the image can be surrounded by a border of @p padding pixels on each
+/// side, addressable with negative (or past the end) coordinates, e.g. to
+/// avoid bound checks in filter kernels. Boolean maps should use uint8_t, as
+/// std::vector<bool> is not contiguous.
+template <typename T>
+class Image
+{
+public:
+  // Default constructor, empty image.
+  Image() = default;
+  // Default copy constructor.
+  Image(const Image&) = default;
+  // Default copy assignment operator.
+  Image& operator=(const Image&) = default;
+  // Move constructor, the source is left empty rather than with the shape
+  // of a buffer it no longer holds.
+  Image(Image&& other) noexcept
+    : m_buffer(std::move(other.m_buffer)),
+      m_width(std::exchange(other.m_width, 0)),
+      m_height(std::exchange(other.m_height, 0)),
+      m_padding(std::exchange(other.m_padding, 0)),
+      m_stride(std::exchange(other.m_stride, 0)),
+      m_origin(std::exchange(other.m_origin, 0))
+  {
+  }
+  // Move assignment operator, the source is left empty.
+  Image& operator=(Image&& other) noexcept
+  {
+    if (this != &other) {
+      m_buffer = std::move(other.m_buffer);
+      other.m_buffer.clear();
+      m_width = std::exchange(other.m_width, 0);
+      m_height = std::exchange(other.m_height, 0);
+      m_padding = std::exchange(other.m_padding, 0);
+      m_stride = std::exchange(other.m_stride, 0);
+      m_origin = std::exchange(other.m_origin, 0);
+    }
+    return *this;
+  }
+  // Default destructor.
+  ~Image() = default;
+
+  /// @brief Allocates a zero initialised image.
+  /// @param width   Number of columns.
+  /// @param height  Number of rows.
+  /// @param padding Border, in pixels, allocated around the image.
+  Image(int width, int height, int padding = 0)
+  {
+    resize(width, height, padding);
+  }
+
+  /// @brief Reshapes the image and sets every pixel (border included) to @p value.
+  void resize(int width, int height, int padding = 0, const T& value = T{})
+  {
+    m_width = width;
+    m_height = height;
+    m_padding = padding;
+    // Round the row length up so that every row starts aligned
+    constexpr std::ptrdiff_t elemsPerLine =
+      (kImageAlignment % sizeof(T) == 0U) ? static_cast<std::ptrdiff_t>(kImageAlignment / sizeof(T)) : 1;
+    const std::ptrdiff_t minStride = width + 2 * padding;
+    m_stride = (minStride + elemsPerLine - 1) / elemsPerLine * elemsPerLine;
+    m_buffer.assign(static_cast<std::size_t>(m_stride) * (height + 2 * padding), value);
+    m_origin = static_cast<std::ptrdiff_t>(padding) * m_stride + padding;
+  }
+
+  /// @brief Reshapes the image as resize() does, but only if its shape
+  ///        differs. Pixels of an image already of the requested shape are left
+  ///        untouched, which keeps e.g. a zero border written once.
+  ///        The storage only grows, so going back to a smaller shape does
+  ///        not allocate.
+  /// @return True if the image was reshaped, i.e. zero initialised.
+  bool reshape(int width, int height, int padding = 0)
+  {
+    if (width == m_width && height == m_height && padding == m_padding) {
+      return false;
+    }
+    resize(width, height, padding);
+    return true;
+  }
+
+  /// @brief Bytes held by the pixel storage, border and unused capacity included.
+  std::size_t capacityBytes() const noexcept { return m_buffer.capacity() * sizeof(T); }
+
+  /// @brief Sets every pixel (border included) to @p value.
+  void fill(const T& value)
+  {
+    std::fill(m_buffer.begin(), m_buffer.end(), value);
+  }
+
+  T* data() noexcept { return m_buffer.data() + m_origin; }
+  const T* data() const noexcept { return m_buffer.data() + m_origin; }
+  int width() const noexcept { return m_width; }
+  int height() const noexcept { return m_height; }
+  int padding() const noexcept { return m_padding; }
+  std::ptrdiff_t stride() const noexcept { return m_stride; }
+  bool empty() const noexcept { return m_width <= 0 || m_height <= 0; }
+
+  T* row(int r) noexcept { return data() + r * m_stride; }
+  const T* row(int r) const noexcept { return data() + r * m_stride; }
+  T& operator()(int r, int c) noexcept { return data()[r * m_stride + c]; }
+  const T& operator()(int r, int c) const noexcept { return data()[r * m_stride + c]; }
+
+  ImageView<T> view() noexcept { return ImageView<T>(data(), m_width, m_height, m_stride); }
+  ImageView<const T> view() const noexcept { return ImageView<const T>(data(), m_width, m_height, m_stride); }
+  operator ImageView<T>() noexcept { return view(); }
+  operator ImageView<const T>() const noexcept { return view(); }
+
+private:
+  std::vector<T, AlignedAllocator<T>> m_buffer;
+  int m_width{0};
+  int m_height{0};
+  int m_padding{0};
+  std::ptrdiff_t m_stride{0};
+  // Offset, in elements, of pixel (0, 0) within m_buffer
+  std::ptrdiff_t m_origin{0};
+};
+
+#endif //IMAGE_H
@@ -0,0 +1,95 @@
+/// @file mappedfile.cpp
+/// @brief source file for mappedfile
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#include "mappedfile.hpp"
+#include <fstream>
+#include <iterator>
+#include <utility>
+#if defined(__unix__) || defined(__APPLE__)
+#define MAPPEDFILE_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : m_data(other.m_data),
+      m_size(other.m_size),
+      m_fileCopy(std::move(other.m_fileCopy))
+{
+    other.m_data = nullptr;
+    other.m_size = 0;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other) {
+        close();
+        m_data = other.m_data;
+        m_size = other.m_size;
+        m_fileCopy = std::move(other.m_fileCopy);
+        other.m_data = nullptr;
+        other.m_size = 0;
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+void MappedFile::close() noexcept
+{
+#if defined(MAPPEDFILE_HAS_MMAP)
+    if (m_data != nullptr && m_fileCopy.empty()) {
+        munmap(const_cast<uint8_t*>(m_data), m_size);
+    }
+#endif
+    m_data = nullptr;
+    m_size = 0;
+    m_fileCopy.clear();
+}
+
+bool MappedFile::open(const std::string& path)
+{
+    close();
+#if defined(MAPPEDFILE_HAS_MMAP)
+    const int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0) {
+        return false;
+    }
+    struct stat info{};
+    if (fstat(file, &info) != 0 || info.st_size <= 0) {
+        ::close(file);
+        return false;
+    }
+    const std::size_t size = static_cast<std::size_t>(info.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    // The mapping keeps its own reference to the file
+    ::close(file);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+    m_data = static_cast<const uint8_t*>(mapping);
+    m_size = size;
+#else
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream) {
+        return false;
+    }
+    m_fileCopy.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    if (m_fileCopy.empty()) {
+        return false;
+    }
+    m_data = m_fileCopy.data();
+    m_size = m_fileCopy.size();
+#endif
+    return true;
+}
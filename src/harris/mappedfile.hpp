@@ -0,0 +1,55 @@
+/// @file mappedfile.hpp
+/// @brief Read-only memory mapping of a whole file
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// @brief Maps a file in memory, read-only, so that its pages are only read
+///        from the disk when accessed. Where mmap() is not available the file
+///        is read into memory instead. The bytes stay at the same address
+///        when the mapping is moved.
+class MappedFile final
+{
+public:
+  // Default constructor, no file mapped.
+  MappedFile() = default;
+  // Non copyable, the mapping is owned.
+  MappedFile(const MappedFile&) = delete;
+  // Non copyable.
+  MappedFile& operator=(const MappedFile&) = delete;
+  // Move constructor, the mapping changes owner.
+  MappedFile(MappedFile&& other) noexcept;
+  // Move assignment operator, unmaps the current file first.
+  MappedFile& operator=(MappedFile&& other) noexcept;
+  // Unmaps the file.
+  ~MappedFile();
+
+  /// @brief Maps @p path, the previous file is unmapped.
+  /// @return False if the file cannot be opened or is empty.
+  bool open(const std::string& path);
+
+  /// @brief Unmaps the file, data() becomes null.
+  void close() noexcept;
+
+  const uint8_t* data() const noexcept { return m_data; }
+  std::size_t size() const noexcept { return m_size; }
+  bool isOpen() const noexcept { return m_data != nullptr; }
+
+private:
+  const uint8_t* m_data{nullptr};
+  std::size_t m_size{0};
+  // Contents of the file where mmap() is not available
+  std::vector<uint8_t> m_fileCopy;
+};
+
+#endif //MAPPEDFILE_H
@@ -0,0 +1,129 @@
+/// @file simd.hpp
+/// @brief Thin portable wrapper over the float SIMD registers of the target
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+// The instruction set is chosen at build time from the compiler target flags,
+// e.g. -mavx2 or -march=native. Defining HARRIS_DISABLE_SIMD forces the
+// scalar fallback.
+#if !defined(HARRIS_DISABLE_SIMD) && defined(__AVX2__)
+#define HARRIS_SIMD_AVX2 1
+#include <immintrin.h>
+#elif !defined(HARRIS_DISABLE_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#define HARRIS_SIMD_SSE2 1
+#include <emmintrin.h>
+#elif !defined(HARRIS_DISABLE_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define HARRIS_SIMD_NEON 1
+#include <arm_neon.h>
+#else
+#define HARRIS_SIMD_SCALAR 1
+#endif
+
+namespace simd {
+
+/// @brief Packed single precision floats, the number of lanes is kFloatLanes.
+///        Every operation maps to a single instruction (or a handful for the
+///        uint8 conversions) and rounds exactly as its scalar counterpart, so
+///        the vector and scalar paths produce identical results.
+#if defined(HARRIS_SIMD_AVX2)
+constexpr int kFloatLanes = 8;
+struct Float { __m256 v; };
+inline const char* name() noexcept { return "AVX2"; }
+inline Float load(const float* p) noexcept { return {_mm256_loadu_ps(p)}; }
+inline void store(float* p, Float a) noexcept { _mm256_storeu_ps(p, a.v); }
+inline Float set1(float value) noexcept { return {_mm256_set1_ps(value)}; }
+inline Float add(Float a, Float b) noexcept { return {_mm256_add_ps(a.v, b.v)}; }
+inline Float sub(Float a, Float b) noexcept { return {_mm256_sub_ps(a.v, b.v)}; }
+inline Float mul(Float a, Float b) noexcept { return {_mm256_mul_ps(a.v, b.v)}; }
+inline Float max(Float a, Float b) noexcept { return {_mm256_max_ps(a.v, b.v)}; }
+inline Float min(Float a, Float b) noexcept { return {_mm256_min_ps(a.v, b.v)}; }
+inline Float sqrt(Float a) noexcept { return {_mm256_sqrt_ps(a.v)}; }
+inline Float loadU8(const uint8_t* p) noexcept
+{
+  return {_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p))))};
+}
+#elif defined(HARRIS_SIMD_SSE2)
+constexpr int kFloatLanes = 4;
+struct Float { __m128 v; };
+inline const char* name() noexcept { return "SSE2"; }
+inline Float load(const float* p) noexcept { return {_mm_loadu_ps(p)}; }
+inline void store(float* p, Float a) noexcept { _mm_storeu_ps(p, a.v); }
+inline Float set1(float value) noexcept { return {_mm_set1_ps(value)}; }
+inline Float add(Float a, Float b) noexcept { return {_mm_add_ps(a.v, b.v)}; }
+inline Float sub(Float a, Float b) noexcept { return {_mm_sub_ps(a.v, b.v)}; }
+inline Float mul(Float a, Float b) noexcept { return {_mm_mul_ps(a.v, b.v)}; }
+inline Float max(Float a, Float b) noexcept { return {_mm_max_ps(a.v, b.v)}; }
+inline Float min(Float a, Float b) noexcept { return {_mm_min_ps(a.v, b.v)}; }
+inline Float sqrt(Float a) noexcept { return {_mm_sqrt_ps(a.v)}; }
+inline Float loadU8(const uint8_t* p) noexcept
+{
+  int32_t packed;
+  std::memcpy(&packed, p, sizeof(packed));
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i bytes = _mm_cvtsi32_si128(packed);
+  const __m128i words = _mm_unpacklo_epi8(bytes, zero);
+  return {_mm_cvtepi32_ps(_mm_unpacklo_epi16(words, zero))};
+}
+#elif defined(HARRIS_SIMD_NEON)
+constexpr int kFloatLanes = 4;
+struct Float { float32x4_t v; };
+inline const char* name() noexcept { return "NEON"; }
+inline Float load(const float* p) noexcept { return {vld1q_f32(p)}; }
+inline void store(float* p, Float a) noexcept { vst1q_f32(p, a.v); }
+inline Float set1(float value) noexcept { return {vdupq_n_f32(value)}; }
+inline Float add(Float a, Float b) noexcept { return {vaddq_f32(a.v, b.v)}; }
+inline Float sub(Float a, Float b) noexcept { return {vsubq_f32(a.v, b.v)}; }
+inline Float mul(Float a, Float b) noexcept { return {vmulq_f32(a.v, b.v)}; }
+inline Float max(Float a, Float b) noexcept { return {vmaxq_f32(a.v, b.v)}; }
+inline Float min(Float a, Float b) noexcept { return {vminq_f32(a.v, b.v)}; }
+#if defined(__aarch64__)
+inline Float sqrt(Float a) noexcept { return {vsqrtq_f32(a.v)}; }
+#else
+inline Float sqrt(Float a) noexcept
+{
+  // ARMv7 has no IEEE vector square root, keep results identical to std::sqrt
+  float lanes[4];
+  vst1q_f32(lanes, a.v);
+  for (float& lane : lanes) {
+    lane = std::sqrt(lane);
+  }
+  return {vld1q_f32(lanes)};
+}
+#endif
+inline Float loadU8(const uint8_t* p) noexcept
+{
+  uint32_t packed;
+  std::memcpy(&packed, p, sizeof(packed));
+  const uint16x8_t words = vmovl_u8(vcreate_u8(packed));
+  return {vcvtq_f32_u32(vmovl_u16(vget_low_u16(words)))};
+}
+#else
+constexpr int kFloatLanes = 1;
+struct Float { float v; };
+inline const char* name() noexcept { return "scalar"; }
+inline Float load(const float* p) noexcept { return {*p}; }
+inline void store(float* p, Float a) noexcept { *p = a.v; }
+inline Float set1(float value) noexcept { return {value}; }
+inline Float add(Float a, Float b) noexcept { return {a.v + b.v}; }
+inline Float sub(Float a, Float b) noexcept { return {a.v - b.v}; }
+inline Float mul(Float a, Float b) noexcept { return {a.v * b.v}; }
+inline Float max(Float a, Float b) noexcept { return {std::max(a.v, b.v)}; }
+inline Float min(Float a, Float b) noexcept { return {std::min(a.v, b.v)}; }
+inline Float sqrt(Float a) noexcept { return {std::sqrt(a.v)}; }
+inline Float loadU8(const uint8_t* p) noexcept { return {static_cast<float>(*p)}; }
+#endif
+
+} // namespace simd
+
+#endif //SIMD_H
@@ -0,0 +1,116 @@
+/// @file threadpool.cpp
+/// @brief source file for threadpool
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#include "threadpool.hpp"
+#include <algorithm>
+
+namespace harris {
+
+ThreadPool::ThreadPool(int threadCount)
+{
+    const int workers = std::max(threadCount, 1) - 1;
+    m_threads.reserve(workers);
+    for (int worker = 1; worker <= workers; ++worker) {
+        m_threads.emplace_back(&ThreadPool::workerLoop, this, worker);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wakeUp.notify_all();
+    for (auto& thread : m_threads) {
+        thread.join();
+    }
+}
+
+int ThreadPool::threadCount() const noexcept
+{
+    return static_cast<int>(m_threads.size()) + 1;
+}
+
+int ThreadPool::execute(Job& job, int worker)
+{
+    int finished = 0;
+    for (int index = job.next.fetch_add(1); index < job.count; index = job.next.fetch_add(1)) {
+        job.function(job.context, index, worker);
+        ++finished;
+    }
+    return finished;
+}
+
+void ThreadPool::run(int count, TaskFunction function, void* context)
+{
+    if (count <= 0) {
+        return;
+    }
+    if (m_threads.empty() || count == 1) {
+        for (int index = 0; index < count; ++index) {
+            function(context, index, 0);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> submit(m_submitMutex);
+    Job job{};
+    job.function = function;
+    job.context = context;
+    job.count = count;
+    job.pending = count;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_job = &job;
+        ++m_generation;
+    }
+    m_wakeUp.notify_all();
+
+    // The calling thread works as worker 0
+    const int finished = execute(job, 0);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    job.pending -= finished;
+    // The job lives on this stack frame, wait for every worker to release it
+    m_done.wait(lock, [&job] { return job.pending == 0 && job.active == 0; });
+    m_job = nullptr;
+}
+
+void ThreadPool::workerLoop(int worker)
+{
+    std::uint64_t seenGeneration = 0U;
+    for (;;) {
+        Job* job = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeUp.wait(lock, [this, seenGeneration] {
+                return m_stop || (m_job != nullptr && m_generation != seenGeneration);
+            });
+            if (m_stop) {
+                return;
+            }
+            seenGeneration = m_generation;
+            job = m_job;
+            ++job->active;
+        }
+
+        const int finished = execute(*job, worker);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            job->pending -= finished;
+            --job->active;
+            if (job->pending == 0 && job->active == 0) {
+                m_done.notify_all();
+            }
+        }
+    }
+}
+
+} // namespace harris
@@ -0,0 +1,94 @@
+/// @file threadpool.hpp
+/// @brief Fixed size thread pool running data-parallel loops
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace harris {
+
+/// @brief Pool of threads created once and reused by every parallelFor() call.
+///        Submitting work does not allocate memory.
+class ThreadPool final
+{
+public:
+  /// @brief Starts the pool.
+  /// @param threadCount Total number of threads working on a loop, the
+  ///                    calling thread included, i.e. threadCount - 1 threads
+  ///                    are spawned. Values below 1 are treated as 1.
+  explicit ThreadPool(int threadCount);
+  // Non copyable, threads are owned by the pool.
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  // Joins the threads.
+  ~ThreadPool();
+
+  /// @brief Number of threads working on a loop, the caller included.
+  int threadCount() const noexcept;
+
+  /// @brief Calls task(index, worker) for every index in [0, count) and
+  ///        returns once all of them are done. `worker` is in
+  ///        [0, threadCount()) and is unique among the concurrently running
+  ///        calls, e.g. to index per-thread buffers. Indices are handed out in
+  ///        increasing order. Concurrent callers are serialized. Must not be
+  ///        called from within a task.
+  template <typename Task>
+  void parallelFor(int count, Task&& task)
+  {
+    using TaskType = typename std::remove_reference<Task>::type;
+    run(count, &invokeTask<TaskType>, static_cast<void*>(&task));
+  }
+
+private:
+  using TaskFunction = void (*)(void* context, int index, int worker);
+
+  template <typename TaskType>
+  static void invokeTask(void* context, int index, int worker)
+  {
+    (*static_cast<TaskType*>(context))(index, worker);
+  }
+
+  // Loop being executed, lives on the stack of the submitting thread
+  struct Job
+  {
+    TaskFunction function{nullptr};
+    void* context{nullptr};
+    int count{0};
+    std::atomic<int> next{0};
+    // Indices not finished yet
+    int pending{0};
+    // Workers holding a reference to the job
+    int active{0};
+  };
+
+  void run(int count, TaskFunction function, void* context);
+  void workerLoop(int worker);
+  static int execute(Job& job, int worker);
+
+  std::vector<std::thread> m_threads;
+  // Serializes concurrent parallelFor() calls
+  std::mutex m_submitMutex;
+  // Protects the members below
+  std::mutex m_mutex;
+  std::condition_variable m_wakeUp;
+  std::condition_variable m_done;
+  Job* m_job{nullptr};
+  std::uint64_t m_generation{0U};
+  bool m_stop{false};
+};
+
+} // namespace harris
+
+#endif //THREADPOOL_H
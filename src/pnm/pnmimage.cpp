@@ -0,0 +1,288 @@
+/// @file pnmimage.cpp
+/// @brief source file for pnmimage
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#include "pnmimage.hpp"
+#include <cctype>
+#include <utility>
+// SSE2 is always available on x86-64, the SSSE3 shuffles only with e.g.
+// HARRIS_NATIVE_ARCH
+#if !defined(HARRIS_DISABLE_SIMD) && defined(__SSSE3__)
+#define PNM_RGB_SSSE3
+#define PNM_RGB_X86
+#include <tmmintrin.h>
+#elif !defined(HARRIS_DISABLE_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#define PNM_RGB_SSE2
+#define PNM_RGB_X86
+#include <emmintrin.h>
+#elif !defined(HARRIS_DISABLE_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define PNM_RGB_NEON
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+// BT.601 luma weights in 14-bit fixed point, as cv::cvtColor()
+constexpr uint32_t kWeightR = 4899;
+constexpr uint32_t kWeightG = 9617;
+constexpr uint32_t kWeightB = 1868;
+constexpr int kWeightBits = 14;
+
+/// @brief Reads the next header integer at @p position, skipping the
+///        whitespace and the '#' comments before it.
+/// @return False if no integer is found before @p end.
+bool readHeaderInteger(const uint8_t* data, std::size_t end, std::size_t& position, long& value)
+{
+    for (;;) {
+        while (position < end && std::isspace(data[position])) {
+            ++position;
+        }
+        if (position < end && data[position] == '#') {
+            while (position < end && data[position] != '\n' && data[position] != '\r') {
+                ++position;
+            }
+            continue;
+        }
+        break;
+    }
+    if (position >= end || !std::isdigit(data[position])) {
+        return false;
+    }
+    value = 0;
+    while (position < end && std::isdigit(data[position])) {
+        value = 10 * value + (data[position] - '0');
+        if (value > (1L << 24)) {
+            return false;
+        }
+        ++position;
+    }
+    return true;
+}
+
+#if defined(PNM_RGB_X86)
+// Pixels converted per iteration
+constexpr int kRgbPixels = 16;
+
+/// @brief Gray values of the pixels of @p rg, i.e. (R, G) pairs, and of
+///        @p b1, i.e. (B, 1) pairs, 4 at a time.
+__m128i weightedSum(__m128i rg, __m128i b1) noexcept
+{
+    const __m128i sum = _mm_add_epi32(
+        _mm_madd_epi16(rg, _mm_set1_epi32(static_cast<int>(kWeightR | (kWeightG << 16)))),
+        _mm_madd_epi16(b1, _mm_set1_epi32(static_cast<int>(kWeightB | (1U << (kWeightBits - 1)) << 16))));
+    return _mm_srli_epi32(sum, kWeightBits);
+}
+
+/// @brief Gray values of 8 pixels, whose channels are widened to 16 bits.
+__m128i graySum(__m128i r, __m128i g, __m128i b) noexcept
+{
+    const __m128i one = _mm_set1_epi16(1);
+    return _mm_packs_epi32(
+        weightedSum(_mm_unpacklo_epi16(r, g), _mm_unpacklo_epi16(b, one)),
+        weightedSum(_mm_unpackhi_epi16(r, g), _mm_unpackhi_epi16(b, one)));
+}
+
+#if defined(PNM_RGB_SSSE3)
+/// @brief Splits 16 interleaved RGB pixels into their channels.
+void deinterleave(const uint8_t* rgb, __m128i& red, __m128i& green, __m128i& blue) noexcept
+{
+    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgb));
+    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgb + 16));
+    const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgb + 32));
+    // -1 clears the byte
+    red = _mm_or_si128(_mm_or_si128(
+        _mm_shuffle_epi8(a, _mm_setr_epi8(0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1)),
+        _mm_shuffle_epi8(b, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14, -1, -1, -1, -1, -1))),
+        _mm_shuffle_epi8(c, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 1, 4, 7, 10, 13)));
+    green = _mm_or_si128(_mm_or_si128(
+        _mm_shuffle_epi8(a, _mm_setr_epi8(1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1)),
+        _mm_shuffle_epi8(b, _mm_setr_epi8(-1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1))),
+        _mm_shuffle_epi8(c, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14)));
+    blue = _mm_or_si128(_mm_or_si128(
+        _mm_shuffle_epi8(a, _mm_setr_epi8(2, 5, 8, 11, 14, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1)),
+        _mm_shuffle_epi8(b, _mm_setr_epi8(-1, -1, -1, -1, -1, 1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1))),
+        _mm_shuffle_epi8(c, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15)));
+}
+#else
+/// @brief Splits 16 interleaved RGB pixels into their channels. Without byte
+///        shuffles, each round interleaves the bytes of the first half of the
+///        48 with the ones of the second half, which after 4 rounds leaves
+///        every third byte side by side.
+void deinterleave(const uint8_t* rgb, __m128i& red, __m128i& green, __m128i& blue) noexcept
+{
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgb));
+    __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgb + 16));
+    __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgb + 32));
+    for (int round = 0; round < 4; ++round) {
+        const __m128i nextA = _mm_unpacklo_epi8(a, _mm_unpackhi_epi64(b, b));
+        const __m128i nextB = _mm_unpacklo_epi8(_mm_unpackhi_epi64(a, a), c);
+        const __m128i nextC = _mm_unpacklo_epi8(b, _mm_unpackhi_epi64(c, c));
+        a = nextA;
+        b = nextB;
+        c = nextC;
+    }
+    red = a;
+    green = b;
+    blue = c;
+}
+#endif
+
+void rgbToGrayBlock(const uint8_t* rgb, uint8_t* gray) noexcept
+{
+    __m128i red;
+    __m128i green;
+    __m128i blue;
+    deinterleave(rgb, red, green, blue);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i low = graySum(
+        _mm_unpacklo_epi8(red, zero), _mm_unpacklo_epi8(green, zero), _mm_unpacklo_epi8(blue, zero));
+    const __m128i high = graySum(
+        _mm_unpackhi_epi8(red, zero), _mm_unpackhi_epi8(green, zero), _mm_unpackhi_epi8(blue, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(gray), _mm_packus_epi16(low, high));
+}
+#elif defined(PNM_RGB_NEON)
+constexpr int kRgbPixels = 8;
+
+void rgbToGrayBlock(const uint8_t* rgb, uint8_t* gray) noexcept
+{
+    const uint8x8x3_t pixels = vld3_u8(rgb);
+    const uint16x8_t red = vmovl_u8(pixels.val[0]);
+    const uint16x8_t green = vmovl_u8(pixels.val[1]);
+    const uint16x8_t blue = vmovl_u8(pixels.val[2]);
+    uint32x4_t low = vmull_n_u16(vget_low_u16(red), kWeightR);
+    low = vmlal_n_u16(low, vget_low_u16(green), kWeightG);
+    low = vmlal_n_u16(low, vget_low_u16(blue), kWeightB);
+    uint32x4_t high = vmull_n_u16(vget_high_u16(red), kWeightR);
+    high = vmlal_n_u16(high, vget_high_u16(green), kWeightG);
+    high = vmlal_n_u16(high, vget_high_u16(blue), kWeightB);
+    // Rounding shifts, i.e. + 2^13 before the shift as the scalar code
+    vst1_u8(gray, vmovn_u16(vcombine_u16(vrshrn_n_u32(low, kWeightBits), vrshrn_n_u32(high, kWeightBits))));
+}
+#endif
+
+} // namespace
+
+const char* rgbToGrayInstructionSet() noexcept
+{
+#if defined(PNM_RGB_SSSE3)
+    return "SSSE3";
+#elif defined(PNM_RGB_SSE2)
+    return "SSE2";
+#elif defined(PNM_RGB_NEON)
+    return "NEON";
+#else
+    return "scalar";
+#endif
+}
+
+void rgbToGrayRow(const uint8_t* rgb, int count, uint8_t* gray) noexcept
+{
+    int x = 0;
+#if defined(PNM_RGB_X86) || defined(PNM_RGB_NEON)
+    for (; x + kRgbPixels <= count; x += kRgbPixels) {
+        rgbToGrayBlock(rgb + 3 * x, gray + x);
+    }
+#endif
+    for (; x < count; ++x) {
+        const uint32_t sum = kWeightR * rgb[3 * x] + kWeightG * rgb[3 * x + 1] + kWeightB * rgb[3 * x + 2];
+        gray[x] = static_cast<uint8_t>((sum + (1U << (kWeightBits - 1))) >> kWeightBits);
+    }
+}
+
+PnmImage::PnmImage(PnmImage&& other) noexcept
+    : m_file(std::move(other.m_file)),
+      m_gray(std::move(other.m_gray)),
+      m_view(other.m_view),
+      m_channels(other.m_channels),
+      m_error(std::move(other.m_error))
+{
+    other.m_gray = Image<uint8_t>();
+    other.m_view = ImageView<const uint8_t>();
+    other.m_channels = 0;
+}
+
+PnmImage& PnmImage::operator=(PnmImage&& other) noexcept
+{
+    if (this != &other) {
+        m_file = std::move(other.m_file);
+        m_gray = std::move(other.m_gray);
+        m_view = other.m_view;
+        m_channels = other.m_channels;
+        m_error = std::move(other.m_error);
+        other.m_gray = Image<uint8_t>();
+        other.m_view = ImageView<const uint8_t>();
+        other.m_channels = 0;
+    }
+    return *this;
+}
+
+void PnmImage::close() noexcept
+{
+    m_file.close();
+    m_view = ImageView<const uint8_t>();
+    m_channels = 0;
+}
+
+bool PnmImage::fail(const std::string& path, const char* reason)
+{
+    close();
+    m_error = path + ": " + reason;
+    return false;
+}
+
+bool PnmImage::open(const std::string& path)
+{
+    close();
+    m_error.clear();
+
+    // 1.) Map the whole file
+    if (!m_file.open(path)) {
+        return fail(path, "cannot be opened or is empty");
+    }
+    const uint8_t* data = m_file.data();
+    const std::size_t size = m_file.size();
+
+    // 2.) Header: magic number, width, height and maximum value, then a single
+    //     whitespace before the samples
+    if (size < 2 || data[0] != 'P' || (data[1] != '5' && data[1] != '6')) {
+        return fail(path, "is not a binary PGM (P5) or PPM (P6) file");
+    }
+    const int channels = data[1] == '5' ? 1 : 3;
+    std::size_t position = 2;
+    long width = 0;
+    long height = 0;
+    long maxValue = 0;
+    if (!readHeaderInteger(data, size, position, width)
+        || !readHeaderInteger(data, size, position, height)
+        || !readHeaderInteger(data, size, position, maxValue)
+        || position >= size || !std::isspace(data[position])
+        || width <= 0 || height <= 0 || maxValue < 1) {
+        return fail(path, "has an invalid header");
+    }
+    if (maxValue > 255) {
+        return fail(path, "has 16-bit samples, only 8-bit ones are supported");
+    }
+    ++position;
+    const std::size_t rowSize = static_cast<std::size_t>(width) * channels;
+    if (size - position < rowSize * static_cast<std::size_t>(height)) {
+        return fail(path, "is truncated");
+    }
+    const uint8_t* pixels = data + position;
+
+    // 3.) Gray pixels, in place for a PGM
+    m_channels = channels;
+    if (channels == 1) {
+        m_view = ImageView<const uint8_t>(pixels, static_cast<int>(width), static_cast<int>(height));
+    } else {
+        m_gray.reshape(static_cast<int>(width), static_cast<int>(height));
+        for (int y = 0; y < static_cast<int>(height); ++y) {
+            rgbToGrayRow(pixels + y * rowSize, static_cast<int>(width), m_gray.row(y));
+        }
+        m_view = m_gray;
+    }
+    return true;
+}
@@ -0,0 +1,88 @@
+/// @file pnmimage.hpp
+/// @brief Memory-mapped reader of binary PGM/PPM images
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#ifndef PNMIMAGE_H
+#define PNMIMAGE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "image.hpp"
+#include "mappedfile.hpp"
+
+/// @brief Grayscale image read from a binary PGM (P5) or PPM (P6) file with
+///        8-bit samples, e.g. the raw frames dumped by a capture rig.
+///
+/// The file is memory-mapped. A PGM is then used in place: view() points at
+/// the pixels of the mapping, so the pages are only read from the disk as the
+/// detector reaches them and nothing is copied. A PPM is converted to gray
+/// once, straight from the mapping, with the BT.601 weights used by
+/// cv::cvtColor(). The view stays valid until the image is closed, reopened
+/// or destroyed.
+class PnmImage final
+{
+public:
+  // Default constructor, no image open.
+  PnmImage() = default;
+  // Non copyable, the mapping is owned by the image.
+  PnmImage(const PnmImage&) = delete;
+  PnmImage& operator=(const PnmImage&) = delete;
+  // Move constructor, the mapping changes owner and view() stays valid. The
+  // source is left closed, without a gray plane, and can open another image.
+  PnmImage(PnmImage&& other) noexcept;
+  // Move assignment operator, closes the current image first.
+  PnmImage& operator=(PnmImage&& other) noexcept;
+  // Default destructor, unmaps the file.
+  ~PnmImage() = default;
+
+  /// @brief Maps @p path and parses its header, the previous image is closed.
+  /// @param path PGM or PPM file.
+  /// @return False if the file cannot be mapped, is not a binary PGM/PPM
+  ///         (e.g. a PNG named .ppm), its maximum value is not in [1, 255]
+  ///         or the pixels are cut short. error() then tells why.
+  bool open(const std::string& path);
+
+  /// @brief Releases the mapping, view() becomes empty. The gray plane is
+  ///        kept, so that the next PPM of the same size does not allocate.
+  void close() noexcept;
+
+  /// @brief Grayscale pixels, empty if no image is open.
+  ImageView<const uint8_t> view() const noexcept { return m_view; }
+
+  /// @brief Channels stored in the file, 1 for a PGM and 3 for a PPM.
+  int channels() const noexcept { return m_channels; }
+
+  /// @brief Reason of the last open() failure.
+  const std::string& error() const noexcept { return m_error; }
+
+private:
+  bool fail(const std::string& path, const char* reason);
+
+  MappedFile m_file;
+  // Gray plane of a PPM
+  Image<uint8_t> m_gray;
+  ImageView<const uint8_t> m_view;
+  int m_channels{0};
+  std::string m_error;
+};
+
+/// @brief Converts a row of interleaved RGB pixels to gray, with the BT.601
+///        weights in 14-bit fixed point as cv::cvtColor(). The channels are
+///        deinterleaved with SSSE3 shuffles when the target has them, SSE2
+///        unpacks on any other x86-64 target, or NEON vld3. The scalar loop
+///        handles the other targets and the tail of the row.
+/// @param rgb   Row of 3 * count samples, R first.
+/// @param count Number of pixels.
+/// @param gray  Output row of count pixels.
+void rgbToGrayRow(const uint8_t* rgb, int count, uint8_t* gray) noexcept;
+
+/// @brief Instruction set rgbToGrayRow() was built for, "scalar" without a
+///        vector path.
+const char* rgbToGrayInstructionSet() noexcept;
+
+#endif //PNMIMAGE_H
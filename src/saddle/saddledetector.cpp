@@ -0,0 +1,72 @@
+/// @file saddledetector.cpp
+/// @brief source file for saddledetector
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#include "saddledetector.hpp"
+#include <algorithm>
+
+SaddleChessCornersDetector::SaddleChessCornersDetector(const SaddleParameters& params)
+    : m_params(params)
+{
+}
+
+void SaddleChessCornersDetector::setParallelism(const int threadCount)
+{
+    if (threadCount <= 1) {
+        m_threadPool.reset();
+    } else if (!m_threadPool || m_threadPool->threadCount() != threadCount) {
+        m_threadPool = std::make_shared<harris::ThreadPool>(threadCount);
+    }
+}
+
+void SaddleChessCornersDetector::detect(const ImageView<const uint8_t>& image) noexcept
+{
+    const int height = image.height();
+    const int threadCount = m_threadPool ? m_threadPool->threadCount() : 1;
+
+    if (threadCount == 1) {
+        m_bandResults.resize(1);
+        saddle::detectBand(image, 0, height, m_params, m_workspaces[0], m_bandResults[0]);
+    } else {
+        // A few bands per thread to balance the load, each one starting with
+        // the direct sums of its first row
+        const int bandHeight = std::max(32, (height + 4 * threadCount - 1) / (4 * threadCount));
+        const int bandCount = (height + bandHeight - 1) / bandHeight;
+        m_bandResults.resize(bandCount);
+        m_workspaces.resize(threadCount);
+        m_threadPool->parallelFor(bandCount, [&](int band, int worker) {
+            saddle::detectBand(image, band * bandHeight, (band + 1) * bandHeight, m_params, m_workspaces[worker], m_bandResults[band]);
+        });
+    }
+
+    // Merge the bands top to bottom, i.e. in row-major order as a serial run
+    m_maxResponse = 0.0F;
+    m_maxResponseLocation = std::pair<int, int>(-1, -1);
+    for (const auto& band : m_bandResults) {
+        if (band.maxResponse > m_maxResponse) {
+            m_maxResponse = band.maxResponse;
+            m_maxResponseLocation = std::pair<int, int>(band.maxX, band.maxY);
+        }
+    }
+    const float threshold = m_params.thresholdPercent * m_maxResponse;
+    m_corners.clear();
+    for (const auto& band : m_bandResults) {
+        for (const auto& candidate : band.candidates) {
+            if (candidate.response > threshold) {
+                m_corners.push_back(candidate);
+            }
+        }
+    }
+    harris::keepStrongest(m_corners, m_params.maxCorners, m_strongestHeap);
+
+    m_cornersLocation.clear();
+    m_cornersResponse.clear();
+    for (const auto& corner : m_corners) {
+        m_cornersLocation.push_back(std::pair<int, int>(corner.x, corner.y));
+        m_cornersResponse.push_back(corner.response);
+    }
+}
@@ -0,0 +1,93 @@
+/// @file saddledetector.hpp
+/// @brief Chessboard corner detector based on the localized Radon transform
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#ifndef SADDLEDETECTOR_H
+#define SADDLEDETECTOR_H
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "cornersengine.hpp"
+#include "harrispipeline.hpp"
+#include "harristypes.hpp"
+#include "image.hpp"
+#include "saddlekernels.hpp"
+#include "saddletypes.hpp"
+#include "threadpool.hpp"
+
+/// @brief Detects the saddle points of a chessboard, after Duda & Frese,
+///        "Accurate Detection and Localization of Checkerboard Corners for
+///        Calibration" (2018).
+///
+/// The response of a pixel is the squared contrast between the mean
+/// intensities of four lines through it, horizontal, vertical and both
+/// diagonals. On a chessboard corner the two lines along the edges average
+/// both colours while each diagonal stays within squares of a single colour,
+/// so the contrast is maximal. It is at most a quarter of that on a straight
+/// edge or on the L-shaped corners of the board outline, and low on most
+/// textures, unlike the Harris response.
+class SaddleChessCornersDetector final : public ChessCornersEngine
+{
+public:
+  /// @param params Detection parameters of every frame.
+  explicit SaddleChessCornersDetector(const SaddleParameters& params = SaddleParameters{});
+  // Default copy constructor.
+  SaddleChessCornersDetector(const SaddleChessCornersDetector&) = default;
+  // Default copy assignment operator.
+  SaddleChessCornersDetector& operator=(const SaddleChessCornersDetector&) = default;
+  // Default move constructor.
+  SaddleChessCornersDetector(SaddleChessCornersDetector&&) = default;
+  // Default move assignment operator.
+  SaddleChessCornersDetector& operator=(SaddleChessCornersDetector&&) = default;
+  // Default destructor.
+  ~SaddleChessCornersDetector() override = default;
+
+  const char* name() const noexcept override { return "saddle"; }
+
+  /// @brief Configures the multithreaded execution of detect(). The frame is
+  ///        split in horizontal bands processed in parallel, and the corners
+  ///        are merged in the same order as the serial execution.
+  /// @param threadCount Number of threads, the caller included. 1 (default)
+  ///                    runs serially.
+  void setParallelism(const int threadCount) override;
+
+  /// @brief Runs line sums, response and non-maximal suppression in a single
+  ///        sweep, see saddle::detectBand(). The threshold is relative to the
+  ///        maximum response of the frame. Results are stored in
+  ///        m_cornersLocation and m_cornersResponse (replaced), m_maxResponse
+  ///        and m_maxResponseLocation.
+  /// @param image Grayscale image.
+  void detect(const ImageView<const uint8_t>& image) noexcept override;
+
+  const std::vector<std::pair<int, int>>& cornersLocation() const noexcept override { return m_cornersLocation; }
+  const std::vector<float>& cornersResponse() const noexcept override { return m_cornersResponse; }
+
+  // Maximum response of the last frame, in [0, 1], and its location.
+  float m_maxResponse{0.0F};
+  std::pair<int, int> m_maxResponseLocation{-1, -1};
+  // Detected corners, first = x, second = y, in row-major order.
+  std::vector<std::pair<int, int>> m_cornersLocation;
+  // Response of each entry of m_cornersLocation.
+  std::vector<float> m_cornersResponse;
+
+private:
+  SaddleParameters m_params;
+  // Row buffers, one per worker thread
+  std::vector<saddle::SaddleWorkspace> m_workspaces = std::vector<saddle::SaddleWorkspace>(1);
+  // Detections of each band, a single one in serial mode
+  std::vector<harris::RegionResult> m_bandResults;
+  // Workers of the multithreaded mode, shared by the copies of the detector
+  std::shared_ptr<harris::ThreadPool> m_threadPool;
+  // Corners above the threshold, before keeping the strongest
+  std::vector<HarrisCandidate> m_corners;
+  // Heap of the strongest corners selection
+  std::vector<int> m_strongestHeap;
+};
+
+#endif //SADDLEDETECTOR_H
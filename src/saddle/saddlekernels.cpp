@@ -0,0 +1,291 @@
+/// @file saddlekernels.cpp
+/// @brief source file for saddlekernels
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#include "saddlekernels.hpp"
+#include "harriskernels.hpp"
+#include "simd.hpp"
+#include <algorithm>
+
+namespace saddle {
+
+namespace {
+
+// Rows of SaddleWorkspace::lineSums. The diagonal (down-right) and
+// anti-diagonal (down-left) sums use two rows each, the current one and the
+// previous one it is updated from, swapped at every image row.
+constexpr int kHorizontal = 0;
+constexpr int kVertical = 1;
+constexpr int kDiagonal = 2;
+constexpr int kAntiDiagonal = 4;
+constexpr int kLineSumRows = 6;
+
+int ringSlot(int row, int ringRows) noexcept
+{
+    return ((row % ringRows) + ringRows) % ringRows;
+}
+
+void convertRow(const uint8_t* input, int count, float* output) noexcept
+{
+    int x = 0;
+    for (; x + simd::kFloatLanes <= count; x += simd::kFloatLanes) {
+        simd::store(output + x, simd::loadU8(input + x));
+    }
+    for (; x < count; ++x) {
+        output[x] = static_cast<float>(input[x]);
+    }
+}
+
+void accumulateRow(const float* input, int count, float* output) noexcept
+{
+    int x = 0;
+    for (; x + simd::kFloatLanes <= count; x += simd::kFloatLanes) {
+        simd::store(output + x, simd::add(simd::load(output + x), simd::load(input + x)));
+    }
+    for (; x < count; ++x) {
+        output[x] += input[x];
+    }
+}
+
+} // namespace
+
+void horizontalLineSums(const float* input, int begin, int end, int radius, float* output) noexcept
+{
+    if (begin >= end) {
+        return;
+    }
+    // The pixels are integers, so the running sum is exact
+    float sum = 0.0F;
+    for (int k = -radius; k <= radius; ++k) {
+        sum += input[begin + k];
+    }
+    output[begin] = sum;
+    for (int x = begin + 1; x < end; ++x) {
+        sum += input[x + radius] - input[x - radius - 1];
+        output[x] = sum;
+    }
+}
+
+void slideLineSums(const float* previous, const float* entering, const float* leaving, int count, float* output) noexcept
+{
+    int x = 0;
+    for (; x + simd::kFloatLanes <= count; x += simd::kFloatLanes) {
+        simd::store(output + x, simd::sub(
+            simd::add(simd::load(previous + x), simd::load(entering + x)),
+            simd::load(leaving + x)));
+    }
+    for (; x < count; ++x) {
+        output[x] = (previous[x] + entering[x]) - leaving[x];
+    }
+}
+
+void saddleResponseRow(
+    const float* horizontal,
+    const float* vertical,
+    const float* diagonal,
+    const float* antiDiagonal,
+    float scale,
+    int count,
+    float* response
+    ) noexcept
+{
+    const simd::Float scaleVec = simd::set1(scale);
+    int x = 0;
+    for (; x + simd::kFloatLanes <= count; x += simd::kFloatLanes) {
+        const simd::Float h = simd::load(horizontal + x);
+        const simd::Float v = simd::load(vertical + x);
+        const simd::Float d = simd::load(diagonal + x);
+        const simd::Float a = simd::load(antiDiagonal + x);
+        const simd::Float high = simd::max(simd::max(h, v), simd::max(d, a));
+        const simd::Float low = simd::min(simd::min(h, v), simd::min(d, a));
+        const simd::Float contrast = simd::mul(simd::sub(high, low), scaleVec);
+        simd::store(response + x, simd::mul(contrast, contrast));
+    }
+    for (; x < count; ++x) {
+        const float h = horizontal[x];
+        const float v = vertical[x];
+        const float d = diagonal[x];
+        const float a = antiDiagonal[x];
+        const float high = std::max(std::max(h, v), std::max(d, a));
+        const float low = std::min(std::min(h, v), std::min(d, a));
+        const float contrast = (high - low) * scale;
+        response[x] = contrast * contrast;
+    }
+}
+
+void detectBand(
+    const ImageView<const uint8_t>& image,
+    int rowBegin,
+    int rowEnd,
+    const SaddleParameters& params,
+    SaddleWorkspace& workspace,
+    harris::RegionResult& result
+    ) noexcept
+{
+    result.candidates.clear();
+    result.maxResponse = 0.0F;
+    result.maxX = -1;
+    result.maxY = -1;
+
+    const int height = image.height();
+    const int width = image.width();
+    const int radius = std::max(params.lineOffset, 1);
+    const int nmsOffset = std::max(params.nmsWindowOffset, 0);
+
+    // Requested rows clipped to the image
+    const int regionY0 = std::max(rowBegin, 0);
+    const int regionY1 = std::min(rowEnd, height);
+    if (regionY0 >= regionY1 || width <= 0) {
+        return;
+    }
+    // Response rows to compute, i.e. the band plus the NMS halo
+    const int responseBegin = std::max(regionY0 - nmsOffset, 0);
+    const int responseEnd = std::min(regionY1 + nmsOffset, height);
+    // NMS centres, the window must fit in the image
+    const int nmsX0 = nmsOffset;
+    const int nmsX1 = width - nmsOffset;
+    const int nmsY0 = std::max(regionY0, nmsOffset);
+    const int nmsY1 = std::min(regionY1, height - nmsOffset);
+    // Pixels whose four lines fit in the image
+    const int interiorBegin = radius;
+    const int interiorEnd = width - radius;
+    // Columns where a diagonal through the image may have a non-zero sum
+    const int diagonalBegin = -radius;
+    const int diagonalCount = width + 2 * radius;
+    // Normalises the contrast to [0, 1]
+    const float scale = 1.0F / (255.0F * static_cast<float>(2 * radius + 1));
+
+    // Rows y - radius - 1 to y + radius of the image, zero outside of it
+    const int inputRows = 2 * radius + 2;
+    workspace.inputRing.reshape(width, inputRows, 2 * radius + 1);
+    workspace.lineSums.reshape(width, kLineSumRows, radius + 1);
+    const int ringRows = 2 * nmsOffset + 1;
+    workspace.responseRing.reshape(width, ringRows);
+    workspace.rowMaxRing.reshape(width, ringRows);
+    workspace.windowRows.resize(ringRows);
+    const std::size_t maxFilterScratch = 2 * static_cast<std::size_t>(width + 2 * nmsOffset);
+    if (workspace.maxFilterScratch.size() < maxFilterScratch) {
+        workspace.maxFilterScratch.resize(maxFilterScratch);
+    }
+    auto loadRow = [&](int t) {
+        float* row = workspace.inputRing.row(ringSlot(t, inputRows));
+        if (t >= 0 && t < height) {
+            convertRow(image.row(t), width, row);
+        } else {
+            std::fill(row, row + width, 0.0F);
+        }
+    };
+
+    float* vertical = workspace.lineSums.row(kVertical);
+    int diagonal = kDiagonal;
+    int antiDiagonal = kAntiDiagonal;
+    for (int y = responseBegin; y < responseEnd; ++y) {
+        if (y == responseBegin) {
+            // 1.) Line sums of the first row, from the 2 * radius + 1 rows
+            //     around it
+            float* diagonalSums = workspace.lineSums.row(diagonal) + diagonalBegin;
+            float* antiDiagonalSums = workspace.lineSums.row(antiDiagonal) + diagonalBegin;
+            std::fill(vertical, vertical + width, 0.0F);
+            std::fill(diagonalSums, diagonalSums + diagonalCount, 0.0F);
+            std::fill(antiDiagonalSums, antiDiagonalSums + diagonalCount, 0.0F);
+            for (int k = -radius; k <= radius; ++k) {
+                loadRow(y + k);
+                const float* row = workspace.inputRing.row(ringSlot(y + k, inputRows));
+                accumulateRow(row, width, vertical);
+                accumulateRow(row + diagonalBegin + k, diagonalCount, diagonalSums);
+                accumulateRow(row + diagonalBegin - k, diagonalCount, antiDiagonalSums);
+            }
+        } else {
+            // 1.) Running line sums, row y + radius enters every line and row
+            //     y - radius - 1 leaves it. The diagonal through (x, y) is the
+            //     one through (x - 1, y - 1) moved by a pixel, and the
+            //     anti-diagonal the one through (x + 1, y - 1).
+            loadRow(y + radius);
+            const float* entering = workspace.inputRing.row(ringSlot(y + radius, inputRows));
+            const float* leaving = workspace.inputRing.row(ringSlot(y - radius - 1, inputRows));
+            slideLineSums(vertical, entering, leaving, width, vertical);
+            const int previousDiagonal = diagonal;
+            const int previousAntiDiagonal = antiDiagonal;
+            diagonal = 2 * kDiagonal + 1 - diagonal;
+            antiDiagonal = 2 * kAntiDiagonal + 1 - antiDiagonal;
+            slideLineSums(
+                workspace.lineSums.row(previousDiagonal) + diagonalBegin - 1,
+                entering + diagonalBegin + radius,
+                leaving + diagonalBegin - radius - 1,
+                diagonalCount,
+                workspace.lineSums.row(diagonal) + diagonalBegin
+                );
+            slideLineSums(
+                workspace.lineSums.row(previousAntiDiagonal) + diagonalBegin + 1,
+                entering + diagonalBegin - radius,
+                leaving + diagonalBegin + radius + 1,
+                diagonalCount,
+                workspace.lineSums.row(antiDiagonal) + diagonalBegin
+                );
+        }
+
+        // 2.) Response of row y, zero where the lines leave the image
+        float* response = workspace.responseRing.row(y % ringRows);
+        std::fill(response, response + width, 0.0F);
+        if (y >= radius && y < height - radius && interiorBegin < interiorEnd) {
+            float* horizontal = workspace.lineSums.row(kHorizontal);
+            horizontalLineSums(workspace.inputRing.row(ringSlot(y, inputRows)), interiorBegin, interiorEnd, radius, horizontal);
+            saddleResponseRow(
+                horizontal + interiorBegin,
+                vertical + interiorBegin,
+                workspace.lineSums.row(diagonal) + interiorBegin,
+                workspace.lineSums.row(antiDiagonal) + interiorBegin,
+                scale, interiorEnd - interiorBegin, response + interiorBegin
+                );
+        }
+        if (y >= regionY0 && y < regionY1) {
+            for (int x = interiorBegin; x < interiorEnd; ++x) {
+                if (response[x] > result.maxResponse) {
+                    result.maxResponse = response[x];
+                    result.maxX = x;
+                    result.maxY = y;
+                }
+            }
+        }
+
+        // 3.) Horizontal sliding maximum of row y
+        float* rowMax = workspace.rowMaxRing.row(y % ringRows);
+        harris::maxFilterRow(response, 0, width, nmsOffset, rowMax, workspace.maxFilterScratch.data());
+
+        // 4.) Non-maximal suppression of the row whose window is now complete,
+        //     the vertical pass of the max filter is only run on candidates
+        const int center = y - nmsOffset;
+        if (center < nmsY0 || center >= nmsY1) {
+            continue;
+        }
+        const float* centerRow = workspace.responseRing.row(center % ringRows);
+        // Rows of the window, the centre one first as it rejects most pixels
+        const float** windowRows = workspace.windowRows.data();
+        windowRows[0] = workspace.rowMaxRing.row(center % ringRows);
+        for (int j = 1; j <= nmsOffset; ++j) {
+            windowRows[2 * j - 1] = workspace.rowMaxRing.row((center - j) % ringRows);
+            windowRows[2 * j] = workspace.rowMaxRing.row((center + j) % ringRows);
+        }
+        for (int x = nmsX0; x < nmsX1; ++x) {
+            const float value = centerRow[x];
+            if (!(value > 0.0F) || windowRows[0][x] > value) continue; // Only positive responses can pass the threshold
+
+            bool isMaximum = true;
+            for (int j = 1; j < ringRows; ++j) {
+                if (windowRows[j][x] > value) {
+                    isMaximum = false;
+                    break;
+                }
+            }
+            if (isMaximum) {
+                result.candidates.push_back(HarrisCandidate{x, center, value});
+            }
+        }
+    }
+}
+
+} // namespace saddle
@@ -0,0 +1,91 @@
+/// @file saddlekernels.hpp
+/// @brief Row kernels and band sweep of the saddle point response
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#ifndef SADDLEKERNELS_H
+#define SADDLEKERNELS_H
+
+#include <cstdint>
+#include <vector>
+#include "image.hpp"
+#include "harrispipeline.hpp"
+#include "saddletypes.hpp"
+
+namespace saddle {
+
+/// @brief Row buffers reused by detectBand(), sized on first use. A workspace
+///        must not be shared by two concurrent calls.
+struct SaddleWorkspace
+{
+  // Last 2 * lineOffset + 2 image rows as floats, the zero padding of
+  // 2 * lineOffset + 1 columns stands for the pixels outside the image
+  Image<float> inputRing;
+  // Line sums of the current row, see the k* row indices in saddlekernels.cpp
+  Image<float> lineSums;
+  // Last 2 * nmsWindowOffset + 1 rows of the response, and of its horizontal
+  // sliding maximum
+  Image<float> responseRing;
+  Image<float> rowMaxRing;
+  // Rows of rowMaxRing covered by the NMS window of the current row
+  std::vector<const float*> windowRows;
+  // Scratch of harris::maxFilterRow()
+  std::vector<float> maxFilterScratch;
+};
+
+/// @brief Sums of the 2 * radius + 1 pixels centred on each pixel of a row,
+///        the pixels outside [begin, end) being read from @p input as well.
+/// @param input  Row, read on [begin - radius, end + radius).
+/// @param begin  First column.
+/// @param end    One past the last column.
+/// @param radius Half length of the sum.
+/// @param output Sums, written on [begin, end).
+void horizontalLineSums(const float* input, int begin, int end, int radius, float* output) noexcept;
+
+/// @brief output[i] = previous[i] + entering[i] - leaving[i], i.e. one step of
+///        a running line sum. @p output may alias @p previous.
+void slideLineSums(const float* previous, const float* entering, const float* leaving, int count, float* output) noexcept;
+
+/// @brief Squared contrast between the four line sums through each pixel,
+///        (scale * (max - min))^2, as in the localized Radon transform of
+///        Duda & Frese (2018).
+void saddleResponseRow(
+  const float* horizontal,
+  const float* vertical,
+  const float* diagonal,
+  const float* antiDiagonal,
+  float scale,
+  int count,
+  float* response
+) noexcept;
+
+/// @brief Runs line sums -> response -> non-maximal suppression in a single
+///        sweep over the rows [rowBegin, rowEnd) of @p image. The line sums are
+///        updated from the previous row with two additions per pixel, whatever
+///        their length, and each response row is kept only while the NMS
+///        window needs it, so no full-frame plane is ever written.
+///
+/// Only pixels of [rowBegin, rowEnd) are reported, so adjacent bands can be
+/// processed independently and concatenated. Thresholding is left to the
+/// caller, as it depends on the maximum of the whole frame.
+/// @param image     Grayscale image.
+/// @param rowBegin  First row to report.
+/// @param rowEnd    One past the last row to report.
+/// @param params    Detection parameters.
+/// @param workspace Reusable row buffers.
+/// @param result    Cleared, then filled with the band detections.
+void detectBand(
+  const ImageView<const uint8_t>& image,
+  int rowBegin,
+  int rowEnd,
+  const SaddleParameters& params,
+  SaddleWorkspace& workspace,
+  harris::RegionResult& result
+) noexcept;
+
+} // namespace saddle
+
+#endif //SADDLEKERNELS_H
@@ -0,0 +1,26 @@
+/// @file saddletypes.hpp
+/// @brief Parameters of the saddle point detector
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#ifndef SADDLETYPES_H
+#define SADDLETYPES_H
+
+/// @brief Parameters of a saddle point detection, see SaddleChessCornersDetector.
+struct SaddleParameters
+{
+  // Half length of the four lines summed through each pixel, i.e. 3 => 7
+  // pixels. About a third of the square size works best.
+  int lineOffset{3};
+  // Threshold as a percentage of the maximum response, in (0, 1).
+  float thresholdPercent{0.5F};
+  // Offset of the non-maximal suppression window, i.e. 1 => 3x3.
+  int nmsWindowOffset{1};
+  // Keep only the strongest corners, 0 keeps all of them.
+  int maxCorners{0};
+};
+
+#endif //SADDLETYPES_H
@@ -0,0 +1,219 @@
+/// @file syntheticboard.cpp
+/// @brief source file for syntheticboard
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#include "syntheticboard.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace {
+
+// Subsamples per axis of the pixels crossed by an edge
+constexpr int kSupersampling = 8;
+
+constexpr float kPi = 3.14159265358979323846F;
+
+/// @brief Separable Gaussian blur, the pixels outside the image replicate
+///        the border ones.
+void gaussianBlur(Image<float>& plane, const float sigma)
+{
+    const int width = plane.width();
+    const int height = plane.height();
+    const int radius = static_cast<int>(std::ceil(3.0F * sigma));
+    std::vector<float> taps(2 * radius + 1);
+    float sum = 0.0F;
+    for (int i = -radius; i <= radius; ++i) {
+        taps[i + radius] = std::exp(-static_cast<float>(i * i) / (2.0F * sigma * sigma));
+        sum += taps[i + radius];
+    }
+    for (float& tap : taps) {
+        tap /= sum;
+    }
+
+    // Horizontal pass row by row, then vertical pass into the plane
+    Image<float> scratch(width, height);
+    std::vector<float> row(width + 2 * radius);
+    for (int y = 0; y < height; ++y) {
+        const float* input = plane.row(y);
+        for (int x = -radius; x < width + radius; ++x) {
+            row[x + radius] = input[std::min(std::max(x, 0), width - 1)];
+        }
+        float* output = scratch.row(y);
+        for (int x = 0; x < width; ++x) {
+            float value = 0.0F;
+            for (int i = 0; i <= 2 * radius; ++i) {
+                value += row[x + i] * taps[i];
+            }
+            output[x] = value;
+        }
+    }
+    for (int y = 0; y < height; ++y) {
+        float* output = plane.row(y);
+        std::fill(output, output + width, 0.0F);
+        for (int i = -radius; i <= radius; ++i) {
+            const float* input = scratch.row(std::min(std::max(y + i, 0), height - 1));
+            const float tap = taps[i + radius];
+            for (int x = 0; x < width; ++x) {
+                output[x] += input[x] * tap;
+            }
+        }
+    }
+}
+
+} // namespace
+
+SyntheticBoard makeSyntheticBoard(const SyntheticBoardParameters& params)
+{
+    SyntheticBoard board;
+    const int width = std::max(params.width, 0);
+    const int height = std::max(params.height, 0);
+    const float cosAngle = std::cos(params.angle * kPi / 180.0F);
+    const float sinAngle = std::sin(params.angle * kPi / 180.0F);
+    const float squaresX = static_cast<float>(params.cols + 1);
+    const float squaresY = static_cast<float>(params.rows + 1);
+
+    // Square size fitting the bounding box of the rotated board and its margin
+    float square = params.squareSize;
+    if (!(square > 0.0F)) {
+        const float marginX = squaresX + 2.0F;
+        const float marginY = squaresY + 2.0F;
+        square = std::min(
+            static_cast<float>(width) / (marginX * std::abs(cosAngle) + marginY * std::abs(sinAngle)),
+            static_cast<float>(height) / (marginX * std::abs(sinAngle) + marginY * std::abs(cosAngle))
+            );
+    }
+    board.squareSize = square;
+    const float boardWidth = squaresX * square;
+    const float boardHeight = squaresY * square;
+    const float centerX = 0.5F * static_cast<float>(width - 1) + params.shiftX;
+    const float centerY = 0.5F * static_cast<float>(height - 1) + params.shiftY;
+
+    // Inner corners, rotated around the board centre
+    for (int j = 1; j <= params.rows; ++j) {
+        for (int i = 1; i <= params.cols; ++i) {
+            const float u = static_cast<float>(i) * square - 0.5F * boardWidth;
+            const float v = static_cast<float>(j) * square - 0.5F * boardHeight;
+            board.corners.emplace_back(centerX + cosAngle * u - sinAngle * v, centerY + sinAngle * u + cosAngle * v);
+        }
+    }
+
+    // True if the point of the image plane lies on a dark square
+    auto isDark = [&](float x, float y) {
+        const float dx = x - centerX;
+        const float dy = y - centerY;
+        // Board coordinates, from its top-left corner
+        const float u = cosAngle * dx + sinAngle * dy + 0.5F * boardWidth;
+        const float v = -sinAngle * dx + cosAngle * dy + 0.5F * boardHeight;
+        if (!(u >= 0.0F && v >= 0.0F && u < boardWidth && v < boardHeight)) {
+            return false;
+        }
+        return (static_cast<int>(u / square) + static_cast<int>(v / square)) % 2 == 0;
+    };
+    // Dark area of the pixel centred on (x, y)
+    auto coverage = [&](int x, int y) {
+        const float px = static_cast<float>(x);
+        const float py = static_cast<float>(y);
+        const bool center = isDark(px, py);
+        if (isDark(px - 0.5F, py - 0.5F) == center && isDark(px + 0.5F, py - 0.5F) == center
+            && isDark(px - 0.5F, py + 0.5F) == center && isDark(px + 0.5F, py + 0.5F) == center) {
+            return center ? 1.0F : 0.0F;
+        }
+        int dark = 0;
+        for (int sy = 0; sy < kSupersampling; ++sy) {
+            for (int sx = 0; sx < kSupersampling; ++sx) {
+                dark += isDark(
+                    px - 0.5F + (static_cast<float>(sx) + 0.5F) / kSupersampling,
+                    py - 0.5F + (static_cast<float>(sy) + 0.5F) / kSupersampling
+                    ) ? 1 : 0;
+            }
+        }
+        return static_cast<float>(dark) / (kSupersampling * kSupersampling);
+    };
+
+    const float light = static_cast<float>(params.light);
+    const float contrast = static_cast<float>(params.dark) - light;
+    std::mt19937 generator(params.seed);
+    std::normal_distribution<float> noise(0.0F, std::max(params.noiseSigma, 0.0F));
+    auto quantize = [&](float value) {
+        if (params.noiseSigma > 0.0F) {
+            value += noise(generator);
+        }
+        return static_cast<uint8_t>(std::min(std::max(std::round(value), 0.0F), 255.0F));
+    };
+
+    board.image.resize(width, height);
+    if (params.blurSigma > 0.0F) {
+        Image<float> plane(width, height);
+        for (int y = 0; y < height; ++y) {
+            float* row = plane.row(y);
+            for (int x = 0; x < width; ++x) {
+                row[x] = light + contrast * coverage(x, y);
+            }
+        }
+        gaussianBlur(plane, params.blurSigma);
+        for (int y = 0; y < height; ++y) {
+            const float* input = plane.row(y);
+            uint8_t* output = board.image.row(y);
+            for (int x = 0; x < width; ++x) {
+                output[x] = quantize(input[x]);
+            }
+        }
+    } else {
+        // No intermediate plane, e.g. for the 8K+ stress inputs
+        for (int y = 0; y < height; ++y) {
+            uint8_t* output = board.image.row(y);
+            for (int x = 0; x < width; ++x) {
+                output[x] = quantize(light + contrast * coverage(x, y));
+            }
+        }
+    }
+    return board;
+}
+
+CornerMatch matchCorners(
+    const std::vector<std::pair<float, float>>& truth,
+    const std::vector<std::pair<float, float>>& detections,
+    const float maxDistance
+    )
+{
+    CornerMatch match;
+    float errorSum = 0.0F;
+    for (const auto& corner : truth) {
+        float closest = std::numeric_limits<float>::max();
+        for (const auto& detection : detections) {
+            closest = std::min(closest, std::hypot(detection.first - corner.first, detection.second - corner.second));
+        }
+        if (closest <= maxDistance) {
+            ++match.matched;
+            errorSum += closest;
+            match.maxError = std::max(match.maxError, closest);
+        }
+    }
+    if (!truth.empty()) {
+        match.recall = static_cast<float>(match.matched) / static_cast<float>(truth.size());
+    }
+    if (match.matched > 0) {
+        match.meanError = errorSum / static_cast<float>(match.matched);
+    }
+    return match;
+}
+
+CornerMatch matchCorners(
+    const std::vector<std::pair<float, float>>& truth,
+    const std::vector<std::pair<int, int>>& detections,
+    const float maxDistance
+    )
+{
+    std::vector<std::pair<float, float>> locations;
+    locations.reserve(detections.size());
+    for (const auto& detection : detections) {
+        locations.emplace_back(static_cast<float>(detection.first), static_cast<float>(detection.second));
+    }
+    return matchCorners(truth, locations, maxDistance);
+}
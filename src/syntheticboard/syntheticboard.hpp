@@ -0,0 +1,102 @@
+/// @file syntheticboard.hpp
+/// @brief Procedural chessboard images with known corners
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#ifndef SYNTHETICBOARD_H
+#define SYNTHETICBOARD_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "image.hpp"
+
+/// @brief Rendering settings of makeSyntheticBoard().
+struct SyntheticBoardParameters
+{
+  // Image size, in pixels.
+  int width{1280};
+  int height{720};
+  // Inner corners per row and per column, i.e. a 9x6 pattern has 10x7 squares.
+  int cols{9};
+  int rows{6};
+  // Side of a square, in pixels. 0 fits the board, and a margin of one square
+  // around it, in the image whatever the rotation.
+  float squareSize{0.0F};
+  // Rotation of the board around its centre, in degrees, clockwise as the
+  // image is seen, i.e. with the y axis pointing down.
+  float angle{0.0F};
+  // Offset of the board centre from the image centre, in pixels.
+  float shiftX{0.0F};
+  float shiftY{0.0F};
+  // Grey levels of the dark squares, and of the light squares and background.
+  uint8_t dark{0};
+  uint8_t light{255};
+  // Standard deviation of the Gaussian blur, in pixels, 0 disables it.
+  float blurSigma{0.0F};
+  // Standard deviation of the additive Gaussian noise, in grey levels, 0
+  // disables it.
+  float noiseSigma{0.0F};
+  // Seed of the noise, the same parameters always give the same image.
+  uint32_t seed{1};
+};
+
+/// @brief Image of a board and its ground truth.
+struct SyntheticBoard
+{
+  Image<uint8_t> image;
+  // rows * cols inner corners in row-major order of the board, first = x,
+  // second = y. Pixel centres are at integer values, as in
+  // HarrisChessCornersDetector::m_cornersSubPixel.
+  std::vector<std::pair<float, float>> corners;
+  // Side of a square, in pixels.
+  float squareSize{0.0F};
+};
+
+/// @brief Renders a chessboard of (cols + 1) x (rows + 1) squares on a light
+///        background, the top-left square being dark when not rotated.
+///
+/// The pixels crossed by an edge are supersampled, so the edges are
+/// anti-aliased and the corners lie at sub-pixel locations. The blur, if
+/// any, is applied before the noise, as the optics of a camera come before
+/// its sensor.
+/// @param params Rendering settings.
+/// @return The image and the exact location of its inner corners.
+SyntheticBoard makeSyntheticBoard(const SyntheticBoardParameters& params);
+
+/// @brief Agreement between detected and ground truth corners.
+struct CornerMatch
+{
+  // Ground truth corners with a detection within the match distance.
+  int matched{0};
+  // matched over the number of ground truth corners.
+  float recall{0.0F};
+  // Mean and maximum distance of the matched corners to the closest
+  // detection, in pixels.
+  float meanError{0.0F};
+  float maxError{0.0F};
+};
+
+/// @brief Matches each ground truth corner to its closest detection.
+/// @param truth       Ground truth corners, first = x, second = y.
+/// @param detections  Detected corners, first = x, second = y.
+/// @param maxDistance A corner farther than this from every detection is
+///                    missed, in pixels.
+CornerMatch matchCorners(
+  const std::vector<std::pair<float, float>>& truth,
+  const std::vector<std::pair<float, float>>& detections,
+  const float maxDistance
+);
+
+/// @brief matchCorners() of integer detections, e.g.
+///        HarrisChessCornersDetector::m_cornersLocation.
+CornerMatch matchCorners(
+  const std::vector<std::pair<float, float>>& truth,
+  const std::vector<std::pair<int, int>>& detections,
+  const float maxDistance
+);
+
+#endif //SYNTHETICBOARD_H
@@ -0,0 +1,181 @@
+/// @file allocationtests.cpp
+/// @brief Heap allocations of a detector reused over frames of the same size
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include <gtest/gtest.h>
+#include "harrisbatch.hpp"
+#include "harrisdetector.hpp"
+#include "syntheticboard.hpp"
+
+namespace {
+
+// Calls of the global operator new of the test binary, all threads included
+std::atomic<long> allocationCount{0};
+
+/// @brief Image buffers allocated by @p function. They bypass operator new.
+template <typename Function>
+long countImageAllocations(Function&& function)
+{
+    const std::size_t before = imageAllocationCount();
+    function();
+    return static_cast<long>(imageAllocationCount() - before);
+}
+
+/// @brief Allocations made by @p function, Image buffers included.
+template <typename Function>
+long countAllocations(Function&& function)
+{
+    const long before = allocationCount.load();
+    const long images = countImageAllocations(function);
+    return allocationCount.load() - before + images;
+}
+
+/// @brief Two frames of the same size with a different content, so that the
+///        candidate counts differ too.
+std::vector<SyntheticBoard> makeFrames(int width = 1280, int height = 720)
+{
+    std::vector<SyntheticBoard> frames;
+    for (float angle : {5.0F, -12.0F}) {
+        SyntheticBoardParameters params;
+        params.width = width;
+        params.height = height;
+        params.angle = angle;
+        params.blurSigma = 1.0F;
+        params.noiseSigma = 4.0F;
+        frames.push_back(makeSyntheticBoard(params));
+    }
+    return frames;
+}
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    ++allocationCount;
+    if (void* pointer = std::malloc(size == 0 ? 1 : size)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+// The frames are run twice, the first pass sizing the buffers for the
+// largest of them
+TEST(Allocations, FusedDetectionReusesBuffers)
+{
+    const std::vector<SyntheticBoard> frames = makeFrames();
+    HarrisChessCornersDetector detector{};
+    for (const SyntheticBoard& frame : frames) {
+        detector.detect(frame.image);
+    }
+    for (const SyntheticBoard& frame : frames) {
+        EXPECT_EQ(countAllocations([&] { detector.detect(frame.image); }), 0);
+    }
+}
+
+TEST(Allocations, ThreadedDetectionReusesBuffers)
+{
+    const std::vector<SyntheticBoard> frames = makeFrames();
+    HarrisChessCornersDetector detector{};
+    detector.setParallelism(4);
+    for (const SyntheticBoard& frame : frames) {
+        detector.detect(frame.image);
+    }
+    for (const SyntheticBoard& frame : frames) {
+        EXPECT_EQ(countAllocations([&] { detector.detect(frame.image); }), 0);
+    }
+}
+
+TEST(Allocations, AdaptiveThresholdReusesBuffers)
+{
+    const std::vector<SyntheticBoard> frames = makeFrames();
+    HarrisParameters params;
+    params.thresholdTileSize = 64;
+    HarrisChessCornersDetector detector{};
+    for (const SyntheticBoard& frame : frames) {
+        detector.detect(frame.image, params);
+    }
+    for (const SyntheticBoard& frame : frames) {
+        EXPECT_EQ(countAllocations([&] { detector.detect(frame.image, params); }), 0);
+    }
+}
+
+TEST(Allocations, StagedDetectionReusesBuffers)
+{
+    const std::vector<SyntheticBoard> frames = makeFrames();
+    HarrisChessCornersDetector detector{};
+    auto detect = [&detector](const SyntheticBoard& frame) {
+        detector.computeGradients(frame.image);
+        detector.cornerResponse_method2();
+        detector.thresholding();
+        detector.nonMaximalSuppression();
+    };
+    for (const SyntheticBoard& frame : frames) {
+        detect(frame);
+    }
+    for (const SyntheticBoard& frame : frames) {
+        EXPECT_EQ(countAllocations([&] { detect(frame); }), 0);
+    }
+}
+
+// Images go to whichever worker is idle, so a worker can meet a wider image
+// in the second batch than in the first one
+TEST(Allocations, BatchReusesBuffers)
+{
+    std::vector<SyntheticBoard> boards;
+    for (const SyntheticBoard& board : makeFrames(640, 480)) boards.push_back(board);
+    for (const SyntheticBoard& board : makeFrames(1920, 1080)) boards.push_back(board);
+    for (const SyntheticBoard& board : makeFrames(1280, 720)) boards.push_back(board);
+    std::vector<ImageView<const uint8_t>> firstBatch;
+    for (const SyntheticBoard& board : boards) {
+        firstBatch.push_back(board.image);
+    }
+    // Another mix, no wider than the first batch
+    const std::vector<ImageView<const uint8_t>> secondBatch{
+        firstBatch[2], firstBatch[0], firstBatch[3], firstBatch[4], firstBatch[2], firstBatch[1], firstBatch[5], firstBatch[3]
+    };
+    HarrisBatchDetector batchDetector(4);
+    batchDetector.detectBatch(firstBatch);
+    EXPECT_EQ(countImageAllocations([&] { batchDetector.detectBatch(secondBatch); }), 0);
+    EXPECT_EQ(countImageAllocations([&] { batchDetector.detectBatch(firstBatch); }), 0);
+}
+
+// A larger frame has to grow the planes, which shows that the counters see
+// the buffers the tests above expect to be reused
+TEST(Allocations, LargerFrameGrowsBuffers)
+{
+    const std::vector<SyntheticBoard> frames = makeFrames();
+    const std::vector<SyntheticBoard> largerFrames = makeFrames(1920, 1080);
+    HarrisChessCornersDetector fused{};
+    fused.detect(frames.front().image);
+    EXPECT_GT(countImageAllocations([&] { fused.detect(largerFrames.front().image); }), 0);
+
+    HarrisChessCornersDetector staged{};
+    auto detect = [&staged](const SyntheticBoard& frame) {
+        staged.computeGradients(frame.image);
+        staged.cornerResponse_method2();
+        staged.thresholding();
+        staged.nonMaximalSuppression();
+    };
+    detect(frames.front());
+    EXPECT_GT(countImageAllocations([&] { detect(largerFrames.front()); }), 0);
+    // Back to the smaller size, the storage only grows
+    EXPECT_EQ(countAllocations([&] { detect(frames.front()); }), 0);
+}
@@ -0,0 +1,198 @@
+/// @file chessboardgridtests.cpp
+/// @brief Lattice recovery of ChessboardGridDetector on the ground truth
+///        corners of synthetic boards
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#include <algorithm>
+#include <cmath>
+#include <ostream>
+#include <random>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "chessboardgrid.hpp"
+#include "syntheticboard.hpp"
+
+/// @brief Pose of the board and defects of the corner list.
+struct GridCase
+{
+    float angle;
+    float shiftX;
+    float shiftY;
+    // Points added away from the lattice
+    int clutter;
+    // Corners of the outer edge of the board left out
+    int droppedEdgeCorners;
+};
+
+std::ostream& operator<<(std::ostream& stream, const GridCase& gridCase)
+{
+    return stream << "angle " << gridCase.angle << ", shift (" << gridCase.shiftX << ", " << gridCase.shiftY
+                  << "), clutter " << gridCase.clutter << ", dropped " << gridCase.droppedEdgeCorners;
+}
+
+namespace {
+
+// 9x6 pattern, as in app/main.cpp
+constexpr int kRows = 6;
+constexpr int kCols = 9;
+constexpr float kSquareSize = 60.0F;
+
+using Points = std::vector<std::pair<float, float>>;
+
+/// @brief Corners a detector reports on a 9x6 board: the inner ones, and the
+///        ones where the outer edge of the board meets the background, i.e. an
+///        11x8 lattice of the same squares.
+SyntheticBoard makeLattice(const GridCase& gridCase)
+{
+    SyntheticBoardParameters params;
+    params.width = 1600;
+    params.height = 1200;
+    params.cols = kCols + 2;
+    params.rows = kRows + 2;
+    params.squareSize = kSquareSize;
+    params.angle = gridCase.angle;
+    params.shiftX = gridCase.shiftX;
+    params.shiftY = gridCase.shiftY;
+    return makeSyntheticBoard(params);
+}
+
+/// @brief Inner corner (row, col) of the 9x6 pattern in the 11x8 lattice.
+const std::pair<float, float>& innerCorner(const SyntheticBoard& lattice, int row, int col)
+{
+    return lattice.corners[(row + 1) * (kCols + 2) + (col + 1)];
+}
+
+bool isEdge(int index)
+{
+    const int row = index / (kCols + 2);
+    const int col = index % (kCols + 2);
+    return row == 0 || col == 0 || row == kRows + 1 || col == kCols + 1;
+}
+
+/// @brief Lattice corners less @p dropped of the edge ones, in a shuffled
+///        order, with @p clutter random points at least half a
+///        square away from any corner.
+Points makeDetections(const SyntheticBoard& lattice, int dropped, int clutter, std::mt19937& generator)
+{
+    Points points;
+    for (std::size_t i = 0; i < lattice.corners.size(); ++i) {
+        // Every third edge corner, so that they are spread around the board
+        if (dropped > 0 && isEdge(static_cast<int>(i)) && i % 3 == 0) {
+            --dropped;
+            continue;
+        }
+        points.push_back(lattice.corners[i]);
+    }
+    std::uniform_real_distribution<float> x(0.0F, 1600.0F);
+    std::uniform_real_distribution<float> y(0.0F, 1200.0F);
+    while (clutter > 0) {
+        const std::pair<float, float> point(x(generator), y(generator));
+        const bool nearCorner = std::any_of(lattice.corners.begin(), lattice.corners.end(), [&](const std::pair<float, float>& corner) {
+            return std::hypot(point.first - corner.first, point.second - corner.second) < 0.5F * kSquareSize;
+        });
+        if (!nearCorner) {
+            points.push_back(point);
+            --clutter;
+        }
+    }
+    std::shuffle(points.begin(), points.end(), generator);
+    return points;
+}
+
+} // namespace
+
+class ChessboardGridRecovery : public ::testing::TestWithParam<GridCase>
+{
+};
+
+TEST_P(ChessboardGridRecovery, OrdersInnerCorners)
+{
+    const GridCase& gridCase = GetParam();
+    const SyntheticBoard lattice = makeLattice(gridCase);
+    std::mt19937 generator(5U);
+    const Points detections = makeDetections(lattice, gridCase.droppedEdgeCorners, gridCase.clutter, generator);
+
+    ChessboardGridDetector detector;
+    ChessboardGrid grid;
+    ASSERT_TRUE(detector.recover(detections, kRows, kCols, grid));
+    ASSERT_EQ(grid.rows, kRows);
+    ASSERT_EQ(grid.cols, kCols);
+    ASSERT_EQ(grid.corners.size(), static_cast<std::size_t>(kRows * kCols));
+    // The origin is the top-left inner corner as seen, rows go down and
+    // columns go right
+    EXPECT_EQ(grid.at(0, 0), innerCorner(lattice, 0, 0));
+    for (int row = 0; row < kRows; ++row) {
+        for (int col = 0; col < kCols; ++col) {
+            EXPECT_EQ(grid.at(row, col), innerCorner(lattice, row, col)) << "row " << row << ", col " << col;
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(SyntheticLattices, ChessboardGridRecovery, ::testing::Values(
+    GridCase{0.0F, 0.0F, 0.0F, 0, 0},
+    GridCase{12.0F, 0.0F, 0.0F, 0, 0},
+    GridCase{-25.0F, 40.0F, -30.0F, 0, 0},
+    GridCase{40.0F, 0.0F, 0.0F, 0, 0},
+    GridCase{8.0F, -60.0F, 50.0F, 20, 0},
+    GridCase{-15.0F, 0.0F, 0.0F, 0, 4},
+    GridCase{30.0F, 25.0F, 10.0F, 20, 4}
+));
+
+TEST(ChessboardGrid, MergesDuplicateCorners)
+{
+    const SyntheticBoard lattice = makeLattice(GridCase{10.0F, 0.0F, 0.0F, 0, 0});
+    Points detections = lattice.corners;
+    // Equal responses kept by the suppression on a symmetric corner
+    for (int i = 0; i < 10; ++i) {
+        detections.emplace_back(lattice.corners[i * 7].first + 1.0F, lattice.corners[i * 7].second);
+    }
+    ChessboardGridDetector detector;
+    ChessboardGrid grid;
+    ASSERT_TRUE(detector.recover(detections, kRows, kCols, grid));
+    EXPECT_EQ(grid.at(0, 0), innerCorner(lattice, 0, 0));
+    EXPECT_EQ(grid.at(kRows - 1, kCols - 1), innerCorner(lattice, kRows - 1, kCols - 1));
+}
+
+TEST(ChessboardGrid, IntegerCorners)
+{
+    const SyntheticBoard lattice = makeLattice(GridCase{-20.0F, 0.0F, 0.0F, 0, 0});
+    std::vector<std::pair<int, int>> detections;
+    for (const auto& corner : lattice.corners) {
+        detections.emplace_back(static_cast<int>(std::lround(corner.first)), static_cast<int>(std::lround(corner.second)));
+    }
+    ChessboardGridDetector detector;
+    ChessboardGrid grid;
+    ASSERT_TRUE(detector.recover(detections, kRows, kCols, grid));
+    for (int row = 0; row < kRows; ++row) {
+        for (int col = 0; col < kCols; ++col) {
+            EXPECT_NEAR(grid.at(row, col).first, innerCorner(lattice, row, col).first, 0.5F);
+            EXPECT_NEAR(grid.at(row, col).second, innerCorner(lattice, row, col).second, 0.5F);
+        }
+    }
+}
+
+// Any 9x6 window of the 11x8 lattice covers its centre
+TEST(ChessboardGrid, MissingInnerCornerFails)
+{
+    const SyntheticBoard lattice = makeLattice(GridCase{5.0F, 0.0F, 0.0F, 0, 0});
+    Points detections = lattice.corners;
+    detections.erase(detections.begin() + 4 * (kCols + 2) + 5);
+    ChessboardGridDetector detector;
+    ChessboardGrid grid;
+    EXPECT_FALSE(detector.recover(detections, kRows, kCols, grid));
+}
+
+TEST(ChessboardGrid, TooFewCornersFails)
+{
+    const SyntheticBoard lattice = makeLattice(GridCase{0.0F, 0.0F, 0.0F, 0, 0});
+    const Points detections(lattice.corners.begin(), lattice.corners.begin() + 20);
+    ChessboardGridDetector detector;
+    ChessboardGrid grid;
+    EXPECT_FALSE(detector.recover(detections, kRows, kCols, grid));
+    EXPECT_FALSE(detector.recover(Points{}, kRows, kCols, grid));
+}
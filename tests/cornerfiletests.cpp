@@ -0,0 +1,249 @@
+/// @file cornerfiletests.cpp
+/// @brief Round trip, append and truncation rules of the corner file format
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "cornerfile.hpp"
+
+namespace {
+
+using IntCorners = std::vector<std::pair<int, int>>;
+using FloatCorners = std::vector<std::pair<float, float>>;
+
+std::string tempPath(const std::string& name)
+{
+    const std::string path = ::testing::TempDir() + name;
+    std::remove(path.c_str());
+    return path;
+}
+
+std::string readBytes(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+void writeBytes(const std::string& path, const std::string& bytes)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << bytes;
+}
+
+/// @brief Writes two frames, one of each format, and closes the file.
+void writeTwoFrames(const std::string& path)
+{
+    CornerFileWriter writer;
+    ASSERT_TRUE(writer.open(path));
+    writer.write(10, 640, 480, IntCorners{{1, 2}, {3, 4}}, std::vector<float>{5.0F, 6.0F});
+    writer.write(11, 640, 480, FloatCorners{{1.5F, 2.25F}}, std::vector<float>{7.0F});
+    ASSERT_TRUE(writer.close());
+}
+
+} // namespace
+
+TEST(CornerFile, RoundTrip)
+{
+    const std::string path = tempPath("corners_roundtrip.crn");
+    const IntCorners intCorners{{0, 0}, {1279, 719}, {70000, -5}, {65535, 65535}};
+    const std::vector<float> intResponses{1.0F, 2.5e9F, -3.0F, 0.0F};
+    const FloatCorners floatCorners{{0.125F, 719.875F}, {-1.5F, 1e-7F}, {65535.5F, 12.375F}};
+    const std::vector<float> floatResponses{4.0F, 5.0F, 6.0F};
+    {
+        // Batches smaller than a record, so that the writes are split
+        CornerFileWriter writer(64U);
+        ASSERT_TRUE(writer.open(path));
+        writer.write(0, 1280, 720, intCorners, intResponses);
+        writer.write(1, 1280, 720, IntCorners{}, std::vector<float>{});
+        writer.write(2, 1920, 1080, floatCorners, floatResponses);
+        writer.write(3, 1920, 1080, FloatCorners{}, std::vector<float>{});
+        // Missing responses are stored as zeros
+        writer.write(1ULL << 40U, 8, 8, IntCorners{{7, 7}}, std::vector<float>{});
+        ASSERT_TRUE(writer.close());
+    }
+
+    CornerFileReader reader;
+    ASSERT_TRUE(reader.open(path));
+    EXPECT_TRUE(reader.complete());
+    ASSERT_EQ(reader.frameCount(), 5U);
+
+    const CornerFrameView ints = reader.frame(0);
+    EXPECT_EQ(ints.frameId, 0U);
+    EXPECT_EQ(ints.width, 1280);
+    EXPECT_EQ(ints.height, 720);
+    EXPECT_EQ(ints.format, CornerFormat::Int);
+    ASSERT_EQ(ints.cornerCount, intCorners.size());
+    ASSERT_NE(ints.intPoints, nullptr);
+    EXPECT_EQ(ints.floatPoints, nullptr);
+    // Coordinates out of the uint16 range are clamped
+    const std::vector<std::pair<float, float>> expectedInts{{0.0F, 0.0F}, {1279.0F, 719.0F}, {65535.0F, 0.0F}, {65535.0F, 65535.0F}};
+    for (std::size_t i = 0; i < intCorners.size(); ++i) {
+        EXPECT_EQ(ints.x(i), expectedInts[i].first) << i;
+        EXPECT_EQ(ints.y(i), expectedInts[i].second) << i;
+        EXPECT_EQ(ints.response(i), intResponses[i]) << i;
+    }
+
+    const CornerFrameView emptyInts = reader.frame(1);
+    EXPECT_EQ(emptyInts.frameId, 1U);
+    EXPECT_EQ(emptyInts.cornerCount, 0U);
+
+    const CornerFrameView floats = reader.frame(2);
+    EXPECT_EQ(floats.frameId, 2U);
+    EXPECT_EQ(floats.width, 1920);
+    EXPECT_EQ(floats.format, CornerFormat::Float);
+    ASSERT_EQ(floats.cornerCount, floatCorners.size());
+    ASSERT_NE(floats.floatPoints, nullptr);
+    EXPECT_EQ(floats.intPoints, nullptr);
+    for (std::size_t i = 0; i < floatCorners.size(); ++i) {
+        EXPECT_EQ(floats.x(i), floatCorners[i].first) << i;
+        EXPECT_EQ(floats.y(i), floatCorners[i].second) << i;
+        EXPECT_EQ(floats.response(i), floatResponses[i]) << i;
+    }
+
+    EXPECT_EQ(reader.frame(3).cornerCount, 0U);
+    EXPECT_EQ(reader.frame(3).format, CornerFormat::Float);
+    const CornerFrameView last = reader.frame(4);
+    EXPECT_EQ(last.frameId, 1ULL << 40U);
+    ASSERT_EQ(last.cornerCount, 1U);
+    EXPECT_EQ(last.response(0), 0.0F);
+
+    // Header, then each record header and its points
+    EXPECT_EQ(readBytes(path).size(), sizeof(CornerFileHeader) + 5 * sizeof(CornerRecordHeader)
+        + 5 * sizeof(CornerPointInt) + 3 * sizeof(CornerPointFloat));
+    std::remove(path.c_str());
+}
+
+// flush() makes the pending records visible without closing
+TEST(CornerFile, FlushPublishesRecords)
+{
+    const std::string path = tempPath("corners_flush.crn");
+    CornerFileWriter writer;
+    ASSERT_TRUE(writer.open(path));
+    writer.write(0, 4, 4, IntCorners{{1, 1}}, std::vector<float>{1.0F});
+    ASSERT_TRUE(writer.flush());
+    CornerFileReader reader;
+    ASSERT_TRUE(reader.open(path));
+    EXPECT_EQ(reader.frameCount(), 1U);
+    EXPECT_TRUE(reader.complete());
+    ASSERT_TRUE(writer.close());
+    std::remove(path.c_str());
+}
+
+TEST(CornerFile, AppendsToExistingFile)
+{
+    const std::string path = tempPath("corners_append.crn");
+    writeTwoFrames(path);
+    const std::string before = readBytes(path);
+    {
+        CornerFileWriter writer;
+        ASSERT_TRUE(writer.open(path));
+        writer.write(12, 320, 240, IntCorners{{9, 8}}, std::vector<float>{3.0F});
+        ASSERT_TRUE(writer.close());
+    }
+    // The existing bytes are untouched, no second file header
+    const std::string after = readBytes(path);
+    ASSERT_GT(after.size(), before.size());
+    EXPECT_EQ(after.compare(0, before.size(), before), 0);
+    EXPECT_EQ(after.size() - before.size(), sizeof(CornerRecordHeader) + sizeof(CornerPointInt));
+
+    CornerFileReader reader;
+    ASSERT_TRUE(reader.open(path));
+    EXPECT_TRUE(reader.complete());
+    ASSERT_EQ(reader.frameCount(), 3U);
+    EXPECT_EQ(reader.frame(0).frameId, 10U);
+    EXPECT_EQ(reader.frame(1).frameId, 11U);
+    EXPECT_EQ(reader.frame(1).x(0), 1.5F);
+    EXPECT_EQ(reader.frame(2).frameId, 12U);
+    EXPECT_EQ(reader.frame(2).x(0), 9.0F);
+    EXPECT_EQ(reader.frame(2).y(0), 8.0F);
+    std::remove(path.c_str());
+}
+
+TEST(CornerFile, TruncatedRecordIsIgnoredAndNotAppended)
+{
+    const std::string path = tempPath("corners_truncated.crn");
+    writeTwoFrames(path);
+    const std::string bytes = readBytes(path);
+    // Cut in the points of the last record, then in its header
+    for (std::size_t cut : {std::size_t{4}, sizeof(CornerPointFloat) + 8}) {
+        SCOPED_TRACE(cut);
+        const std::string truncated = bytes.substr(0, bytes.size() - cut);
+        writeBytes(path, truncated);
+
+        CornerFileReader reader;
+        ASSERT_TRUE(reader.open(path));
+        EXPECT_FALSE(reader.complete());
+        ASSERT_EQ(reader.frameCount(), 1U);
+        EXPECT_EQ(reader.frame(0).frameId, 10U);
+        EXPECT_EQ(reader.frame(0).x(1), 3.0F);
+
+        // A record after the truncated one could never be read
+        CornerFileWriter writer;
+        EXPECT_FALSE(writer.open(path));
+        EXPECT_EQ(readBytes(path), truncated);
+    }
+    std::remove(path.c_str());
+}
+
+TEST(CornerFile, RejectsOtherFiles)
+{
+    const std::string path = tempPath("corners_other.crn");
+    CornerFileHeader wrongVersion{};
+    for (int i = 0; i < 4; ++i) {
+        wrongVersion.magic[i] = kCornerFileMagic[i];
+    }
+    wrongVersion.version = kCornerFileVersion + 1;
+    const std::vector<std::string> others{
+        "frame,x,y,response\n0,1,2,3.5\n",
+        std::string(reinterpret_cast<const char*>(&wrongVersion), sizeof(wrongVersion)),
+        "CRN",
+    };
+    for (const std::string& other : others) {
+        writeBytes(path, other);
+        CornerFileReader reader;
+        EXPECT_FALSE(reader.open(path));
+        // Never overwritten nor appended to
+        CornerFileWriter writer;
+        EXPECT_FALSE(writer.open(path));
+        EXPECT_EQ(readBytes(path), other);
+    }
+    std::remove(path.c_str());
+
+    CornerFileReader reader;
+    EXPECT_FALSE(reader.open(tempPath("corners_missing.crn")));
+}
+
+// A new or empty file gets the file header, and no record yet
+TEST(CornerFile, EmptyFileIsCreated)
+{
+    const std::string path = tempPath("corners_empty.crn");
+    writeBytes(path, "");
+    {
+        CornerFileWriter writer;
+        ASSERT_TRUE(writer.open(path));
+        ASSERT_TRUE(writer.close());
+    }
+    EXPECT_EQ(readBytes(path).size(), sizeof(CornerFileHeader));
+    CornerFileReader reader;
+    ASSERT_TRUE(reader.open(path));
+    EXPECT_TRUE(reader.complete());
+    EXPECT_EQ(reader.frameCount(), 0U);
+    std::remove(path.c_str());
+}
+
+TEST(CornerFile, Extension)
+{
+    EXPECT_TRUE(hasCornerFileExtension("session/corners.crn"));
+    EXPECT_FALSE(hasCornerFileExtension("corners.csv"));
+    EXPECT_FALSE(hasCornerFileExtension(".crn"));
+    EXPECT_FALSE(hasCornerFileExtension("corners.crn.csv"));
+}
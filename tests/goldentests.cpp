@@ -0,0 +1,141 @@
+/// @file goldentests.cpp
+/// @brief Corners of reference inputs compared with the stored golden output
+///
+/// Set HARRIS_UPDATE_GOLDEN=1 in the environment to rewrite the golden files
+/// from the current build instead, after a change that is meant to move the
+/// corners.
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#include <cstdlib>
+#include <fstream>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "harrisdetector.hpp"
+#include "syntheticboard.hpp"
+
+/// @brief Reference input, detected with detect(). The boards are
+///        axis-aligned and noise free, so that the input does not depend on
+///        the math library.
+struct GoldenCase
+{
+    // Golden file in tests/data
+    const char* file;
+    const char* description;
+    SyntheticBoardParameters board;
+    HarrisParameters params;
+};
+
+std::ostream& operator<<(std::ostream& stream, const GoldenCase& golden)
+{
+    return stream << golden.file;
+}
+
+namespace {
+
+using Corners = std::vector<std::pair<int, int>>;
+
+/// @brief Reads a golden file of "x,y" lines, '#' starting a comment line.
+/// @return False if the file could not be read.
+bool readGolden(const std::string& path, Corners& corners)
+{
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+    corners.clear();
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream fields(line);
+        int x = 0;
+        int y = 0;
+        char comma = 0;
+        if (fields >> x >> comma >> y && comma == ',') {
+            corners.emplace_back(x, y);
+        }
+    }
+    return true;
+}
+
+bool writeGolden(const std::string& path, const std::string& description, const Corners& corners)
+{
+    std::ofstream file(path);
+    file << "# " << description << "\n# x,y\n";
+    for (const auto& corner : corners) {
+        file << corner.first << ',' << corner.second << '\n';
+    }
+    return static_cast<bool>(file);
+}
+
+HarrisParameters boardParameters()
+{
+    HarrisParameters params;
+    params.windowOffset = 2;
+    params.thresholdPercent = 0.1F;
+    params.nmsWindowOffset = 10;
+    return params;
+}
+
+HarrisParameters pyramidParameters()
+{
+    HarrisParameters params = boardParameters();
+    params.pyramidLevels = 1;
+    params.pyramidSearchOffset = 4;
+    return params;
+}
+
+HarrisParameters tileParameters()
+{
+    HarrisParameters params;
+    params.thresholdTileSize = 64;
+    return params;
+}
+
+/// @brief Board of the default size, blurred by @p blurSigma and shifted by a
+///        fraction of a pixel.
+SyntheticBoardParameters board(const float blurSigma, const float shift)
+{
+    SyntheticBoardParameters params;
+    params.blurSigma = blurSigma;
+    params.shiftX = shift;
+    params.shiftY = -shift;
+    return params;
+}
+
+} // namespace
+
+class GoldenOutput : public ::testing::TestWithParam<GoldenCase>
+{
+};
+
+TEST_P(GoldenOutput, MatchesStoredCorners)
+{
+    const GoldenCase& golden = GetParam();
+    const SyntheticBoard input = makeSyntheticBoard(golden.board);
+    HarrisChessCornersDetector detector{};
+    detector.detect(input.image, golden.params);
+
+    const std::string path = std::string(HARRIS_TEST_DATA_DIR) + "/" + golden.file;
+    if (std::getenv("HARRIS_UPDATE_GOLDEN") != nullptr) {
+        ASSERT_TRUE(writeGolden(path, golden.description, detector.m_cornersLocation)) << path;
+        return;
+    }
+    Corners expected;
+    ASSERT_TRUE(readGolden(path, expected)) << "Cannot read " << path;
+    EXPECT_EQ(detector.m_cornersLocation, expected);
+}
+
+INSTANTIATE_TEST_SUITE_P(ReferenceInputs, GoldenOutput, ::testing::Values(
+    GoldenCase{"golden_default.csv", "1280x720 board, blur 1, default HarrisParameters", board(1.0F, 0.0F), HarrisParameters{}},
+    GoldenCase{"golden_board.csv", "1280x720 board, blur 1.5, shift 0.3, settings of app/main.cpp", board(1.5F, 0.3F), boardParameters()},
+    GoldenCase{"golden_pyramid.csv", "1280x720 board, blur 1.5, shift 0.3, settings of app/main.cpp, 1 pyramid level", board(1.5F, 0.3F), pyramidParameters()},
+    GoldenCase{"golden_tiles.csv", "1280x720 board, blur 1, shift 0.3, 64 pixel threshold tiles", board(1.0F, 0.3F), tileParameters()}
+));
@@ -0,0 +1,73 @@
+/// @file harrisbatchtests.cpp
+/// @brief Results of HarrisBatchDetector against serial detections
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <gtest/gtest.h>
+#include "harrisbatch.hpp"
+#include "harrisdetector.hpp"
+#include "syntheticboard.hpp"
+
+namespace {
+
+/// @brief Boards of mixed resolutions and poses, not sorted by size so that
+///        the batch detection order differs from the input one.
+std::vector<SyntheticBoard> makeBatch()
+{
+    struct Shot
+    {
+        int width;
+        int height;
+        float angle;
+    };
+    std::vector<SyntheticBoard> boards;
+    for (const Shot& shot : {Shot{640, 480, 5.0F}, Shot{1920, 1080, -12.0F}, Shot{800, 600, 20.0F},
+                             Shot{1280, 720, 0.0F}, Shot{1920, 1080, 30.0F}, Shot{640, 480, -25.0F}}) {
+        SyntheticBoardParameters params;
+        params.width = shot.width;
+        params.height = shot.height;
+        params.angle = shot.angle;
+        params.blurSigma = 1.0F;
+        params.noiseSigma = 3.0F;
+        params.seed = static_cast<uint32_t>(boards.size() + 1U);
+        boards.push_back(makeSyntheticBoard(params));
+    }
+    return boards;
+}
+
+} // namespace
+
+TEST(HarrisBatch, MatchesSerialDetectionInInputOrder)
+{
+    const std::vector<SyntheticBoard> boards = makeBatch();
+    std::vector<ImageView<const uint8_t>> images;
+    for (const SyntheticBoard& board : boards) {
+        images.push_back(board.image);
+    }
+    HarrisParameters params;
+    params.windowOffset = 2;
+    params.thresholdPercent = 0.1F;
+    params.nmsWindowOffset = 10;
+    HarrisBatchDetector batchDetector(4, params);
+    batchDetector.detectBatch(images);
+    ASSERT_EQ(batchDetector.results().size(), images.size());
+
+    HarrisChessCornersDetector serial{};
+    std::size_t corners = 0;
+    for (std::size_t image = 0; image < images.size(); ++image) {
+        SCOPED_TRACE(image);
+        serial.detect(images[image], params);
+        ASSERT_FALSE(serial.m_cornersLocation.empty());
+        EXPECT_EQ(batchDetector.results()[image].cornersLocation, serial.m_cornersLocation);
+        EXPECT_EQ(batchDetector.results()[image].cornersResponse, serial.m_cornersResponse);
+        corners += serial.m_cornersLocation.size();
+    }
+    EXPECT_EQ(batchDetector.report().images, images.size());
+    EXPECT_EQ(batchDetector.report().corners, corners);
+}
@@ -0,0 +1,445 @@
+/// @file harrisdetectortests.cpp
+/// @brief Recall and localization of HarrisChessCornersDetector on synthetic
+///        boards, and agreement between its execution modes
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <ostream>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "harrisdetector.hpp"
+#include "harrispipeline.hpp"
+#include "syntheticboard.hpp"
+
+/// @brief Imaging conditions of a synthetic board.
+struct Conditions
+{
+    float angle;
+    float blurSigma;
+    float noiseSigma;
+};
+
+std::ostream& operator<<(std::ostream& stream, const Conditions& conditions)
+{
+    return stream << "angle " << conditions.angle << ", blur " << conditions.blurSigma
+                  << ", noise " << conditions.noiseSigma;
+}
+
+namespace {
+
+// Distance below which a detection matches a ground truth corner, the
+// integer location of a blurred corner can be off by 1.5 pixels per axis
+constexpr float kMatchDistance = 3.0F;
+
+/// @brief Settings of app/main.cpp to find every corner of the board, i.e.
+///        loose threshold and a suppression window in the order of the square
+///        size.
+HarrisParameters boardParameters()
+{
+    HarrisParameters params;
+    params.windowOffset = 2;
+    params.thresholdPercent = 0.1F;
+    params.nmsWindowOffset = 10;
+    return params;
+}
+
+/// @brief Frame of a board moving along the stream, by default blurred and
+///        noisy as a camera frame.
+SyntheticBoard makeMovingBoard(
+    const float shiftX,
+    const float shiftY,
+    const uint32_t seed,
+    const Conditions& conditions = Conditions{10.0F, 1.0F, 2.0F}
+    )
+{
+    SyntheticBoardParameters params;
+    params.angle = conditions.angle;
+    params.shiftX = shiftX;
+    params.shiftY = shiftY;
+    params.blurSigma = conditions.blurSigma;
+    params.noiseSigma = conditions.noiseSigma;
+    params.seed = seed;
+    return makeSyntheticBoard(params);
+}
+
+std::vector<std::pair<int, int>> sortedCorners(std::vector<std::pair<int, int>> corners)
+{
+    std::sort(corners.begin(), corners.end());
+    return corners;
+}
+
+SyntheticBoard makeBoard(const Conditions& conditions)
+{
+    SyntheticBoardParameters params;
+    params.angle = conditions.angle;
+    params.blurSigma = conditions.blurSigma;
+    params.noiseSigma = conditions.noiseSigma;
+    return makeSyntheticBoard(params);
+}
+
+/// @brief Interior pixels of the magnitude and orientation planes that differ
+///        from sqrt(gx^2 + gy^2) and atan(gy / gx) over the current gradient
+///        planes of @p detector.
+std::size_t derivedPlaneMismatches(
+    const HarrisChessCornersDetector& detector,
+    const Image<float>& magnitude,
+    const Image<float>& orientation
+    )
+{
+    const Image<float>& gradX = detector.m_gradientX;
+    const Image<float>& gradY = detector.m_gradientY;
+    std::size_t mismatches = 0U;
+    for (int y = 1; y < gradX.height() - 1; ++y) {
+        for (int x = 1; x < gradX.width() - 1; ++x) {
+            const float gx = gradX.row(y)[x];
+            const float gy = gradY.row(y)[x];
+            const float expectedMag = std::sqrt(gx * gx + gy * gy);
+            const float expectedOri = std::atan(gy / (gx != 0.0F ? gx : std::numeric_limits<float>::min()));
+            mismatches += std::abs(magnitude.row(y)[x] - expectedMag) > 1e-5F * expectedMag + 1e-5F ? 1U : 0U;
+            mismatches += std::abs(orientation.row(y)[x] - expectedOri) > 1e-6F ? 1U : 0U;
+        }
+    }
+    return mismatches;
+}
+
+/// @brief Interior pixels that differ between two planes of the same size.
+std::size_t planeMismatches(const Image<float>& a, const Image<float>& b)
+{
+    std::size_t mismatches = 0U;
+    for (int y = 1; y < a.height() - 1; ++y) {
+        for (int x = 1; x < a.width() - 1; ++x) {
+            mismatches += a.row(y)[x] != b.row(y)[x] ? 1U : 0U;
+        }
+    }
+    return mismatches;
+}
+
+} // namespace
+
+class HarrisAccuracy : public ::testing::TestWithParam<Conditions>
+{
+};
+
+TEST_P(HarrisAccuracy, FindsAndLocalizesEveryCorner)
+{
+    const SyntheticBoard board = makeBoard(GetParam());
+    HarrisChessCornersDetector detector{};
+    detector.detect(board.image, boardParameters());
+    const CornerMatch integer = matchCorners(board.corners, detector.m_cornersLocation, kMatchDistance);
+    EXPECT_EQ(integer.recall, 1.0F);
+
+    // The refinement runs on the gradient planes of the same image
+    detector.computeGradients(board.image);
+    detector.refineCorners();
+    const CornerMatch refined = matchCorners(board.corners, detector.m_cornersSubPixel, kMatchDistance);
+    EXPECT_EQ(refined.recall, 1.0F);
+    EXPECT_LT(refined.meanError, 0.3F);
+    EXPECT_LT(refined.maxError, 0.6F);
+}
+
+INSTANTIATE_TEST_SUITE_P(SyntheticBoards, HarrisAccuracy, ::testing::Values(
+    Conditions{0.0F, 0.0F, 0.0F},
+    Conditions{0.0F, 1.0F, 0.0F},
+    Conditions{10.0F, 0.0F, 0.0F},
+    Conditions{15.0F, 1.0F, 2.0F},
+    Conditions{-20.0F, 0.8F, 8.0F},
+    Conditions{30.0F, 1.5F, 5.0F},
+    Conditions{45.0F, 1.0F, 4.0F}
+));
+
+TEST(HarrisDetector, StagedAndFusedAgree)
+{
+#if defined(HARRIS_FIXED_POINT)
+    GTEST_SKIP() << "The fused pipeline uses fixed-point arithmetic";
+#endif
+    const SyntheticBoard board = makeBoard(Conditions{15.0F, 1.0F, 2.0F});
+    const HarrisParameters params{};
+    HarrisChessCornersDetector fused{};
+    fused.detect(board.image, params);
+
+    HarrisChessCornersDetector staged{};
+    staged.computeGradients(board.image);
+    staged.cornerResponse_method2(params.sigma, params.k, params.windowOffset, params.tensorWeighting);
+    staged.thresholding(params.thresholdPercent);
+    staged.nonMaximalSuppression(params.nmsWindowOffset);
+    EXPECT_EQ(fused.m_cornersLocation, staged.m_cornersLocation);
+    EXPECT_EQ(fused.m_maxResponse, staged.m_maxResponse);
+    EXPECT_EQ(fused.m_maxResponseLocation, staged.m_maxResponseLocation);
+}
+
+// Magnitude and orientation are derived once per computeGradients() call, and
+// rebuilt for the next frame even though the planes keep their size
+TEST(HarrisDetector, GradientPlanesAreCachedPerFrame)
+{
+    const SyntheticBoard first = makeBoard(Conditions{15.0F, 1.0F, 2.0F});
+    const SyntheticBoard second = makeBoard(Conditions{-20.0F, 0.8F, 8.0F});
+    HarrisChessCornersDetector detector{};
+    detector.computeGradients(first.image);
+    const Image<float>& magnitude = detector.gradientMagnitude();
+    const Image<float>& orientation = detector.gradientOrientation();
+    ASSERT_EQ(magnitude.width(), first.image.width());
+    ASSERT_EQ(magnitude.height(), first.image.height());
+    EXPECT_EQ(derivedPlaneMismatches(detector, magnitude, orientation), 0U);
+
+    // Later requests return the cached planes, edits of the gradient planes
+    // are only seen after the next computeGradients() call
+    const Image<float> firstMagnitude = magnitude;
+    const Image<float> firstOrientation = orientation;
+    const float* magnitudeData = magnitude.row(0);
+    const float* orientationData = orientation.row(0);
+    const std::size_t allocations = imageAllocationCount();
+    detector.m_gradientX.row(first.image.height() / 2)[first.image.width() / 2] += 100.0F;
+    EXPECT_EQ(&detector.gradientMagnitude(), &magnitude);
+    EXPECT_EQ(&detector.gradientOrientation(), &orientation);
+    EXPECT_EQ(planeMismatches(detector.gradientMagnitude(), firstMagnitude), 0U);
+    EXPECT_EQ(planeMismatches(detector.gradientOrientation(), firstOrientation), 0U);
+
+    // Another frame of the same size reuses the buffers but not the values
+    detector.computeGradients(second.image);
+    EXPECT_EQ(derivedPlaneMismatches(detector, detector.gradientMagnitude(), detector.gradientOrientation()), 0U);
+    EXPECT_EQ(detector.gradientMagnitude().row(0), magnitudeData);
+    EXPECT_EQ(detector.gradientOrientation().row(0), orientationData);
+    EXPECT_EQ(imageAllocationCount(), allocations);
+    EXPECT_GT(planeMismatches(detector.gradientMagnitude(), firstMagnitude), 0U);
+    EXPECT_GT(planeMismatches(detector.gradientOrientation(), firstOrientation), 0U);
+
+    // The staged method 1 on the cached planes, then on the planes it derives
+    // itself, gives the response and corners of a fresh detector
+    for (const SyntheticBoard* board : {&second, &first}) {
+        if (board == &first) {
+            detector.computeGradients(first.image);
+        }
+        detector.cornerResponse_method1();
+        detector.thresholding();
+        detector.nonMaximalSuppression(10);
+        HarrisChessCornersDetector fresh{};
+        fresh.computeGradients(board->image);
+        fresh.cornerResponse_method1();
+        fresh.thresholding();
+        fresh.nonMaximalSuppression(10);
+        EXPECT_EQ(planeMismatches(detector.m_cornerResponseMap, fresh.m_cornerResponseMap), 0U);
+        EXPECT_EQ(detector.m_maxResponse, fresh.m_maxResponse);
+        EXPECT_EQ(detector.m_maxResponseLocation, fresh.m_maxResponseLocation);
+        EXPECT_FALSE(fresh.m_cornersLocation.empty());
+        EXPECT_EQ(detector.m_cornersLocation, fresh.m_cornersLocation);
+    }
+}
+
+TEST(HarrisDetector, ThreadsGiveSerialCorners)
+{
+    const SyntheticBoard board = makeBoard(Conditions{-20.0F, 0.8F, 8.0F});
+    HarrisParameters params = boardParameters();
+    HarrisChessCornersDetector serial{};
+    serial.detect(board.image, params);
+    ASSERT_FALSE(serial.m_cornersLocation.empty());
+    for (int threads : {2, 3, 8}) {
+        for (int bandHeight : {0, 1, 37}) {
+            HarrisChessCornersDetector parallel{};
+            parallel.setParallelism(threads, bandHeight);
+            parallel.detect(board.image, params);
+            EXPECT_EQ(parallel.m_cornersLocation, serial.m_cornersLocation) << threads << " threads, bands of " << bandHeight;
+            EXPECT_EQ(parallel.m_cornersResponse, serial.m_cornersResponse) << threads << " threads, bands of " << bandHeight;
+        }
+    }
+}
+
+TEST(HarrisDetector, SpecializedPipelinesMatchGeneric)
+{
+    const SyntheticBoard board = makeBoard(Conditions{30.0F, 1.5F, 5.0F});
+    const ImageRect frame{0, 0, board.image.width(), board.image.height()};
+    struct Configuration
+    {
+        int window;
+        int nms;
+        TensorWeighting weighting;
+    };
+    std::vector<Configuration> configurations{
+        {1, 1, TensorWeighting::Box}, {1, 2, TensorWeighting::Box},
+        {2, 2, TensorWeighting::Box}, {2, 10, TensorWeighting::Box}
+    };
+#if !defined(__FMA__)
+    // Exact only if the compiler cannot fuse the Gaussian taps, see
+    // harris::selectDetectRegion()
+    configurations.push_back({1, 1, TensorWeighting::Gaussian});
+    configurations.push_back({2, 2, TensorWeighting::Gaussian});
+#endif
+    for (const Configuration& configuration : configurations) {
+        HarrisParameters params;
+        params.windowOffset = configuration.window;
+        params.sigma = static_cast<float>(configuration.window);
+        params.tensorWeighting = configuration.weighting;
+        params.nmsWindowOffset = configuration.nms;
+        harris::PipelineWorkspace workspace;
+        harris::RegionResult generic;
+        harris::RegionResult specialized;
+        harris::detectRegion<harris::DefaultPrecision>(board.image, frame, params, workspace, generic);
+        const auto detectRegion = harris::selectDetectRegion<harris::DefaultPrecision>(params);
+        EXPECT_NE(detectRegion, &harris::detectRegion<harris::DefaultPrecision>);
+        detectRegion(board.image, frame, params, workspace, specialized);
+        ASSERT_EQ(specialized.candidates.size(), generic.candidates.size()) << "window " << configuration.window << ", nms " << configuration.nms;
+        for (std::size_t i = 0; i < generic.candidates.size(); ++i) {
+            EXPECT_EQ(specialized.candidates[i].x, generic.candidates[i].x);
+            EXPECT_EQ(specialized.candidates[i].y, generic.candidates[i].y);
+            EXPECT_EQ(specialized.candidates[i].response, generic.candidates[i].response);
+        }
+        EXPECT_EQ(specialized.maxResponse, generic.maxResponse);
+    }
+}
+
+TEST(HarrisDetector, PyramidFindsEveryCorner)
+{
+    SyntheticBoardParameters boardParams;
+    boardParams.width = 3840;
+    boardParams.height = 2160;
+    boardParams.angle = 10.0F;
+    boardParams.blurSigma = 1.0F;
+    const SyntheticBoard board = makeSyntheticBoard(boardParams);
+    HarrisParameters params = boardParameters();
+    params.pyramidLevels = 2;
+    // The integer location of a corner is off by up to 1.5 pixels at each
+    // level, which the relocation window has to absorb
+    params.pyramidSearchOffset = 6;
+    HarrisChessCornersDetector detector{};
+    detector.detect(board.image, params);
+    EXPECT_EQ(matchCorners(board.corners, detector.m_cornersLocation, kMatchDistance).recall, 1.0F);
+}
+
+TEST(HarrisDetector, TilesKeepDimCorners)
+{
+    // Contrast dropping to a tenth from the right to the left of the frame
+    SyntheticBoard board = makeBoard(Conditions{0.0F, 1.0F, 0.0F});
+    Image<uint8_t>& image = board.image;
+    for (int y = 0; y < image.height(); ++y) {
+        for (int x = 0; x < image.width(); ++x) {
+            const float gain = 0.1F + 0.9F * static_cast<float>(x) / static_cast<float>(image.width());
+            image(y, x) = static_cast<uint8_t>(static_cast<float>(image(y, x)) * gain);
+        }
+    }
+    HarrisParameters params{};
+    HarrisChessCornersDetector detector{};
+    detector.detect(image, params);
+    EXPECT_LT(matchCorners(board.corners, detector.m_cornersLocation, kMatchDistance).recall, 0.5F);
+    // Tiles smaller than the squares, so that each one holds a corner
+    params.thresholdTileSize = 64;
+    detector.detect(image, params);
+    EXPECT_EQ(matchCorners(board.corners, detector.m_cornersLocation, kMatchDistance).recall, 1.0F);
+    // Same tiles in the staged API
+    detector.computeGradients(image);
+    detector.cornerResponse_method2();
+    detector.thresholding(params.thresholdPercent, params.thresholdTileSize, params.thresholdFloorPercent);
+    detector.nonMaximalSuppression();
+    EXPECT_EQ(matchCorners(board.corners, detector.m_cornersLocation, kMatchDistance).recall, 1.0F);
+}
+
+// 8K frame of a dense board, the input of the stress and throughput runs
+TEST(HarrisDetector, Stress8K)
+{
+    SyntheticBoardParameters boardParams;
+    boardParams.width = 7680;
+    boardParams.height = 4320;
+    boardParams.cols = 39;
+    boardParams.rows = 21;
+    boardParams.angle = 7.0F;
+    boardParams.noiseSigma = 3.0F;
+    const SyntheticBoard board = makeSyntheticBoard(boardParams);
+    HarrisChessCornersDetector detector{};
+    detector.setParallelism(4);
+    detector.detect(board.image);
+    const CornerMatch match = matchCorners(board.corners, detector.m_cornersLocation, kMatchDistance);
+    EXPECT_EQ(match.recall, 1.0F);
+    EXPECT_LT(match.meanError, 1.5F);
+}
+
+// Tracked frames report the corners of a full detection of the same frame.
+// On a noise-free axis-aligned board the full detection also keeps the
+// plateau ties of a corner, a few pixels apart, of which a tracked frame
+// reports one.
+TEST(HarrisDetector, TrackingFollowsMovingBoard)
+{
+    HarrisParameters params = boardParameters();
+    params.keyframeInterval = 8;
+    for (const Conditions& conditions : {Conditions{10.0F, 1.0F, 2.0F}, Conditions{0.0F, 1.0F, 0.0F}}) {
+        SCOPED_TRACE(conditions);
+        const bool noiseFree = conditions.noiseSigma == 0.0F;
+        HarrisChessCornersDetector tracker{};
+        HarrisChessCornersDetector reference{};
+        bool ties = false;
+        for (int frame = 0; frame < 12; ++frame) {
+            SCOPED_TRACE(frame);
+            // 3 pixels per frame to the right, 2 down, i.e. several windows
+            // offsets once the motion is compensated
+            const SyntheticBoard board = makeMovingBoard(
+                3.0F * static_cast<float>(frame), 2.0F * static_cast<float>(frame), frame + 1U, conditions);
+            tracker.track(board.image, params);
+            // Keyframes on the first frame and every keyframeInterval frames
+            EXPECT_EQ(tracker.lastFrameTracked(), frame % params.keyframeInterval != 0);
+            reference.detect(board.image, params);
+            EXPECT_EQ(matchCorners(board.corners, tracker.m_cornersLocation, kMatchDistance).recall, 1.0F);
+            if (!noiseFree) {
+                EXPECT_EQ(sortedCorners(tracker.m_cornersLocation), sortedCorners(reference.m_cornersLocation));
+                continue;
+            }
+            // Ties of a corner lie within its suppression window, distinct
+            // maxima further apart
+            std::size_t distinctCorners = 0;
+            for (std::size_t i = 0; i < reference.m_cornersLocation.size(); ++i) {
+                const auto& corner = reference.m_cornersLocation[i];
+                distinctCorners += std::none_of(
+                    reference.m_cornersLocation.begin(), reference.m_cornersLocation.begin() + i, [&](const std::pair<int, int>& other) {
+                        return std::abs(other.first - corner.first) <= params.nmsWindowOffset
+                            && std::abs(other.second - corner.second) <= params.nmsWindowOffset;
+                    }) ? 1U : 0U;
+            }
+            ties = ties || distinctCorners < reference.m_cornersLocation.size();
+            if (tracker.lastFrameTracked()) {
+                // One corner per tie group, among the detected ones
+                EXPECT_EQ(tracker.m_cornersLocation.size(), distinctCorners);
+                for (const auto& corner : tracker.m_cornersLocation) {
+                    EXPECT_NE(
+                        std::find(reference.m_cornersLocation.begin(), reference.m_cornersLocation.end(), corner),
+                        reference.m_cornersLocation.end()
+                        ) << corner.first << ", " << corner.second;
+                }
+            }
+        }
+        EXPECT_EQ(ties, noiseFree);
+    }
+}
+
+// A jump larger than the search windows loses the corners, and the frame is
+// detected in full
+TEST(HarrisDetector, TrackingFallsBackOnJump)
+{
+    HarrisParameters params = boardParameters();
+    HarrisChessCornersDetector tracker{};
+    tracker.track(makeMovingBoard(0.0F, 0.0F, 1U).image, params);
+    EXPECT_FALSE(tracker.lastFrameTracked());
+    tracker.track(makeMovingBoard(2.0F, 0.0F, 2U).image, params);
+    EXPECT_TRUE(tracker.lastFrameTracked());
+
+    const SyntheticBoard jumped = makeMovingBoard(2.0F + 3.0F * static_cast<float>(params.trackingSearchOffset), 0.0F, 3U);
+    tracker.track(jumped.image, params);
+    EXPECT_FALSE(tracker.lastFrameTracked());
+    HarrisChessCornersDetector reference{};
+    reference.detect(jumped.image, params);
+    EXPECT_EQ(tracker.m_cornersLocation, reference.m_cornersLocation);
+    EXPECT_EQ(tracker.m_maxResponse, reference.m_maxResponse);
+
+    // Tracked again from the new keyframe, until the tracking is reset
+    tracker.track(makeMovingBoard(4.0F + 3.0F * static_cast<float>(params.trackingSearchOffset), 0.0F, 4U).image, params);
+    EXPECT_TRUE(tracker.lastFrameTracked());
+    tracker.resetTracking();
+    tracker.track(jumped.image, params);
+    EXPECT_FALSE(tracker.lastFrameTracked());
+    EXPECT_EQ(tracker.m_cornersLocation, reference.m_cornersLocation);
+}
@@ -0,0 +1,181 @@
+/// @file harriskernelstests.cpp
+/// @brief Separable Sobel and Gaussian kernels against the direct 2D sums, on
+///        whichever instruction set harris::simdInstructionSet() reports
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "harriskernels.hpp"
+
+namespace {
+
+// Odd widths, around and between the vector lengths, and the padding added to
+// them to get the row stride
+const std::vector<int> kWidths{3, 4, 7, 9, 17, 31, 67, 133};
+const std::vector<int> kPaddings{0, 3, 13};
+
+// Value written outside the columns a kernel was asked for
+constexpr float kUntouched = -12345.0F;
+
+/// @brief Random 8-bit plane of @p width x @p height pixels, rows
+///        @p width + @p padding apart. The padding holds random values too.
+std::vector<uint8_t> randomPixels(int width, int height, int padding, std::mt19937& generator)
+{
+    std::uniform_int_distribution<int> level(0, 255);
+    std::vector<uint8_t> pixels(static_cast<std::size_t>(width + padding) * height);
+    for (uint8_t& pixel : pixels) {
+        pixel = static_cast<uint8_t>(level(generator));
+    }
+    return pixels;
+}
+
+/// @brief Direct 3x3 Sobel derivatives at (y, x).
+void sobelReference(const ImageView<const uint8_t>& image, int y, int x, int& gradX, int& gradY)
+{
+    static const int kSobelX[3][3] = {{-1, 0, 1}, {-2, 0, 2}, {-1, 0, 1}};
+    static const int kSobelY[3][3] = {{-1, -2, -1}, {0, 0, 0}, {1, 2, 1}};
+    gradX = 0;
+    gradY = 0;
+    for (int i = -1; i <= 1; ++i) {
+        for (int j = -1; j <= 1; ++j) {
+            gradX += kSobelX[i + 1][j + 1] * image(y + i, x + j);
+            gradY += kSobelY[i + 1][j + 1] * image(y + i, x + j);
+        }
+    }
+}
+
+/// @brief Runs one sobelRow() overload on every row and column range of
+///        random images and compares it with sobelReference().
+template <typename T>
+void checkSobelRows()
+{
+    std::mt19937 generator(7U);
+    for (int width : kWidths) {
+        for (int padding : kPaddings) {
+            constexpr int kHeight = 5;
+            const std::vector<uint8_t> pixels = randomPixels(width, kHeight, padding, generator);
+            const ImageView<const uint8_t> image(pixels.data(), width, kHeight, width + padding);
+            std::vector<T> gradX(width);
+            std::vector<T> gradY(width);
+            std::vector<T> scratch(2 * width);
+            // Whole rows, clamped by sobelRow(), and a range inside them
+            for (const auto& range : std::vector<std::pair<int, int>>{{0, width}, {2, width - 2}}) {
+                for (int y = 1; y < kHeight - 1; ++y) {
+                    std::fill(gradX.begin(), gradX.end(), static_cast<T>(kUntouched));
+                    std::fill(gradY.begin(), gradY.end(), static_cast<T>(kUntouched));
+                    harris::sobelRow(image, y, range.first, range.second, gradX.data(), gradY.data(), scratch.data());
+                    const int xBegin = std::max(range.first, 1);
+                    const int xEnd = std::min(range.second, width - 1);
+                    for (int x = 0; x < width; ++x) {
+                        if (x < xBegin || x >= xEnd) {
+                            EXPECT_EQ(gradX[x], static_cast<T>(kUntouched)) << "width " << width << ", column " << x;
+                            EXPECT_EQ(gradY[x], static_cast<T>(kUntouched)) << "width " << width << ", column " << x;
+                            continue;
+                        }
+                        int expectedX = 0;
+                        int expectedY = 0;
+                        sobelReference(image, y, x, expectedX, expectedY);
+                        ASSERT_EQ(gradX[x], static_cast<T>(expectedX)) << "width " << width << ", stride " << width + padding << ", row " << y << ", column " << x;
+                        ASSERT_EQ(gradY[x], static_cast<T>(expectedY)) << "width " << width << ", stride " << width + padding << ", row " << y << ", column " << x;
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+TEST(HarrisKernels, SobelRowMatchesDirectSum)
+{
+    SCOPED_TRACE(harris::simdInstructionSet());
+    checkSobelRows<float>();
+}
+
+TEST(HarrisKernels, IntegerSobelRowMatchesDirectSum)
+{
+    checkSobelRows<int16_t>();
+}
+
+// Extreme rows, the largest derivatives must not wrap in 16 bits
+TEST(HarrisKernels, IntegerSobelRowRange)
+{
+    constexpr int kWidth = 37;
+    std::vector<uint8_t> pixels(3 * kWidth, 0);
+    for (int x = 0; x < kWidth; ++x) {
+        // Bright bottom row and right half, so that both derivatives peak
+        pixels[2 * kWidth + x] = 255;
+        if (x >= kWidth / 2) {
+            pixels[x] = 255;
+            pixels[kWidth + x] = 255;
+        }
+    }
+    const ImageView<const uint8_t> image(pixels.data(), kWidth, 3);
+    std::vector<int16_t> gradX(kWidth);
+    std::vector<int16_t> gradY(kWidth);
+    std::vector<int16_t> scratch(2 * kWidth);
+    harris::sobelRow(image, 1, 0, kWidth, gradX.data(), gradY.data(), scratch.data());
+    for (int x = 1; x < kWidth - 1; ++x) {
+        int expectedX = 0;
+        int expectedY = 0;
+        sobelReference(image, 1, x, expectedX, expectedY);
+        EXPECT_EQ(gradX[x], expectedX) << "column " << x;
+        EXPECT_EQ(gradY[x], expectedY) << "column " << x;
+    }
+}
+
+TEST(HarrisKernels, GaussianSmoothingMatchesDirectConvolution)
+{
+    SCOPED_TRACE(harris::simdInstructionSet());
+    std::mt19937 generator(11U);
+    std::uniform_real_distribution<float> level(0.0F, 255.0F);
+    for (float sigma : {1.0F, 1.5F, 2.5F, 3.7F}) {
+        const harris::GaussianKernel kernel = harris::makeGaussianKernel(sigma);
+        const int radius = kernel.radius;
+        for (int width : kWidths) {
+            for (int padding : kPaddings) {
+                const int height = 2 * radius + 4;
+                const int stride = width + padding;
+                std::vector<float> input(static_cast<std::size_t>(stride) * height);
+                for (float& value : input) {
+                    value = level(generator);
+                }
+                std::vector<float> temp(input.size(), kUntouched);
+                std::vector<float> output(input.size(), kUntouched);
+                const ImageView<const float> inputView(input.data(), width, height, stride);
+                harris::gaussianSmoothing(
+                    inputView, kernel,
+                    ImageView<float>(temp.data(), width, height, stride),
+                    ImageView<float>(output.data(), width, height, stride)
+                    );
+                for (int y = 0; y < height; ++y) {
+                    for (int x = 0; x < width; ++x) {
+                        const float value = output[static_cast<std::size_t>(y) * stride + x];
+                        if (x < radius || x >= width - radius || y < radius || y >= height - radius) {
+                            EXPECT_EQ(value, kUntouched) << "sigma " << sigma << ", width " << width << ", border (" << x << ", " << y << ")";
+                            continue;
+                        }
+                        double expected = 0.0;
+                        for (int i = -radius; i <= radius; ++i) {
+                            for (int j = -radius; j <= radius; ++j) {
+                                expected += static_cast<double>(kernel.taps[i + radius]) * kernel.taps[j + radius] * inputView(y + i, x + j);
+                            }
+                        }
+                        // Float sums of at most 15 x 15 terms in [0, 255]
+                        ASSERT_NEAR(value, expected, 1e-3) << "sigma " << sigma << ", width " << width << ", stride " << stride << ", (" << x << ", " << y << ")";
+                    }
+                }
+            }
+        }
+    }
+}
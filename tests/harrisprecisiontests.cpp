@@ -0,0 +1,138 @@
+/// @file harrisprecisiontests.cpp
+/// @brief Fixed-point fused pipeline against the float one, both policies
+///        being instantiated in every build
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "harrispipeline.hpp"
+#include "syntheticboard.hpp"
+
+namespace {
+
+/// @brief Noisy boards, so that the response has many local maxima besides
+///        the corners.
+std::vector<SyntheticBoard> makeBoards()
+{
+    std::vector<SyntheticBoard> boards;
+    for (float angle : {0.0F, 15.0F, -30.0F}) {
+        SyntheticBoardParameters params;
+        params.angle = angle;
+        params.blurSigma = 1.0F;
+        params.noiseSigma = 4.0F;
+        boards.push_back(makeSyntheticBoard(params));
+    }
+    return boards;
+}
+
+/// @brief Float and fixed-point detections of the same frame.
+struct PrecisionPair
+{
+    harris::RegionResult floatResult;
+    harris::RegionResult fixedResult;
+};
+
+PrecisionPair detectBoth(const SyntheticBoard& board, const HarrisParameters& params)
+{
+    const ImageRect frame{0, 0, board.image.width(), board.image.height()};
+    harris::BasicPipelineWorkspace<harris::FloatPrecision> floatWorkspace;
+    harris::BasicPipelineWorkspace<harris::FixedPointPrecision> fixedWorkspace;
+    PrecisionPair pair;
+    harris::detectRegion<harris::FloatPrecision>(board.image, frame, params, floatWorkspace, pair.floatResult);
+    harris::detectRegion<harris::FixedPointPrecision>(board.image, frame, params, fixedWorkspace, pair.fixedResult);
+    return pair;
+}
+
+/// @brief Locations of the candidates above 10% of the maximum response,
+///        i.e. the corners of the board settings of app/main.cpp.
+std::set<std::pair<int, int>> strongCorners(const harris::RegionResult& result)
+{
+    std::set<std::pair<int, int>> corners;
+    for (const auto& candidate : result.candidates) {
+        if (candidate.response > 0.1F * result.maxResponse) {
+            corners.emplace(candidate.x, candidate.y);
+        }
+    }
+    return corners;
+}
+
+/// @brief Bounds the difference between the two policies: relative maximum
+///        response and share of the strong corners found by both.
+void expectClose(const PrecisionPair& pair, const float maxResponseTolerance, const float minCommonShare)
+{
+    const float floatMax = pair.floatResult.maxResponse;
+    ASSERT_GT(floatMax, 0.0F);
+    EXPECT_LT(std::abs(pair.fixedResult.maxResponse - floatMax) / floatMax, maxResponseTolerance);
+    const std::set<std::pair<int, int>> floatCorners = strongCorners(pair.floatResult);
+    const std::set<std::pair<int, int>> fixedCorners = strongCorners(pair.fixedResult);
+    ASSERT_FALSE(floatCorners.empty());
+    const auto common = static_cast<float>(std::count_if(floatCorners.begin(), floatCorners.end(), [&](const std::pair<int, int>& corner) {
+        return fixedCorners.count(corner) > 0;
+    }));
+    EXPECT_GE(common, minCommonShare * static_cast<float>(floatCorners.size()));
+    EXPECT_GE(common, minCommonShare * static_cast<float>(fixedCorners.size()));
+}
+
+} // namespace
+
+// Integer products summed exactly, so every candidate and response is the
+// float one
+TEST(HarrisPrecision, ExactBoxWindows)
+{
+    for (const SyntheticBoard& board : makeBoards()) {
+        for (int windowOffset : {1, 2, 8, 22}) {
+            HarrisParameters params;
+            params.windowOffset = windowOffset;
+            params.tensorWeighting = TensorWeighting::Box;
+            const PrecisionPair pair = detectBoth(board, params);
+            const auto& expected = pair.floatResult.candidates;
+            const auto& actual = pair.fixedResult.candidates;
+            ASSERT_EQ(actual.size(), expected.size()) << "window offset " << windowOffset;
+            for (std::size_t i = 0; i < expected.size(); ++i) {
+                ASSERT_EQ(actual[i].x, expected[i].x) << "window offset " << windowOffset;
+                ASSERT_EQ(actual[i].y, expected[i].y) << "window offset " << windowOffset;
+                ASSERT_EQ(actual[i].response, expected[i].response) << "window offset " << windowOffset;
+            }
+            EXPECT_EQ(pair.fixedResult.maxResponse, pair.floatResult.maxResponse);
+            EXPECT_EQ(pair.fixedResult.maxX, pair.floatResult.maxX);
+            EXPECT_EQ(pair.fixedResult.maxY, pair.floatResult.maxY);
+        }
+    }
+}
+
+// Beyond an offset of 22 the low bits of the products are dropped
+TEST(HarrisPrecision, WideBoxWindowsStayClose)
+{
+    for (const SyntheticBoard& board : makeBoards()) {
+        for (int windowOffset : {23, 30}) {
+            SCOPED_TRACE(windowOffset);
+            HarrisParameters params;
+            params.windowOffset = windowOffset;
+            params.tensorWeighting = TensorWeighting::Box;
+            expectClose(detectBoth(board, params), 1e-3F, 0.99F);
+        }
+    }
+}
+
+// Taps rounded to 8 fractional bits
+TEST(HarrisPrecision, GaussianWindowsStayClose)
+{
+    for (const SyntheticBoard& board : makeBoards()) {
+        for (int windowOffset : {1, 2}) {
+            SCOPED_TRACE(windowOffset);
+            HarrisParameters params;
+            params.windowOffset = windowOffset;
+            params.sigma = static_cast<float>(windowOffset);
+            params.tensorWeighting = TensorWeighting::Gaussian;
+            expectClose(detectBoth(board, params), 1e-2F, 0.97F);
+        }
+    }
+}
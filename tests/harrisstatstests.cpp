@@ -0,0 +1,135 @@
+/// @file harrisstatstests.cpp
+/// @brief Per-stage counters of HarrisChessCornersDetector and percentiles of
+///        HarrisStatsAggregator
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#include <cstddef>
+#include <initializer_list>
+#include <gtest/gtest.h>
+#include "harrisdetector.hpp"
+#include "harrisstats.hpp"
+#include "syntheticboard.hpp"
+
+namespace {
+
+/// @brief Frame where only @p stage ran, for @p wallMs.
+HarrisFrameStats stageFrame(HarrisStage stage, double wallMs, std::size_t allocations = 0U)
+{
+    HarrisFrameStats frame;
+    frame.stage(stage).calls = 1U;
+    frame.stage(stage).wallMs = wallMs;
+    frame.stage(stage).allocations = allocations;
+    return frame;
+}
+
+void expectOnlyStages(const HarrisFrameStats& stats, std::initializer_list<HarrisStage> stages)
+{
+    for (int stage = 0; stage < kHarrisStageCount; ++stage) {
+        bool expected = false;
+        for (HarrisStage ran : stages) {
+            expected = expected || static_cast<int>(ran) == stage;
+        }
+        EXPECT_EQ(stats.stages[stage].calls, expected ? 1U : 0U) << "stage " << stage;
+    }
+}
+
+} // namespace
+
+// The aggregator does not depend on HARRIS_INSTRUMENTATION, the frames are
+// filled by hand
+TEST(HarrisStatsAggregator, NearestRankPercentiles)
+{
+    HarrisStatsAggregator aggregator;
+    EXPECT_EQ(aggregator.percentileMs(HarrisStage::Fused, 50.0), 0.0);
+
+    // 1 to 100 ms, added out of order
+    for (int i = 0; i < 100; ++i) {
+        const int sample = (i * 37) % 100 + 1;
+        aggregator.add(stageFrame(HarrisStage::Fused, static_cast<double>(sample), sample == 42 ? 3U : 0U));
+    }
+    EXPECT_EQ(aggregator.frames(), 100U);
+    EXPECT_EQ(aggregator.percentileMs(HarrisStage::Fused, 0.0), 1.0);
+    EXPECT_EQ(aggregator.percentileMs(HarrisStage::Fused, 50.0), 50.0);
+    EXPECT_EQ(aggregator.percentileMs(HarrisStage::Fused, 99.0), 99.0);
+    EXPECT_EQ(aggregator.percentileMs(HarrisStage::Fused, 100.0), 100.0);
+    EXPECT_EQ(aggregator.totalPercentileMs(99.0), 99.0);
+    EXPECT_EQ(aggregator.maxAllocations(HarrisStage::Fused), 3U);
+    // Stages that never ran are not sampled
+    EXPECT_EQ(aggregator.percentileMs(HarrisStage::Gradients, 50.0), 0.0);
+
+    // Rank ceil(p / 100 * n) of a few samples, i.e. the 3rd of 5 for p50 and
+    // the largest for p99
+    aggregator.clear();
+    EXPECT_EQ(aggregator.frames(), 0U);
+    for (double sample : {5.0, 1.0, 4.0, 2.0, 3.0}) {
+        aggregator.add(stageFrame(HarrisStage::Response, sample));
+    }
+    EXPECT_EQ(aggregator.percentileMs(HarrisStage::Response, 50.0), 3.0);
+    EXPECT_EQ(aggregator.percentileMs(HarrisStage::Response, 99.0), 5.0);
+    EXPECT_EQ(aggregator.percentileMs(HarrisStage::Fused, 50.0), 0.0);
+}
+
+TEST(HarrisStats, StagedCounters)
+{
+#if !defined(HARRIS_INSTRUMENTATION)
+    GTEST_SKIP() << "Built without HARRIS_ENABLE_INSTRUMENTATION";
+#endif
+    const SyntheticBoard board = makeSyntheticBoard(SyntheticBoardParameters{});
+    const std::size_t pixels = static_cast<std::size_t>(board.image.width()) * board.image.height();
+    HarrisChessCornersDetector detector{};
+    detector.computeGradients(board.image);
+    detector.cornerResponse_method2();
+    detector.thresholding();
+    detector.nonMaximalSuppression(10);
+    const HarrisFrameStats& stats = detector.frameStats();
+    expectOnlyStages(stats, {HarrisStage::Gradients, HarrisStage::Response, HarrisStage::Thresholding, HarrisStage::Suppression});
+    ASSERT_FALSE(detector.m_cornersLocation.empty());
+    EXPECT_EQ(stats.thresholdInput, pixels);
+    EXPECT_EQ(stats.thresholdOutput, detector.m_candidates.size());
+    EXPECT_EQ(stats.suppressionInput, detector.m_candidates.size());
+    EXPECT_EQ(stats.suppressionOutput, detector.m_cornersLocation.size());
+    EXPECT_EQ(stats.corners, detector.m_cornersLocation.size());
+    EXPECT_GT(stats.stage(HarrisStage::Gradients).bytesTouched, 0U);
+
+    detector.refineCorners();
+    EXPECT_EQ(detector.frameStats().stage(HarrisStage::Refinement).calls, 1U);
+    // A new frame starts from zero
+    detector.computeGradients(board.image);
+    expectOnlyStages(detector.frameStats(), {HarrisStage::Gradients});
+}
+
+TEST(HarrisStats, FusedCounters)
+{
+#if !defined(HARRIS_INSTRUMENTATION)
+    GTEST_SKIP() << "Built without HARRIS_ENABLE_INSTRUMENTATION";
+#endif
+    const SyntheticBoard board = makeSyntheticBoard(SyntheticBoardParameters{});
+    const std::size_t pixels = static_cast<std::size_t>(board.image.width()) * board.image.height();
+    HarrisParameters params;
+    params.windowOffset = 2;
+    params.thresholdPercent = 0.1F;
+    params.nmsWindowOffset = 10;
+    HarrisChessCornersDetector detector{};
+    detector.detect(board.image, params);
+    const HarrisFrameStats& stats = detector.frameStats();
+    expectOnlyStages(stats, {HarrisStage::Fused});
+    ASSERT_FALSE(detector.m_cornersLocation.empty());
+    EXPECT_EQ(stats.suppressionInput, pixels);
+    EXPECT_EQ(stats.suppressionOutput, stats.thresholdInput);
+    EXPECT_EQ(stats.thresholdOutput, detector.m_cornersLocation.size());
+    EXPECT_EQ(stats.corners, detector.m_cornersLocation.size());
+
+    // Kept strongest corners only shorten the reported list, and the buffers
+    // of the first frame are reused
+    params.maxCorners = 5;
+    detector.detect(board.image, params);
+    expectOnlyStages(stats, {HarrisStage::Fused});
+    EXPECT_GT(stats.thresholdOutput, 5U);
+    EXPECT_EQ(stats.corners, 5U);
+    EXPECT_EQ(detector.m_cornersLocation.size(), 5U);
+    EXPECT_EQ(stats.stage(HarrisStage::Fused).allocations, 0U);
+}
@@ -0,0 +1,80 @@
+/// @file imagetests.cpp
+/// @brief Layout and move semantics of Image
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#include <cstdint>
+#include <utility>
+#include <gtest/gtest.h>
+#include "image.hpp"
+
+namespace {
+
+/// @brief Expects the state of a default constructed image.
+void expectEmpty(const Image<float>& image)
+{
+    EXPECT_TRUE(image.empty());
+    EXPECT_EQ(image.width(), 0);
+    EXPECT_EQ(image.height(), 0);
+    EXPECT_EQ(image.padding(), 0);
+    EXPECT_EQ(image.stride(), 0);
+    EXPECT_TRUE(image.view().empty());
+}
+
+/// @brief Reshapes @p image to the shape it had before being moved from, and
+///        writes every pixel, border included.
+void reuse(Image<float>& image, int width, int height, int padding)
+{
+    // Not the stale shape, so the pixels are allocated again
+    EXPECT_TRUE(image.reshape(width, height, padding));
+    ASSERT_NE(image.data(), nullptr);
+    for (int y = -padding; y < height + padding; ++y) {
+        for (int x = -padding; x < width + padding; ++x) {
+            image(y, x) = static_cast<float>(y * width + x);
+        }
+    }
+    EXPECT_EQ(image(height - 1, width - 1), static_cast<float>(height * width - 1));
+}
+
+} // namespace
+
+TEST(Image, RowsAreAligned)
+{
+    const Image<float> image(37, 5, 3);
+    EXPECT_GE(image.stride(), 37 + 2 * 3);
+    for (int y = -3; y < 5 + 3; ++y) {
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(image.row(y) - 3) % kImageAlignment, 0U) << y;
+        for (int x = -3; x < 37 + 3; ++x) {
+            ASSERT_EQ(image(y, x), 0.0F);
+        }
+    }
+}
+
+TEST(Image, MoveLeavesSourceEmpty)
+{
+    Image<float> source(37, 5, 3);
+    source(4, 36) = 1.5F;
+    const float* pixels = source.data();
+    const std::ptrdiff_t stride = source.stride();
+
+    Image<float> moved(std::move(source));
+    EXPECT_EQ(moved.data(), pixels);
+    EXPECT_EQ(moved.width(), 37);
+    EXPECT_EQ(moved.height(), 5);
+    EXPECT_EQ(moved.padding(), 3);
+    EXPECT_EQ(moved.stride(), stride);
+    EXPECT_EQ(moved(4, 36), 1.5F);
+    expectEmpty(source);
+    reuse(source, 37, 5, 3);
+
+    Image<float> assigned(8, 8);
+    assigned = std::move(moved);
+    EXPECT_EQ(assigned.data(), pixels);
+    EXPECT_EQ(assigned.width(), 37);
+    EXPECT_EQ(assigned(4, 36), 1.5F);
+    expectEmpty(moved);
+    reuse(moved, 37, 5, 3);
+}
@@ -0,0 +1,241 @@
+/// @file pnmimagetests.cpp
+/// @brief Header parsing, zero-copy view and gray conversion of PnmImage
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "pnmimage.hpp"
+
+namespace {
+
+/// @brief Writes @p header followed by @p samples to a file of the test
+///        temporary directory.
+/// @return Path of the file.
+std::string writeFile(const std::string& name, const std::string& header, const std::vector<uint8_t>& samples = {})
+{
+    const std::string path = ::testing::TempDir() + name;
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << header;
+    file.write(reinterpret_cast<const char*>(samples.data()), static_cast<std::streamsize>(samples.size()));
+    return path;
+}
+
+std::vector<uint8_t> randomSamples(std::size_t count, unsigned seed)
+{
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<int> level(0, 255);
+    std::vector<uint8_t> samples(count);
+    for (uint8_t& sample : samples) {
+        sample = static_cast<uint8_t>(level(generator));
+    }
+    return samples;
+}
+
+/// @brief BT.601 gray level in 14-bit fixed point, as cv::cvtColor().
+uint8_t grayReference(uint8_t red, uint8_t green, uint8_t blue)
+{
+    const uint32_t sum = 4899U * red + 9617U * green + 1868U * blue;
+    return static_cast<uint8_t>((sum + (1U << 13)) >> 14);
+}
+
+} // namespace
+
+TEST(PnmImage, ReadsPgmInPlace)
+{
+    constexpr int kWidth = 37;
+    constexpr int kHeight = 11;
+    const std::vector<uint8_t> samples = randomSamples(kWidth * kHeight, 1U);
+    // Comments and mixed whitespace between the header fields
+    const std::string path = writeFile("pnm_comments.pgm", "P5\n# capture rig 3\n37 \t11\n# 8-bit\n255\n", samples);
+    PnmImage image;
+    const std::size_t allocations = imageAllocationCount();
+    ASSERT_TRUE(image.open(path)) << image.error();
+    // The view points into the mapping, no plane is allocated
+    EXPECT_EQ(imageAllocationCount(), allocations);
+    EXPECT_EQ(image.channels(), 1);
+    const ImageView<const uint8_t> view = image.view();
+    ASSERT_EQ(view.width(), kWidth);
+    ASSERT_EQ(view.height(), kHeight);
+    EXPECT_EQ(view.stride(), kWidth);
+    for (int y = 0; y < kHeight; ++y) {
+        for (int x = 0; x < kWidth; ++x) {
+            ASSERT_EQ(view(y, x), samples[y * kWidth + x]) << "(" << x << ", " << y << ")";
+        }
+    }
+    std::remove(path.c_str());
+}
+
+TEST(PnmImage, ConvertsPpmToGray)
+{
+    constexpr int kWidth = 53;
+    constexpr int kHeight = 7;
+    const std::vector<uint8_t> samples = randomSamples(3 * kWidth * kHeight, 2U);
+    const std::string path = writeFile("pnm_color.ppm", "P6 53 7 255\n", samples);
+    PnmImage image;
+    ASSERT_TRUE(image.open(path)) << image.error();
+    EXPECT_EQ(image.channels(), 3);
+    const ImageView<const uint8_t> view = image.view();
+    ASSERT_EQ(view.width(), kWidth);
+    ASSERT_EQ(view.height(), kHeight);
+    for (int y = 0; y < kHeight; ++y) {
+        for (int x = 0; x < kWidth; ++x) {
+            const uint8_t* rgb = &samples[3 * (y * kWidth + x)];
+            ASSERT_EQ(view(y, x), grayReference(rgb[0], rgb[1], rgb[2])) << "(" << x << ", " << y << ")";
+        }
+    }
+
+    // Reopening a PPM of the same size reuses the gray plane
+    const std::size_t allocations = imageAllocationCount();
+    ASSERT_TRUE(image.open(path)) << image.error();
+    EXPECT_EQ(imageAllocationCount(), allocations);
+    image.close();
+    EXPECT_TRUE(image.view().empty());
+    EXPECT_EQ(image.channels(), 0);
+    std::remove(path.c_str());
+}
+
+TEST(PnmImage, MoveKeepsView)
+{
+    const std::vector<uint8_t> samples = randomSamples(16 * 4, 3U);
+    const std::string path = writeFile("pnm_move.pgm", "P5\n16 4\n255\n", samples);
+    PnmImage image;
+    ASSERT_TRUE(image.open(path)) << image.error();
+    const uint8_t* pixels = image.view().data();
+    PnmImage moved(std::move(image));
+    EXPECT_TRUE(image.view().empty());
+    EXPECT_EQ(moved.view().data(), pixels);
+    EXPECT_EQ(moved.view()(3, 15), samples[3 * 16 + 15]);
+    std::remove(path.c_str());
+}
+
+// The moved-from image opens the next PPMs into a gray plane of its own, as
+// the batch mode does with every file
+TEST(PnmImage, MovedFromImageReopens)
+{
+    const std::vector<uint8_t> first = randomSamples(3 * 16 * 4, 8U);
+    const std::vector<uint8_t> second = randomSamples(3 * 16 * 4, 9U);
+    const std::string firstPath = writeFile("pnm_moved_1.ppm", "P6\n16 4\n255\n", first);
+    const std::string secondPath = writeFile("pnm_moved_2.ppm", "P6\n16 4\n255\n", second);
+    PnmImage image;
+    ASSERT_TRUE(image.open(firstPath)) << image.error();
+    const PnmImage moved(std::move(image));
+    PnmImage assigned;
+    for (int round = 0; round < 2; ++round) {
+        SCOPED_TRACE(round);
+        for (const auto& file : {std::make_pair(firstPath, &first), std::make_pair(secondPath, &second)}) {
+            ASSERT_TRUE(image.open(file.first)) << image.error();
+            const ImageView<const uint8_t> view = image.view();
+            ASSERT_EQ(view.width(), 16);
+            ASSERT_EQ(view.height(), 4);
+            ASSERT_NE(view.data(), moved.view().data());
+            for (int y = 0; y < 4; ++y) {
+                for (int x = 0; x < 16; ++x) {
+                    const uint8_t* rgb = &(*file.second)[3 * (y * 16 + x)];
+                    ASSERT_EQ(view(y, x), grayReference(rgb[0], rgb[1], rgb[2])) << "(" << x << ", " << y << ")";
+                }
+            }
+        }
+        // Then moved from by assignment
+        assigned = std::move(image);
+        EXPECT_TRUE(image.view().empty());
+    }
+    // The first image kept its pixels
+    EXPECT_EQ(moved.view()(3, 15), grayReference(first[3 * 63], first[3 * 63 + 1], first[3 * 63 + 2]));
+    std::remove(firstPath.c_str());
+    std::remove(secondPath.c_str());
+}
+
+TEST(PnmImage, RejectsInvalidFiles)
+{
+    const std::vector<uint8_t> pixels = randomSamples(8 * 4, 4U);
+    const std::vector<uint8_t> png{0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n', 0, 0, 0, 13};
+    struct Invalid
+    {
+        const char* name;
+        std::string header;
+        std::vector<uint8_t> samples;
+        const char* reason;
+    };
+    const std::vector<Invalid> files{
+        {"pnm_png.ppm", "", png, "not a binary PGM"},
+        {"pnm_ascii.pgm", "P2\n8 4\n255\n", pixels, "not a binary PGM"},
+        {"pnm_empty.pgm", "", {}, "cannot be opened"},
+        {"pnm_header_cut.pgm", "P5\n8 4\n", {}, "invalid header"},
+        {"pnm_comment_cut.pgm", "P5\n8 4\n# no maximum", {}, "invalid header"},
+        {"pnm_no_separator.pgm", "P5\n8 4\n255", {}, "invalid header"},
+        {"pnm_zero_width.pgm", "P5\n0 4\n255\n", pixels, "invalid header"},
+        {"pnm_zero_maxval.pgm", "P5\n8 4\n0\n", pixels, "invalid header"},
+        {"pnm_16bit.pgm", "P5\n8 4\n65535\n", randomSamples(2 * 8 * 4, 5U), "16-bit"},
+        {"pnm_truncated.pgm", "P5\n8 4\n255\n", std::vector<uint8_t>(pixels.begin(), pixels.end() - 1), "truncated"},
+        {"pnm_truncated.ppm", "P6\n8 4\n255\n", pixels, "truncated"},
+    };
+    for (const Invalid& invalid : files) {
+        const std::string path = writeFile(invalid.name, invalid.header, invalid.samples);
+        PnmImage image;
+        EXPECT_FALSE(image.open(path)) << invalid.name;
+        EXPECT_NE(image.error().find(invalid.reason), std::string::npos) << invalid.name << ": " << image.error();
+        EXPECT_TRUE(image.view().empty()) << invalid.name;
+        std::remove(path.c_str());
+    }
+    PnmImage image;
+    EXPECT_FALSE(image.open(::testing::TempDir() + "pnm_missing.pgm"));
+}
+
+// A failed open() closes the previous image
+TEST(PnmImage, FailedOpenClosesPrevious)
+{
+    const std::string valid = writeFile("pnm_valid.pgm", "P5\n8 4\n255\n", randomSamples(8 * 4, 6U));
+    const std::string invalid = writeFile("pnm_invalid.pgm", "P5\n8 4\n65535\n");
+    PnmImage image;
+    ASSERT_TRUE(image.open(valid)) << image.error();
+    EXPECT_FALSE(image.open(invalid));
+    EXPECT_TRUE(image.view().empty());
+    EXPECT_EQ(image.channels(), 0);
+    std::remove(valid.c_str());
+    std::remove(invalid.c_str());
+}
+
+// Every length around the SSE2/SSSE3 and NEON blocks, from unaligned rows, so
+// that the vector blocks and the scalar tail are both compared
+TEST(PnmImage, RgbToGrayRowMatchesScalar)
+{
+#if !defined(HARRIS_DISABLE_SIMD) && (defined(__x86_64__) || defined(_M_X64) || defined(__aarch64__))
+    // A vector path exists on these targets without any extra compiler flag
+    EXPECT_STRNE(rgbToGrayInstructionSet(), "scalar");
+#endif
+    const std::vector<uint8_t> samples = randomSamples(3 * 100 + 3, 7U);
+    for (int offset = 0; offset < 3; ++offset) {
+        for (int count = 0; count <= 100; ++count) {
+            const uint8_t* rgb = samples.data() + offset;
+            std::vector<uint8_t> gray(count + 1, 0xAB);
+            rgbToGrayRow(rgb, count, gray.data());
+            for (int x = 0; x < count; ++x) {
+                ASSERT_EQ(gray[x], grayReference(rgb[3 * x], rgb[3 * x + 1], rgb[3 * x + 2]))
+                    << "offset " << offset << ", count " << count << ", pixel " << x;
+            }
+            EXPECT_EQ(gray[count], 0xAB) << "count " << count;
+        }
+    }
+    // Extreme levels, the largest sum must not saturate below 255
+    const std::vector<uint8_t> extremes{255, 255, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255};
+    std::vector<uint8_t> repeated;
+    for (int i = 0; i < 8; ++i) {
+        repeated.insert(repeated.end(), extremes.begin(), extremes.end());
+    }
+    const int count = static_cast<int>(repeated.size() / 3);
+    std::vector<uint8_t> gray(count);
+    rgbToGrayRow(repeated.data(), count, gray.data());
+    for (int x = 0; x < count; ++x) {
+        EXPECT_EQ(gray[x], grayReference(repeated[3 * x], repeated[3 * x + 1], repeated[3 * x + 2])) << "pixel " << x;
+    }
+}
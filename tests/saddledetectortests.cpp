@@ -0,0 +1,217 @@
+/// @file saddledetectortests.cpp
+/// @brief Saddle point engine against a direct evaluation of its response,
+///        and its recall on synthetic boards
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "saddledetector.hpp"
+#include "syntheticboard.hpp"
+
+namespace {
+
+// Distance below which a detection matches a ground truth corner, in pixels
+constexpr float kMatchDistance = 3.0F;
+
+/// @brief Settings of app/main.cpp, i.e. lines of about a third of the square
+///        size and a suppression window in the order of the square size.
+SaddleParameters boardParameters()
+{
+    SaddleParameters params;
+    params.lineOffset = 6;
+    params.thresholdPercent = 0.3F;
+    params.nmsWindowOffset = 10;
+    return params;
+}
+
+/// @brief Direct evaluation of the response, i.e. the four line sums of
+///        each pixel summed anew, zero where a line leaves the image.
+Image<float> directResponse(const ImageView<const uint8_t>& image, const int radius)
+{
+    const int width = image.width();
+    const int height = image.height();
+    const float scale = 1.0F / (255.0F * static_cast<float>(2 * radius + 1));
+    Image<float> response(width, height);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            response(y, x) = 0.0F;
+            if (x < radius || x >= width - radius || y < radius || y >= height - radius) {
+                continue;
+            }
+            float horizontal = 0.0F;
+            float vertical = 0.0F;
+            float diagonal = 0.0F;
+            float antiDiagonal = 0.0F;
+            for (int k = -radius; k <= radius; ++k) {
+                horizontal += image(y, x + k);
+                vertical += image(y + k, x);
+                diagonal += image(y + k, x + k);
+                antiDiagonal += image(y + k, x - k);
+            }
+            const float high = std::max(std::max(horizontal, vertical), std::max(diagonal, antiDiagonal));
+            const float low = std::min(std::min(horizontal, vertical), std::min(diagonal, antiDiagonal));
+            const float contrast = (high - low) * scale;
+            response(y, x) = contrast * contrast;
+        }
+    }
+    return response;
+}
+
+/// @brief Expected output of SaddleChessCornersDetector::detect(): positive
+///        maxima of their full NMS window above the threshold, in row-major
+///        order.
+struct DirectDetection
+{
+    std::vector<std::pair<int, int>> locations;
+    std::vector<float> responses;
+    float maxResponse{0.0F};
+    std::pair<int, int> maxResponseLocation{-1, -1};
+};
+
+DirectDetection directDetection(const ImageView<const uint8_t>& image, const SaddleParameters& params)
+{
+    const Image<float> response = directResponse(image, params.lineOffset);
+    const int width = image.width();
+    const int height = image.height();
+    const int offset = params.nmsWindowOffset;
+    DirectDetection detection;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            if (response(y, x) > detection.maxResponse) {
+                detection.maxResponse = response(y, x);
+                detection.maxResponseLocation = std::pair<int, int>(x, y);
+            }
+        }
+    }
+    const float threshold = params.thresholdPercent * detection.maxResponse;
+    for (int y = offset; y < height - offset; ++y) {
+        for (int x = offset; x < width - offset; ++x) {
+            const float value = response(y, x);
+            if (!(value > 0.0F) || !(value > threshold)) {
+                continue;
+            }
+            bool isMaximum = true;
+            for (int j = -offset; j <= offset && isMaximum; ++j) {
+                for (int i = -offset; i <= offset; ++i) {
+                    if (response(y + j, x + i) > value) {
+                        isMaximum = false;
+                        break;
+                    }
+                }
+            }
+            if (isMaximum) {
+                detection.locations.emplace_back(x, y);
+                detection.responses.push_back(value);
+            }
+        }
+    }
+    return detection;
+}
+
+/// @brief Small noisy board, so that the response has many local maxima
+///        besides the corners, with odd sizes to reach the scalar tails.
+SyntheticBoard makeSmallBoard(const float angle)
+{
+    SyntheticBoardParameters params;
+    params.width = 203;
+    params.height = 131;
+    params.cols = 5;
+    params.rows = 4;
+    params.angle = angle;
+    params.blurSigma = 0.8F;
+    params.noiseSigma = 6.0F;
+    return makeSyntheticBoard(params);
+}
+
+} // namespace
+
+// The running line sums are exact, so the engine gives the direct response
+TEST(SaddleDetector, MatchesDirectEvaluation)
+{
+    for (float angle : {0.0F, 25.0F}) {
+        const SyntheticBoard board = makeSmallBoard(angle);
+        for (int lineOffset : {1, 3, 6}) {
+            for (int nmsWindowOffset : {0, 1, 4}) {
+                SCOPED_TRACE(::testing::Message() << "angle " << angle << ", line offset " << lineOffset
+                                                  << ", NMS offset " << nmsWindowOffset);
+                SaddleParameters params;
+                params.lineOffset = lineOffset;
+                params.nmsWindowOffset = nmsWindowOffset;
+                params.thresholdPercent = 0.05F;
+                const DirectDetection expected = directDetection(board.image, params);
+                ASSERT_FALSE(expected.locations.empty());
+                SaddleChessCornersDetector detector(params);
+                detector.detect(board.image);
+                EXPECT_EQ(detector.m_cornersLocation, expected.locations);
+                EXPECT_EQ(detector.m_cornersResponse, expected.responses);
+                EXPECT_EQ(detector.m_maxResponse, expected.maxResponse);
+                EXPECT_EQ(detector.m_maxResponseLocation, expected.maxResponseLocation);
+            }
+        }
+    }
+}
+
+TEST(SaddleDetector, ThreadsGiveSerialCorners)
+{
+    SyntheticBoardParameters boardParams;
+    boardParams.angle = -20.0F;
+    boardParams.blurSigma = 0.8F;
+    boardParams.noiseSigma = 8.0F;
+    const SyntheticBoard board = makeSyntheticBoard(boardParams);
+    SaddleParameters params = boardParameters();
+    params.thresholdPercent = 0.05F;
+    SaddleChessCornersDetector serial(params);
+    serial.detect(board.image);
+    ASSERT_FALSE(serial.m_cornersLocation.empty());
+    for (int threads : {2, 3, 8}) {
+        SaddleChessCornersDetector parallel(params);
+        parallel.setParallelism(threads);
+        parallel.detect(board.image);
+        EXPECT_EQ(parallel.m_cornersLocation, serial.m_cornersLocation) << threads << " threads";
+        EXPECT_EQ(parallel.m_cornersResponse, serial.m_cornersResponse) << threads << " threads";
+        EXPECT_EQ(parallel.m_maxResponseLocation, serial.m_maxResponseLocation) << threads << " threads";
+    }
+}
+
+// Every inner corner, the few outline corners above the threshold are left
+// to the grid recovery
+TEST(SaddleDetector, FindsEveryCorner)
+{
+    for (float angle : {0.0F, 15.0F, -30.0F, 45.0F}) {
+        SCOPED_TRACE(angle);
+        SyntheticBoardParameters boardParams;
+        boardParams.angle = angle;
+        boardParams.blurSigma = 1.0F;
+        boardParams.noiseSigma = 4.0F;
+        const SyntheticBoard board = makeSyntheticBoard(boardParams);
+        SaddleChessCornersDetector detector(boardParameters());
+        detector.detect(board.image);
+        const CornerMatch match = matchCorners(board.corners, detector.m_cornersLocation, kMatchDistance);
+        EXPECT_EQ(match.recall, 1.0F);
+        EXPECT_LT(detector.m_cornersLocation.size(), 2 * board.corners.size());
+    }
+}
+
+TEST(SaddleDetector, KeepsStrongestCorners)
+{
+    const SyntheticBoard board = makeSyntheticBoard(SyntheticBoardParameters{});
+    SaddleParameters params = boardParameters();
+    SaddleChessCornersDetector all(params);
+    all.detect(board.image);
+    params.maxCorners = 10;
+    SaddleChessCornersDetector strongest(params);
+    strongest.detect(board.image);
+    ASSERT_EQ(strongest.m_cornersLocation.size(), 10U);
+    std::vector<float> responses = all.m_cornersResponse;
+    std::sort(responses.begin(), responses.end());
+    for (float response : strongest.m_cornersResponse) {
+        EXPECT_GE(response, responses[responses.size() - 10]);
+    }
+}
@@ -0,0 +1,149 @@
+/// @file syntheticboardtests.cpp
+/// @brief Ground truth of the synthetic chessboard generator
+///
+/// @copyright Copyright (C) 2024, Jaguar Land Rover
+///  All rights reserved.
+///  CONFIDENTIAL INFORMATION - DO NOT DISTRIBUTE
+/// @date 10-2026
+
+#include <cmath>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include "syntheticboard.hpp"
+
+namespace {
+
+/// @brief Mean grey level of an image.
+double meanLevel(const Image<uint8_t>& image)
+{
+    double sum = 0.0;
+    for (int y = 0; y < image.height(); ++y) {
+        for (int x = 0; x < image.width(); ++x) {
+            sum += image(y, x);
+        }
+    }
+    return sum / (static_cast<double>(image.width()) * image.height());
+}
+
+} // namespace
+
+TEST(SyntheticBoard, CornersInRowMajorOrder)
+{
+    SyntheticBoardParameters params;
+    params.squareSize = 50.0F;
+    const SyntheticBoard board = makeSyntheticBoard(params);
+    ASSERT_EQ(board.corners.size(), static_cast<std::size_t>(params.cols * params.rows));
+    EXPECT_FLOAT_EQ(board.squareSize, 50.0F);
+    // Corners of a row are one square apart along x, rows one square along y
+    const float centerX = 0.5F * static_cast<float>(params.width - 1);
+    const float centerY = 0.5F * static_cast<float>(params.height - 1);
+    EXPECT_FLOAT_EQ(board.corners.front().first, centerX - 4.0F * 50.0F);
+    EXPECT_FLOAT_EQ(board.corners.front().second, centerY - 2.5F * 50.0F);
+    EXPECT_FLOAT_EQ(board.corners[1].first - board.corners[0].first, 50.0F);
+    EXPECT_FLOAT_EQ(board.corners[params.cols].second - board.corners[0].second, 50.0F);
+}
+
+TEST(SyntheticBoard, SquareColours)
+{
+    SyntheticBoardParameters params;
+    params.dark = 20;
+    params.light = 230;
+    const SyntheticBoard board = makeSyntheticBoard(params);
+    const Image<uint8_t>& image = board.image;
+    ASSERT_EQ(image.width(), params.width);
+    ASSERT_EQ(image.height(), params.height);
+    // Background, then the squares around the first corner, the top-left one
+    // being dark
+    EXPECT_EQ(image(0, 0), 230);
+    const int x = static_cast<int>(std::lround(board.corners.front().first));
+    const int y = static_cast<int>(std::lround(board.corners.front().second));
+    const int offset = static_cast<int>(board.squareSize / 2.0F);
+    EXPECT_EQ(image(y - offset, x - offset), 20);
+    EXPECT_EQ(image(y - offset, x + offset), 230);
+    EXPECT_EQ(image(y + offset, x - offset), 230);
+    EXPECT_EQ(image(y + offset, x + offset), 20);
+}
+
+TEST(SyntheticBoard, RotatedBoardFitsInImage)
+{
+    for (float angle : {-75.0F, -30.0F, 0.0F, 20.0F, 45.0F, 90.0F}) {
+        SyntheticBoardParameters params;
+        params.angle = angle;
+        const SyntheticBoard board = makeSyntheticBoard(params);
+        for (const auto& corner : board.corners) {
+            // At least the margin of one square to the image border
+            EXPECT_GE(corner.first, board.squareSize) << "angle " << angle;
+            EXPECT_LE(corner.first, static_cast<float>(params.width) - board.squareSize) << "angle " << angle;
+            EXPECT_GE(corner.second, board.squareSize) << "angle " << angle;
+            EXPECT_LE(corner.second, static_cast<float>(params.height) - board.squareSize) << "angle " << angle;
+        }
+    }
+}
+
+TEST(SyntheticBoard, RotationMovesCornersAroundCentre)
+{
+    SyntheticBoardParameters params;
+    params.squareSize = 40.0F;
+    const SyntheticBoard straight = makeSyntheticBoard(params);
+    params.angle = 90.0F;
+    const SyntheticBoard rotated = makeSyntheticBoard(params);
+    const float centerX = 0.5F * static_cast<float>(params.width - 1);
+    const float centerY = 0.5F * static_cast<float>(params.height - 1);
+    // Clockwise as seen, i.e. (dx, dy) -> (-dy, dx) with the y axis down
+    for (std::size_t i = 0; i < straight.corners.size(); ++i) {
+        const float dx = straight.corners[i].first - centerX;
+        const float dy = straight.corners[i].second - centerY;
+        EXPECT_NEAR(rotated.corners[i].first, centerX - dy, 1e-3F);
+        EXPECT_NEAR(rotated.corners[i].second, centerY + dx, 1e-3F);
+    }
+}
+
+TEST(SyntheticBoard, NoiseIsReproducible)
+{
+    SyntheticBoardParameters params;
+    params.width = 320;
+    params.height = 240;
+    params.blurSigma = 1.0F;
+    params.noiseSigma = 5.0F;
+    const SyntheticBoard first = makeSyntheticBoard(params);
+    const SyntheticBoard second = makeSyntheticBoard(params);
+    params.seed = 2;
+    const SyntheticBoard reseeded = makeSyntheticBoard(params);
+    int differences = 0;
+    int reseededDifferences = 0;
+    for (int y = 0; y < params.height; ++y) {
+        for (int x = 0; x < params.width; ++x) {
+            differences += first.image(y, x) != second.image(y, x) ? 1 : 0;
+            reseededDifferences += first.image(y, x) != reseeded.image(y, x) ? 1 : 0;
+        }
+    }
+    EXPECT_EQ(differences, 0);
+    EXPECT_GT(reseededDifferences, params.width * params.height / 2);
+}
+
+TEST(SyntheticBoard, BlurKeepsMeanLevel)
+{
+    SyntheticBoardParameters params;
+    params.width = 320;
+    params.height = 240;
+    const SyntheticBoard sharp = makeSyntheticBoard(params);
+    params.blurSigma = 2.0F;
+    const SyntheticBoard blurred = makeSyntheticBoard(params);
+    EXPECT_NEAR(meanLevel(blurred.image), meanLevel(sharp.image), 0.5);
+    // An edge pixel gets a level between the two colours
+    const int x = static_cast<int>(std::lround(blurred.corners.front().first));
+    const int y = static_cast<int>(std::lround(blurred.corners.front().second + blurred.squareSize / 2.0F));
+    EXPECT_GT(blurred.image(y, x), 20);
+    EXPECT_LT(blurred.image(y, x), 235);
+}
+
+TEST(SyntheticBoard, MatchCorners)
+{
+    const std::vector<std::pair<float, float>> truth{{10.0F, 10.0F}, {20.0F, 10.0F}, {30.0F, 10.0F}};
+    const std::vector<std::pair<int, int>> detections{{11, 10}, {20, 12}, {100, 100}};
+    const CornerMatch match = matchCorners(truth, detections, 3.0F);
+    EXPECT_EQ(match.matched, 2);
+    EXPECT_FLOAT_EQ(match.recall, 2.0F / 3.0F);
+    EXPECT_FLOAT_EQ(match.meanError, 1.5F);
+    EXPECT_FLOAT_EQ(match.maxError, 2.0F);
+}